@@ -29,6 +29,7 @@
 
 #include <gio/gio.h>
 #include <libecal/libecal.h>
+#include <string.h>
 
 typedef struct
 {
@@ -38,6 +39,36 @@ typedef struct
   gboolean             complete;
 } IdleData;
 
+#define SNAPSHOT_N_BUCKETS 256
+
+/*
+ * Immutable once published. Event ids are the GRefStrings owned by the
+ * events themselves, and series ids are GRefStrings too.
+ *
+ * Both tables are split in buckets by the hash of their keys. Buckets,
+ * and the series sets inside them, are shared between consecutive
+ * snapshots until a writer modifies them, so copying a snapshot only
+ * copies the bucket pointers, and a writer only copies the buckets it
+ * touches. Buckets are NULL until something is added to them.
+ */
+typedef struct
+{
+  GHashTable         *events[SNAPSHOT_N_BUCKETS]; /* GRefString* event id -> GcalEvent* */
+  GHashTable         *series[SNAPSHOT_N_BUCKETS]; /* GRefString* series id -> GHashTable* (set of GRefString* event ids) */
+  guint               n_events;
+
+  /* Events must only be finalized on the main thread */
+  GMainContext       *main_context;
+} EventsSnapshot;
+
+typedef struct
+{
+  GcalCalendarMonitor *monitor;
+  EventsSnapshot      *snapshot;         /* NULL until the first change */
+  GHashTable          *writable_buckets; /* set of GHashTable* buckets created by this writer */
+  GHashTable          *writable_series;  /* set of GHashTable* series sets created by this writer */
+} SnapshotWriter;
+
 typedef enum
 {
   INVALID_EVENT,
@@ -78,10 +109,22 @@ struct _GcalCalendarMonitor
    */
   struct {
     GRWLock           lock;
-    GHashTable       *events; /* gchar* -> GcalEvent* */
     GcalRange        *range;
     gchar            *filter;
   } shared;
+
+  /*
+   * The events table is published as an immutable snapshot, which
+   * is only ever replaced by the main thread. Any thread can acquire
+   * it without locking, see acquire_snapshot().
+   */
+  struct {
+    EventsSnapshot   *current;
+    gint              n_acquiring;
+
+    /* Only accessed on the main thread */
+    GPtrArray        *retired;
+  } snapshot;
 };
 
 static gboolean      add_events_to_timeline_in_idle_cb           (gpointer           user_data);
@@ -205,6 +248,444 @@ maybe_init_event_arrays (GcalCalendarMonitor *self)
     self->monitor_thread.events_to_add = g_ptr_array_new_with_free_func (g_object_unref);
 }
 
+/*
+ * The series id of an event is the id of its main component, i.e. the
+ * event id without the recurrence id. All instances of a recurring event
+ * share the same series id.
+ */
+static gchar*
+get_series_id (GcalCalendarMonitor *self,
+               GcalEvent           *event)
+{
+  ECalComponent *component = gcal_event_get_component (event);
+
+  return g_strdup_printf ("%s:%s",
+                          gcal_calendar_get_id (self->calendar),
+                          e_cal_component_get_uid (component));
+}
+
+static inline guint
+get_bucket (const gchar *key)
+{
+  return g_str_hash (key) % SNAPSHOT_N_BUCKETS;
+}
+
+static GHashTable*
+events_bucket_new (void)
+{
+  return g_hash_table_new_full (g_str_hash,
+                                g_str_equal,
+                                (GDestroyNotify) g_ref_string_release,
+                                g_object_unref);
+}
+
+static GHashTable*
+series_bucket_new (void)
+{
+  return g_hash_table_new_full (g_str_hash,
+                                g_str_equal,
+                                (GDestroyNotify) g_ref_string_release,
+                                (GDestroyNotify) g_hash_table_unref);
+}
+
+static EventsSnapshot*
+events_snapshot_new (GMainContext *main_context)
+{
+  EventsSnapshot *snapshot = g_atomic_rc_box_new0 (EventsSnapshot);
+
+  snapshot->main_context = g_main_context_ref (main_context);
+
+  return snapshot;
+}
+
+static void
+events_snapshot_clear (gpointer data)
+{
+  EventsSnapshot *snapshot = data;
+
+  for (guint i = 0; i < SNAPSHOT_N_BUCKETS; i++)
+    {
+      g_clear_pointer (&snapshot->series[i], g_hash_table_unref);
+      g_clear_pointer (&snapshot->events[i], g_hash_table_unref);
+    }
+
+  g_clear_pointer (&snapshot->main_context, g_main_context_unref);
+}
+
+static EventsSnapshot*
+events_snapshot_ref (EventsSnapshot *snapshot)
+{
+  return g_atomic_rc_box_acquire (snapshot);
+}
+
+static gboolean
+release_snapshot_in_idle_cb (gpointer user_data)
+{
+  g_atomic_rc_box_release_full (user_data, events_snapshot_clear);
+
+  return G_SOURCE_REMOVE;
+}
+
+/*
+ * Readers on the monitor thread may hold the last reference of a retired
+ * snapshot, and releasing it could finalize events. Those references are
+ * released on the main context instead.
+ */
+static void
+events_snapshot_unref (EventsSnapshot *snapshot)
+{
+  if (GCAL_IS_MAIN_THREAD ())
+    {
+      g_atomic_rc_box_release_full (snapshot, events_snapshot_clear);
+      return;
+    }
+
+  g_main_context_invoke_full (snapshot->main_context,
+                              G_PRIORITY_DEFAULT_IDLE,
+                              release_snapshot_in_idle_cb,
+                              snapshot,
+                              NULL);
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (EventsSnapshot, events_snapshot_unref)
+
+static GcalEvent*
+events_snapshot_lookup_event (EventsSnapshot *snapshot,
+                              const gchar    *event_id)
+{
+  GHashTable *bucket = snapshot->events[get_bucket (event_id)];
+
+  return bucket ? g_hash_table_lookup (bucket, event_id) : NULL;
+}
+
+static GHashTable*
+events_snapshot_lookup_series (EventsSnapshot *snapshot,
+                               const gchar    *series_id)
+{
+  GHashTable *bucket = snapshot->series[get_bucket (series_id)];
+
+  return bucket ? g_hash_table_lookup (bucket, series_id) : NULL;
+}
+
+/*
+ * Retrieves a reference to the current events snapshot. This never
+ * blocks, and can be called from any thread.
+ *
+ * While a reader is between loading the pointer and acquiring its own
+ * reference, it is counted in n_acquiring, and publish_snapshot() will
+ * not release retired snapshots.
+ */
+static EventsSnapshot*
+acquire_snapshot (GcalCalendarMonitor *self)
+{
+  EventsSnapshot *snapshot;
+
+  g_atomic_int_inc (&self->snapshot.n_acquiring);
+  snapshot = events_snapshot_ref (g_atomic_pointer_get (&self->snapshot.current));
+  (void) g_atomic_int_dec_and_test (&self->snapshot.n_acquiring);
+
+  return snapshot;
+}
+
+#if GCAL_ENABLE_TRACE
+static void
+report_snapshot_memory (EventsSnapshot *snapshot)
+{
+  g_autoptr (GHashTable) shared_strings = NULL;
+  GHashTableIter iter;
+  GcalEvent *event;
+  gsize events_size;
+  gsize shared_size;
+  guint n_events;
+
+  shared_strings = g_hash_table_new (NULL, NULL);
+  n_events = snapshot->n_events;
+  events_size = 0;
+  shared_size = 0;
+
+  for (guint bucket = 0; bucket < SNAPSHOT_N_BUCKETS; bucket++)
+    {
+      if (!snapshot->events[bucket])
+        continue;
+
+      g_hash_table_iter_init (&iter, snapshot->events[bucket]);
+      while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &event))
+        {
+          const gchar *strings[] = {
+            gcal_event_get_summary (event),
+            gcal_event_get_location (event),
+          };
+
+          events_size += gcal_event_get_memory_size (event);
+
+          /* Interned strings are shared, count each of them once */
+          for (gsize i = 0; i < G_N_ELEMENTS (strings); i++)
+            {
+              if (strings[i] && g_hash_table_add (shared_strings, (gpointer) strings[i]))
+                shared_size += strlen (strings[i]) + 1;
+            }
+        }
+    }
+
+  GCAL_TRACE_MSG ("Published snapshot with %u events, %" G_GSIZE_FORMAT " bytes per event "
+                  "(%" G_GSIZE_FORMAT " bytes of events, %" G_GSIZE_FORMAT " bytes of %u shared strings)",
+                  n_events,
+                  n_events > 0 ? (events_size + shared_size) / n_events : 0,
+                  events_size,
+                  shared_size,
+                  g_hash_table_size (shared_strings));
+}
+#endif
+
+static void
+publish_snapshot (GcalCalendarMonitor *self,
+                  EventsSnapshot      *snapshot)
+{
+  EventsSnapshot *old_snapshot;
+
+  g_assert (GCAL_IS_MAIN_THREAD ());
+
+  old_snapshot = g_atomic_pointer_exchange (&self->snapshot.current, snapshot);
+  g_ptr_array_add (self->snapshot.retired, old_snapshot);
+
+  /*
+   * Readers that start acquiring after the exchange see the new snapshot,
+   * so if no reader is acquiring right now, the retired snapshots are only
+   * reachable through references their readers already own.
+   */
+  if (g_atomic_int_get (&self->snapshot.n_acquiring) == 0)
+    g_ptr_array_set_size (self->snapshot.retired, 0);
+
+#if GCAL_ENABLE_TRACE
+  report_snapshot_memory (snapshot);
+#endif
+}
+
+static void
+snapshot_writer_init (SnapshotWriter      *writer,
+                      GcalCalendarMonitor *self)
+{
+  g_assert (GCAL_IS_MAIN_THREAD ());
+
+  writer->monitor = self;
+  writer->snapshot = NULL;
+  writer->writable_buckets = NULL;
+  writer->writable_series = NULL;
+}
+
+/*
+ * The snapshot the writer sees: the writer's own copy once it changed
+ * anything, or the current snapshot otherwise.
+ */
+static EventsSnapshot*
+snapshot_writer_peek (SnapshotWriter *writer)
+{
+  return writer->snapshot ? writer->snapshot : writer->monitor->snapshot.current;
+}
+
+/*
+ * Copies the current snapshot. Only bucket pointers are copied, so this
+ * doesn't depend on the number of events.
+ */
+static EventsSnapshot*
+snapshot_writer_ensure_copy (SnapshotWriter *writer)
+{
+  EventsSnapshot *current;
+
+  if (writer->snapshot)
+    return writer->snapshot;
+
+  current = writer->monitor->snapshot.current;
+  writer->snapshot = events_snapshot_new (writer->monitor->main_context);
+  writer->snapshot->n_events = current->n_events;
+  writer->writable_buckets = g_hash_table_new (NULL, NULL);
+  writer->writable_series = g_hash_table_new (NULL, NULL);
+
+  for (guint i = 0; i < SNAPSHOT_N_BUCKETS; i++)
+    {
+      if (current->events[i])
+        writer->snapshot->events[i] = g_hash_table_ref (current->events[i]);
+
+      if (current->series[i])
+        writer->snapshot->series[i] = g_hash_table_ref (current->series[i]);
+    }
+
+  return writer->snapshot;
+}
+
+/*
+ * Retrieves the bucket at @slot in the writer's copy, copying it first
+ * if it is still shared with the current snapshot.
+ */
+static GHashTable*
+snapshot_writer_get_bucket (SnapshotWriter    *writer,
+                            GHashTable       **slot,
+                            GHashTable      *(*new_func) (void),
+                            GBoxedCopyFunc     copy_func)
+{
+  GHashTable *bucket;
+
+  if (*slot && g_hash_table_contains (writer->writable_buckets, *slot))
+    return *slot;
+
+  bucket = new_func ();
+
+  if (*slot)
+    {
+      GHashTableIter iter;
+      gpointer key;
+      gpointer value;
+
+      g_hash_table_iter_init (&iter, *slot);
+      while (g_hash_table_iter_next (&iter, &key, &value))
+        g_hash_table_insert (bucket, g_ref_string_acquire (key), copy_func (value));
+
+      g_hash_table_unref (*slot);
+    }
+
+  *slot = bucket;
+  g_hash_table_add (writer->writable_buckets, bucket);
+
+  return bucket;
+}
+
+static GHashTable*
+snapshot_writer_get_events_bucket (SnapshotWriter *writer,
+                                   const gchar    *event_id)
+{
+  EventsSnapshot *snapshot = snapshot_writer_ensure_copy (writer);
+
+  return snapshot_writer_get_bucket (writer,
+                                     &snapshot->events[get_bucket (event_id)],
+                                     events_bucket_new,
+                                     (GBoxedCopyFunc) g_object_ref);
+}
+
+static GHashTable*
+snapshot_writer_get_series_bucket (SnapshotWriter *writer,
+                                   const gchar    *series_id)
+{
+  EventsSnapshot *snapshot = snapshot_writer_ensure_copy (writer);
+
+  return snapshot_writer_get_bucket (writer,
+                                     &snapshot->series[get_bucket (series_id)],
+                                     series_bucket_new,
+                                     (GBoxedCopyFunc) g_hash_table_ref);
+}
+
+/*
+ * Retrieves the set of event ids of @series_id in the writer's copy,
+ * copying it first if it is still shared with the current snapshot.
+ */
+static GHashTable*
+snapshot_writer_get_series (SnapshotWriter *writer,
+                            const gchar    *series_id,
+                            gboolean        create)
+{
+  GHashTable *new_instances;
+  GHashTable *instances;
+
+  instances = events_snapshot_lookup_series (snapshot_writer_ensure_copy (writer), series_id);
+
+  if (instances && g_hash_table_contains (writer->writable_series, instances))
+    return instances;
+
+  if (!instances && !create)
+    return NULL;
+
+  new_instances = g_hash_table_new_full (g_str_hash, g_str_equal, (GDestroyNotify) g_ref_string_release, NULL);
+
+  if (instances)
+    {
+      GHashTableIter iter;
+      gpointer event_id;
+
+      g_hash_table_iter_init (&iter, instances);
+      while (g_hash_table_iter_next (&iter, &event_id, NULL))
+        g_hash_table_add (new_instances, g_ref_string_acquire (event_id));
+    }
+
+  g_hash_table_insert (snapshot_writer_get_series_bucket (writer, series_id),
+                       g_ref_string_new (series_id),
+                       new_instances);
+  g_hash_table_add (writer->writable_series, new_instances);
+
+  return new_instances;
+}
+
+static void
+snapshot_writer_add_event (SnapshotWriter *writer,
+                           GcalEvent      *event)
+{
+  g_autofree gchar *series_id = NULL;
+  GHashTable *instances;
+  GHashTable *bucket;
+  GRefString *event_id;
+
+  series_id = get_series_id (writer->monitor, event);
+  event_id = g_ref_string_acquire (gcal_event_get_uid_ref (event));
+  bucket = snapshot_writer_get_events_bucket (writer, event_id);
+
+  if (g_hash_table_insert (bucket, g_ref_string_acquire (event_id), g_object_ref (event)))
+    writer->snapshot->n_events++;
+
+  instances = snapshot_writer_get_series (writer, series_id, TRUE);
+  g_hash_table_add (instances, event_id);
+}
+
+/*
+ * Returns: (transfer full)(nullable): the removed event
+ */
+static GcalEvent*
+snapshot_writer_remove_event (SnapshotWriter *writer,
+                              const gchar    *event_id)
+{
+  g_autofree gchar *series_id = NULL;
+  GHashTable *instances;
+  GHashTable *bucket;
+  GcalEvent *event;
+  gpointer key;
+
+  if (!events_snapshot_lookup_event (snapshot_writer_peek (writer), event_id))
+    return NULL;
+
+  bucket = snapshot_writer_get_events_bucket (writer, event_id);
+
+  g_hash_table_steal_extended (bucket, event_id, &key, (gpointer *) &event);
+  writer->snapshot->n_events--;
+
+  series_id = get_series_id (writer->monitor, event);
+  instances = snapshot_writer_get_series (writer, series_id, FALSE);
+
+  if (instances)
+    {
+      g_hash_table_remove (instances, event_id);
+
+      if (g_hash_table_size (instances) == 0)
+        {
+          g_hash_table_remove (writer->writable_series, instances);
+          g_hash_table_remove (snapshot_writer_get_series_bucket (writer, series_id), series_id);
+        }
+    }
+
+  g_ref_string_release (key);
+
+  return event;
+}
+
+/*
+ * Publishes the writer's copy, if anything changed.
+ */
+static void
+snapshot_writer_finish (SnapshotWriter *writer)
+{
+  g_clear_pointer (&writer->writable_buckets, g_hash_table_destroy);
+  g_clear_pointer (&writer->writable_series, g_hash_table_destroy);
+
+  if (writer->snapshot)
+    publish_snapshot (writer->monitor, g_steal_pointer (&writer->snapshot));
+}
+
 static GcalRange*
 get_monitor_ranges (GcalCalendarMonitor  *self)
 {
@@ -334,8 +815,7 @@ client_instance_generated_cb (ICalComponent  *icomponent,
   if (!ecomponent)
     return TRUE;
 
-  event = gcal_event_new (self->calendar, ecomponent, &local_error);
-  g_clear_object (&ecomponent);
+  event = gcal_event_new_take (self->calendar, ecomponent, &local_error);
   if (local_error)
     {
       g_propagate_error (error, local_error);
@@ -399,8 +879,7 @@ on_client_view_objects_added_cb (ECalClientView      *view,
       if (!ecomponent)
         continue;
 
-      event = gcal_event_new (self->calendar, ecomponent, &error);
-      g_clear_object (&ecomponent);
+      event = gcal_event_new_take (self->calendar, ecomponent, &error);
 
       if (error)
         {
@@ -494,6 +973,7 @@ on_client_view_objects_modified_cb (ECalClientView      *view,
   g_autoptr (GPtrArray) components_to_expand = NULL;
   g_autoptr (GPtrArray) event_ids_to_remove = NULL;
   g_autoptr (GPtrArray) events_to_update = NULL;
+  g_autoptr (EventsSnapshot) snapshot = NULL;
   g_autoptr (GcalRange) range = NULL;
   const GSList *l;
 
@@ -507,20 +987,20 @@ on_client_view_objects_modified_cb (ECalClientView      *view,
       return;
     }
 
-  G_RW_LOCK_READER_AUTO_LOCK (&self->shared.lock, reader_locker);
+  snapshot = acquire_snapshot (self);
   components_to_expand = g_ptr_array_new ();
   events_to_remove = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
   events_to_update = g_ptr_array_new_with_free_func (g_object_unref);
-  range = gcal_range_copy (self->shared.range);
+  range = get_monitor_ranges (self);
 
   for (l = objects; l; l = l->next)
     {
       g_autoptr (GcalEvent) event = NULL;
       g_autoptr (GError) error = NULL;
+      g_autoptr (ECalComponent) ecomponent = NULL;
       g_autofree gchar *event_id = NULL;
       ECalComponentId *component_id;
       ICalComponent *icomponent;
-      ECalComponent *ecomponent;
       gboolean recurrence_main;
 
       icomponent = l->data;
@@ -550,17 +1030,21 @@ on_client_view_objects_modified_cb (ECalClientView      *view,
 
       if (!e_cal_component_id_get_rid (component_id))
         {
-          GHashTableIter iter;
-          const gchar *aux;
+          GHashTable *instances;
 
-          g_hash_table_iter_init (&iter, self->shared.events);
-          while (g_hash_table_iter_next (&iter, (gpointer*) &aux, NULL))
-            {
-              if (!g_str_has_prefix (aux, event_id))
-                continue;
+          instances = events_snapshot_lookup_series (snapshot, event_id);
 
-              if (recurrence_main || !g_str_equal (aux, event_id))
-                g_hash_table_add (events_to_remove, g_strdup (aux));
+          if (instances)
+            {
+              GHashTableIter iter;
+              const gchar *aux;
+
+              g_hash_table_iter_init (&iter, instances);
+              while (g_hash_table_iter_next (&iter, (gpointer*) &aux, NULL))
+                {
+                  if (recurrence_main || !g_str_equal (aux, event_id))
+                    g_hash_table_add (events_to_remove, g_strdup (aux));
+                }
             }
         }
       g_clear_pointer (&component_id, e_cal_component_id_free);
@@ -575,8 +1059,7 @@ on_client_view_objects_modified_cb (ECalClientView      *view,
           continue;
         }
 
-      event = gcal_event_new (self->calendar, ecomponent, &error);
-      g_clear_object (&ecomponent);
+      event = gcal_event_new_take (self->calendar, g_steal_pointer (&ecomponent), &error);
 
       if (error)
         {
@@ -660,7 +1143,7 @@ on_client_view_objects_modified_cb (ECalClientView      *view,
           if (g_cancellable_is_cancelled (self->cancellable))
             return;
 
-          old_event = g_hash_table_lookup (self->shared.events, gcal_event_get_uid (event));
+          old_event = events_snapshot_lookup_event (snapshot, gcal_event_get_uid (event));
           if (old_event)
             {
               g_hash_table_remove (events_to_remove, gcal_event_get_uid (event));
@@ -692,6 +1175,7 @@ on_client_view_objects_removed_cb (ECalClientView      *view,
                                    const GSList        *objects,
                                    GcalCalendarMonitor *self)
 {
+  g_autoptr (EventsSnapshot) snapshot = NULL;
   g_autoptr (GPtrArray) event_ids = NULL;
   const GSList *l;
 
@@ -700,6 +1184,7 @@ on_client_view_objects_removed_cb (ECalClientView      *view,
   g_assert (GCAL_IS_THREAD (self->thread));
 
   event_ids = g_ptr_array_new_with_free_func (g_free);
+  snapshot = acquire_snapshot (self);
 
   for (l = objects; l; l = l->next)
     {
@@ -720,8 +1205,7 @@ on_client_view_objects_removed_cb (ECalClientView      *view,
         }
       else
         {
-          GHashTableIter iter;
-          const gchar *aux;
+          GHashTable *instances;
 
           event_id = g_strdup_printf ("%s:%s",
                                       gcal_calendar_get_id (self->calendar),
@@ -731,13 +1215,19 @@ on_client_view_objects_removed_cb (ECalClientView      *view,
            * If this is the main component, remove the expanded recurrency instances
            * as well.
            */
-          G_RW_LOCK_READER_AUTO_LOCK (&self->shared.lock, reader_locker);
+          instances = events_snapshot_lookup_series (snapshot, event_id);
 
-          g_hash_table_iter_init (&iter, self->shared.events);
-          while (g_hash_table_iter_next (&iter, (gpointer*) &aux, NULL))
+          if (instances)
             {
-              if (!g_str_equal (aux, event_id) && g_str_has_prefix (aux, event_id))
-                g_ptr_array_add (event_ids, g_strdup (aux));
+              GHashTableIter iter;
+              const gchar *aux;
+
+              g_hash_table_iter_init (&iter, instances);
+              while (g_hash_table_iter_next (&iter, (gpointer*) &aux, NULL))
+                {
+                  if (!g_str_equal (aux, event_id))
+                    g_ptr_array_add (event_ids, g_strdup (aux));
+                }
             }
         }
 
@@ -1028,7 +1518,10 @@ remove_events_outside_range (GcalCalendarMonitor *self,
                              GcalRange           *range)
 {
   g_autoptr (GPtrArray) events_to_remove = NULL;
+  EventsSnapshot *current;
+  SnapshotWriter writer;
   GHashTableIter iter;
+  const gchar *event_id;
   GcalEvent *event;
 
   g_assert (GCAL_IS_MAIN_THREAD ());
@@ -1036,24 +1529,31 @@ remove_events_outside_range (GcalCalendarMonitor *self,
 
   GCAL_TRACE_MSG ("Removing events outside range from monitor");
 
-  G_RW_LOCK_WRITER_AUTO_LOCK (&self->shared.lock, writer_locker);
+  current = self->snapshot.current;
+  snapshot_writer_init (&writer, self);
 
-  events_to_remove = g_ptr_array_new_null_terminated (g_hash_table_size (self->shared.events),
-                                                      g_object_unref,
-                                                      TRUE);
+  events_to_remove = g_ptr_array_new_null_terminated (current->n_events, g_object_unref, TRUE);
 
-  g_hash_table_iter_init (&iter, self->shared.events);
-  while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &event))
+  /* The current snapshot is immutable, so it can be iterated while writing */
+  for (guint bucket = 0; bucket < SNAPSHOT_N_BUCKETS; bucket++)
     {
-      GcalRange *event_range = gcal_event_get_range (event);
-
-      if (gcal_range_calculate_overlap (range, event_range, NULL) != GCAL_RANGE_NO_OVERLAP)
+      if (!current->events[bucket])
         continue;
 
-      g_ptr_array_add (events_to_remove, event);
-      g_hash_table_iter_steal (&iter);
+      g_hash_table_iter_init (&iter, current->events[bucket]);
+      while (g_hash_table_iter_next (&iter, (gpointer*) &event_id, (gpointer*) &event))
+        {
+          GcalRange *event_range = gcal_event_get_range (event);
+
+          if (gcal_range_value_overlaps (gcal_range_get_value (range), gcal_range_get_value (event_range)))
+            continue;
+
+          g_ptr_array_add (events_to_remove, snapshot_writer_remove_event (&writer, event_id));
+        }
     }
 
+  snapshot_writer_finish (&writer);
+
   if (events_to_remove->len > 0)
     gcal_event_list_remove_events (self->event_list, (GcalEvent **) events_to_remove->pdata);
 }
@@ -1065,9 +1565,7 @@ remove_all_events (GcalCalendarMonitor *self)
 
   GCAL_TRACE_MSG ("Removing all events from view");
 
-  G_RW_LOCK_WRITER_AUTO_LOCK (&self->shared.lock, writer_locker);
-
-  g_hash_table_remove_all (self->shared.events);
+  publish_snapshot (self, events_snapshot_new (self->main_context));
   gcal_event_list_remove_all_events (self->event_list);
 }
 
@@ -1096,6 +1594,7 @@ add_events_to_timeline_in_idle_cb (gpointer user_data)
 {
   g_autoptr (GPtrArray) events_to_add = NULL;
   GcalCalendarMonitor *self;
+  SnapshotWriter writer;
   GPtrArray *events;
   IdleData *idle_data;
 
@@ -1110,7 +1609,7 @@ add_events_to_timeline_in_idle_cb (gpointer user_data)
 
   events_to_add = g_ptr_array_new_null_terminated (events->len, NULL, TRUE);
 
-  G_RW_LOCK_WRITER_AUTO_LOCK (&self->shared.lock, writer_locker);
+  snapshot_writer_init (&writer, self);
   for (guint i = 0; i < events->len; i++)
     {
       GcalEvent *event;
@@ -1119,12 +1618,13 @@ add_events_to_timeline_in_idle_cb (gpointer user_data)
       event = g_ptr_array_index (events, i);
       uid = gcal_event_get_uid (event);
 
-      if (!g_hash_table_contains (self->shared.events, uid))
+      if (!events_snapshot_lookup_event (snapshot_writer_peek (&writer), uid))
         {
-          g_hash_table_insert (self->shared.events, g_strdup (uid), g_object_ref (event));
+          snapshot_writer_add_event (&writer, event);
           g_ptr_array_add (events_to_add, event);
         }
     }
+  snapshot_writer_finish (&writer);
 
   if (events_to_add->len > 0)
     gcal_event_list_add_events (self->event_list, (GcalEvent **) events_to_add->pdata);
@@ -1139,6 +1639,7 @@ update_events_in_idle_cb (gpointer user_data)
   g_autoptr (GPtrArray) new_events = NULL;
   g_autoptr (GPtrArray) events = NULL;
   GcalCalendarMonitor *self;
+  SnapshotWriter writer;
   IdleData *idle_data;
 
   GCAL_ENTRY;
@@ -1153,27 +1654,23 @@ update_events_in_idle_cb (gpointer user_data)
   old_events = g_ptr_array_new_null_terminated (events->len, g_object_unref, TRUE);
   new_events = g_ptr_array_new_null_terminated (events->len, NULL, TRUE);
 
-  G_RW_LOCK_WRITER_AUTO_LOCK (&self->shared.lock, writer_locker);
+  snapshot_writer_init (&writer, self);
   for (guint i = 0; i < events->len; i++)
     {
       g_autoptr (GcalEvent) old_event = NULL;
-      g_autofree gchar *old_event_id = NULL;
       GcalEvent *event;
-      const gchar *event_id;
 
       event = g_ptr_array_index (events, i);
-      event_id = gcal_event_get_uid (event);
+      old_event = snapshot_writer_remove_event (&writer, gcal_event_get_uid (event));
 
-      if (g_hash_table_steal_extended (self->shared.events,
-                                       event_id,
-                                       (gpointer*) &old_event_id,
-                                       (gpointer*) &old_event))
+      if (old_event)
         {
-          g_hash_table_insert (self->shared.events, g_strdup (event_id), g_object_ref (event));
+          snapshot_writer_add_event (&writer, event);
           g_ptr_array_add (old_events, g_steal_pointer (&old_event));
           g_ptr_array_add (new_events, event);
         }
     }
+  snapshot_writer_finish (&writer);
 
   g_assert (old_events->len == new_events->len);
 
@@ -1192,6 +1689,7 @@ remove_events_from_timeline_in_idle_cb (gpointer user_data)
   g_autoptr (GPtrArray) events_to_remove = NULL;
   g_autoptr (GPtrArray) event_ids = NULL;
   GcalCalendarMonitor *self;
+  SnapshotWriter writer;
   IdleData *idle_data;
 
   GCAL_ENTRY;
@@ -1205,24 +1703,21 @@ remove_events_from_timeline_in_idle_cb (gpointer user_data)
 
   events_to_remove = g_ptr_array_new_null_terminated (event_ids->len, g_object_unref, TRUE);
 
-  G_RW_LOCK_WRITER_AUTO_LOCK (&self->shared.lock, writer_locker);
+  snapshot_writer_init (&writer, self);
 
   for (guint i = 0; i < event_ids->len; i++)
     {
-      const gchar *event_id;
       GcalEvent *event;
 
-      event_id = g_ptr_array_index (event_ids, i);
-      event = g_hash_table_lookup (self->shared.events, event_id);
+      /* Keep the event alive until the listener process it */
+      event = snapshot_writer_remove_event (&writer, g_ptr_array_index (event_ids, i));
 
       if (event)
-        {
-          /* Keep the event alive until the listener process it*/
-          g_ptr_array_add (events_to_remove, g_object_ref (event));
-          g_hash_table_remove (self->shared.events, event_id);
-        }
+        g_ptr_array_add (events_to_remove, event);
     }
 
+  snapshot_writer_finish (&writer);
+
   if (events_to_remove->len > 0)
     gcal_event_list_remove_events (self->event_list, (GcalEvent **) events_to_remove->pdata);
 
@@ -1301,7 +1796,8 @@ gcal_calendar_monitor_finalize (GObject *object)
   g_clear_pointer (&self->thread_context, g_main_context_unref);
   g_clear_pointer (&self->main_context, g_main_context_unref);
   g_clear_pointer (&self->messages, g_async_queue_unref);
-  g_clear_pointer (&self->shared.events, g_hash_table_destroy);
+  g_clear_pointer (&self->snapshot.retired, g_ptr_array_unref);
+  g_clear_pointer (&self->snapshot.current, events_snapshot_unref);
   g_clear_pointer (&self->shared.filter, g_free);
   g_clear_pointer (&self->shared.range, gcal_range_unref);
 
@@ -1380,9 +1876,10 @@ gcal_calendar_monitor_class_init (GcalCalendarMonitorClass *klass)
 static void
 gcal_calendar_monitor_init (GcalCalendarMonitor *self)
 {
-  self->shared.events = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
-  self->thread_context = g_main_context_new ();
   self->main_context = g_main_context_ref_thread_default ();
+  self->snapshot.current = events_snapshot_new (self->main_context);
+  self->snapshot.retired = g_ptr_array_new_with_free_func ((GDestroyNotify) events_snapshot_unref);
+  self->thread_context = g_main_context_new ();
   self->messages = g_async_queue_new ();
   self->complete = FALSE;
   self->event_list = gcal_event_list_new ();
@@ -1463,14 +1960,14 @@ GcalEvent*
 gcal_calendar_monitor_get_cached_event (GcalCalendarMonitor *self,
                                         const gchar         *event_id)
 {
+  g_autoptr (EventsSnapshot) snapshot = NULL;
   GcalEvent *event;
 
   g_return_val_if_fail (GCAL_IS_CALENDAR_MONITOR (self), NULL);
   g_return_val_if_fail (event_id, NULL);
 
-  g_rw_lock_reader_lock (&self->shared.lock);
-  event = g_hash_table_lookup (self->shared.events, event_id);
-  g_rw_lock_reader_unlock (&self->shared.lock);
+  snapshot = acquire_snapshot (self);
+  event = events_snapshot_lookup_event (snapshot, event_id);
 
   return event ? g_object_ref (event) : NULL;
 }
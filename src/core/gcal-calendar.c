@@ -28,6 +28,7 @@
 typedef struct
 {
   GdkRGBA             color;
+  const gchar        *color_css_class;
   ESource            *source;
   ESource            *parent_source;
   ECalClient         *client;
@@ -110,6 +111,26 @@ schedule_idle_update_unlocked (GcalCalendar *self)
                                                    g_object_unref);
 }
 
+static void
+update_color_css_class (GcalCalendar *self)
+{
+  GcalCalendarPrivate *priv = gcal_calendar_get_instance_private (self);
+  gchar css_class[sizeof ("color-rrggbbaa")];
+
+#define CHANNEL(c) ((guint) (CLAMP ((c), 0.f, 1.f) * 255.f + 0.5f))
+
+  g_snprintf (css_class, sizeof (css_class),
+              "color-%02x%02x%02x%02x",
+              CHANNEL (priv->color.red),
+              CHANNEL (priv->color.green),
+              CHANNEL (priv->color.blue),
+              CHANNEL (priv->color.alpha));
+
+#undef CHANNEL
+
+  priv->color_css_class = g_intern_string (css_class);
+}
+
 static void
 update_color (GcalCalendar *self)
 {
@@ -122,6 +143,8 @@ update_color (GcalCalendar *self)
 
   if (!color || !gdk_rgba_parse (&priv->color, color))
     gdk_rgba_parse (&priv->color, "#ffffff");
+
+  update_color_css_class (self);
 }
 
 
@@ -516,6 +539,7 @@ gcal_calendar_init (GcalCalendar *self)
   GcalCalendarPrivate *priv = gcal_calendar_get_instance_private (self);
 
   gdk_rgba_parse (&priv->color, "#ffffff");
+  update_color_css_class (self);
 
   g_mutex_init (&priv->shared.mutex);
 }
@@ -615,6 +639,7 @@ gcal_calendar_set_color (GcalCalendar  *self,
     return;
 
   priv->color = *color;
+  update_color_css_class (self);
 
   color_string = gdk_rgba_to_string (color);
   selectable_extension = e_source_get_extension (priv->source, E_SOURCE_EXTENSION_CALENDAR);
@@ -625,6 +650,25 @@ gcal_calendar_set_color (GcalCalendar  *self,
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_COLOR]);
 }
 
+/**
+ * gcal_calendar_get_color_css_class:
+ * @self: a #GcalCalendar
+ *
+ * Retrieves the style class matching the color of @self. Calendars
+ * with the same color share the same style class.
+ *
+ * Returns: (transfer none): an interned string
+ */
+const gchar*
+gcal_calendar_get_color_css_class (GcalCalendar *self)
+{
+  GcalCalendarPrivate *priv = gcal_calendar_get_instance_private (self);
+
+  g_return_val_if_fail (GCAL_IS_CALENDAR (self), NULL);
+
+  return priv->color_css_class;
+}
+
 /**
  * gcal_calendar_get_id:
  * @self: a #GcalCalendar
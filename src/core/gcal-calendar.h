@@ -65,6 +65,8 @@ const GdkRGBA*       gcal_calendar_get_color                     (GcalCalendar
 void                 gcal_calendar_set_color                     (GcalCalendar       *self,
                                                                   const GdkRGBA      *color);
 
+const gchar*         gcal_calendar_get_color_css_class           (GcalCalendar       *self);
+
 const gchar*         gcal_calendar_get_id                        (GcalCalendar       *self);
 
 const gchar*         gcal_calendar_get_name                      (GcalCalendar       *self);
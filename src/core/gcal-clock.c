@@ -32,6 +32,11 @@ struct _GcalClock
 
   GDateTime          *current;
 
+  /* Derived from @current, and updated with it */
+  gint64              today;
+  guint               minute_of_day;
+  GDateTime          *week_start;
+
   GDBusProxy         *proxy;
   GCancellable       *cancellable;
 };
@@ -54,6 +59,19 @@ static guint signals[NUM_SIGNALS] = { 0, };
  * Auxiliary methods
  */
 
+static void
+set_current_date (GcalClock *self,
+                  GDateTime *now)
+{
+  gcal_clear_date_time (&self->current);
+  gcal_clear_date_time (&self->week_start);
+
+  self->current = g_date_time_ref (now);
+  self->today = gcal_date_time_get_julian_day (now);
+  self->minute_of_day = g_date_time_get_hour (now) * 60 + g_date_time_get_minute (now);
+  self->week_start = gcal_date_time_get_start_of_week (now);
+}
+
 static void
 update_current_date (GcalClock *self)
 {
@@ -71,6 +89,9 @@ update_current_date (GcalClock *self)
   hour_changed = day_changed || g_date_time_get_hour (now) != g_date_time_get_hour (self->current);
   minute_changed = hour_changed || g_date_time_get_minute (now) != g_date_time_get_minute (self->current);
 
+  /* Update before emitting, so handlers can rely on the getters */
+  set_current_date (self, now);
+
   if (day_changed)
     g_signal_emit (self, signals[DAY_CHANGED], 0);
 
@@ -82,9 +103,6 @@ update_current_date (GcalClock *self)
 
   g_debug ("Updating clock time");
 
-  gcal_clear_date_time (&self->current);
-  self->current = g_date_time_ref (now);
-
   GCAL_EXIT;
 }
 
@@ -196,6 +214,7 @@ gcal_clock_finalize (GObject *object)
     }
 
   gcal_clear_date_time (&self->current);
+  gcal_clear_date_time (&self->week_start);
 
   g_clear_object (&self->cancellable);
   g_clear_object (&self->proxy);
@@ -255,7 +274,9 @@ gcal_clock_class_init (GcalClockClass *klass)
 static void
 gcal_clock_init (GcalClock *self)
 {
-  self->current = g_date_time_new_now_local ();
+  g_autoptr (GDateTime) now = g_date_time_new_now_local ();
+
+  set_current_date (self, now);
   self->cancellable = g_cancellable_new ();
 
   g_dbus_proxy_new_for_bus (G_BUS_TYPE_SYSTEM,
@@ -283,3 +304,72 @@ gcal_clock_new (void)
 {
   return g_object_new (GCAL_TYPE_CLOCK, NULL);
 }
+
+/**
+ * gcal_clock_get_now:
+ * @self: a #GcalClock
+ *
+ * Retrieves the local time of the last tick of @self. This is
+ * precise to the minute, and is meant to be shared by everything
+ * that reacts to #GcalClock::minute-changed.
+ *
+ * Returns: (transfer none): a #GDateTime
+ */
+GDateTime*
+gcal_clock_get_now (GcalClock *self)
+{
+  g_return_val_if_fail (GCAL_IS_CLOCK (self), NULL);
+
+  return self->current;
+}
+
+/**
+ * gcal_clock_get_today:
+ * @self: a #GcalClock
+ *
+ * Retrieves the Julian day of the current local date, as returned by
+ * gcal_date_time_get_julian_day(). Comparing it against the Julian day
+ * of a date is the cheapest way to know whether that date is today.
+ *
+ * Returns: the Julian day of today
+ */
+gint64
+gcal_clock_get_today (GcalClock *self)
+{
+  g_return_val_if_fail (GCAL_IS_CLOCK (self), 0);
+
+  return self->today;
+}
+
+/**
+ * gcal_clock_get_minute_of_day:
+ * @self: a #GcalClock
+ *
+ * Retrieves the number of minutes since the local midnight.
+ *
+ * Returns: the current minute of the day, from 0 to 1439
+ */
+guint
+gcal_clock_get_minute_of_day (GcalClock *self)
+{
+  g_return_val_if_fail (GCAL_IS_CLOCK (self), 0);
+
+  return self->minute_of_day;
+}
+
+/**
+ * gcal_clock_get_week_start:
+ * @self: a #GcalClock
+ *
+ * Retrieves the start of the current week, according to the first
+ * weekday of the current locale.
+ *
+ * Returns: (transfer none): a #GDateTime
+ */
+GDateTime*
+gcal_clock_get_week_start (GcalClock *self)
+{
+  g_return_val_if_fail (GCAL_IS_CLOCK (self), NULL);
+
+  return self->week_start;
+}
@@ -29,6 +29,14 @@ G_DECLARE_FINAL_TYPE (GcalClock, gcal_clock, GCAL, CLOCK, GObject)
 
 GcalClock*           gcal_clock_new                              (void);
 
+GDateTime*           gcal_clock_get_now                          (GcalClock          *self);
+
+gint64               gcal_clock_get_today                        (GcalClock          *self);
+
+guint                gcal_clock_get_minute_of_day                (GcalClock          *self);
+
+GDateTime*           gcal_clock_get_week_start                   (GcalClock          *self);
+
 G_END_DECLS
 
 #endif /* GCAL_CLOCK_H */
@@ -21,6 +21,7 @@
 #define G_LOG_DOMAIN "GcalContext"
 
 #include "gcal-context.h"
+#include "gcal-date-format-cache.h"
 #include "gcal-time-zone-monitor.h"
 
 struct _GcalContext
@@ -80,6 +81,9 @@ set_time_format_from_variant (GcalContext *self,
 
   self->time_format = time_format;
 
+  gcal_date_format_cache_clear ();
+  gcal_date_format_cache_set_time_format (time_format);
+
   enum_format = g_enum_to_string (GCAL_TYPE_TIME_FORMAT, self->time_format);
   g_debug ("Setting time format to %s", enum_format);
 
@@ -148,6 +152,8 @@ on_timezone_changed_cb (GcalTimeZoneMonitor *timezone_monitor,
                         GParamSpec          *pspec,
                         GcalContext         *self)
 {
+  gcal_date_format_cache_clear ();
+
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_TIMEZONE]);
 }
 
@@ -164,6 +170,12 @@ gcal_context_constructed (GObject *object)
   G_OBJECT_CLASS (gcal_context_parent_class)->constructed (object);
 
   self->manager = gcal_manager_new ();
+
+  g_settings_bind (self->settings,
+                   "max-concurrent-refreshes",
+                   self->manager,
+                   "max-concurrent-refreshes",
+                   G_SETTINGS_BIND_GET);
 }
 
 static void
@@ -310,6 +322,7 @@ gcal_context_init (GcalContext *self)
   self->settings = g_settings_new ("org.gnome.calendar");
   self->weather_service = gcal_weather_service_new ();
   self->time_format = GCAL_TIME_FORMAT_24H;
+  gcal_date_format_cache_set_time_format (self->time_format);
 
   self->timezone_monitor = gcal_time_zone_monitor_new ();
   g_signal_connect_object (self->timezone_monitor,
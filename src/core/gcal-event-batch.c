@@ -0,0 +1,291 @@
+/* gcal-event-batch.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GcalEventBatch"
+
+#include "gcal-event.h"
+#include "gcal-event-batch.h"
+
+/*
+ * Splits a list of events in chunks of at most GCAL_EVENT_BATCH_CHUNK_SIZE
+ * events of the same calendar, so that each chunk can be sent to the
+ * calendar backend in a single call. GcalManager walks the chunks one
+ * at a time.
+ *
+ * Each backend object is only added once. With GCAL_RECURRENCE_MOD_ALL,
+ * all instances of a series refer to the same object, so only the first
+ * instance is kept; otherwise the backend would be asked to remove the
+ * same object twice, and fail. When moving events, events that already
+ * are in the destination calendar are skipped.
+ */
+
+typedef struct
+{
+  GcalCalendar       *calendar;
+  GPtrArray          *events;
+} BatchChunk;
+
+struct _GcalEventBatch
+{
+  GQueue              chunks;
+  BatchChunk         *current_chunk;
+  guint               n_events;
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static void
+batch_chunk_free (BatchChunk *chunk)
+{
+  g_clear_object (&chunk->calendar);
+  g_clear_pointer (&chunk->events, g_ptr_array_unref);
+  g_free (chunk);
+}
+
+static gchar*
+get_event_rid (GcalEvent             *event,
+               GcalRecurrenceModType  mod)
+{
+  if (!gcal_event_has_recurrence (event) || mod == GCAL_RECURRENCE_MOD_ALL)
+    return NULL;
+
+  return e_cal_component_get_recurid_as_string (gcal_event_get_component (event));
+}
+
+static gchar*
+get_event_key (GcalEvent             *event,
+               GcalRecurrenceModType  mod)
+{
+  g_autofree gchar *rid = get_event_rid (event, mod);
+
+  return g_strdup_printf ("%s\n%s\n%s",
+                          gcal_calendar_get_id (gcal_event_get_calendar (event)),
+                          e_cal_component_get_uid (gcal_event_get_component (event)),
+                          rid ? rid : "");
+}
+
+
+/*
+ * Public API
+ */
+
+/**
+ * gcal_event_batch_new:
+ * @events: (element-type GcalEvent): the events
+ * @mod: the #GcalRecurrenceModType the events are sent with
+ * @destination: (nullable): the calendar the events are moved to
+ *
+ * Creates a new #GcalEventBatch for @events. When @destination is
+ * set, events already in @destination are left out.
+ *
+ * Returns: (transfer full): a #GcalEventBatch
+ */
+GcalEventBatch*
+gcal_event_batch_new (GPtrArray             *events,
+                      GcalRecurrenceModType  mod,
+                      GcalCalendar          *destination)
+{
+  g_autoptr (GHashTable) chunks = NULL;
+  g_autoptr (GHashTable) keys = NULL;
+  GcalEventBatch *self;
+
+  g_return_val_if_fail (events != NULL, NULL);
+  g_return_val_if_fail (!destination || GCAL_IS_CALENDAR (destination), NULL);
+
+  self = g_new0 (GcalEventBatch, 1);
+  g_queue_init (&self->chunks);
+
+  chunks = g_hash_table_new (NULL, NULL);
+  keys = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  for (guint i = 0; i < events->len; i++)
+    {
+      GcalEvent *event = g_ptr_array_index (events, i);
+      GcalCalendar *calendar = gcal_event_get_calendar (event);
+      BatchChunk *chunk;
+
+      if (calendar == destination)
+        continue;
+
+      if (!g_hash_table_add (keys, get_event_key (event, mod)))
+        continue;
+
+      chunk = g_hash_table_lookup (chunks, calendar);
+
+      if (!chunk || chunk->events->len == GCAL_EVENT_BATCH_CHUNK_SIZE)
+        {
+          chunk = g_new0 (BatchChunk, 1);
+          chunk->calendar = g_object_ref (calendar);
+          chunk->events = g_ptr_array_new_with_free_func (g_object_unref);
+
+          g_hash_table_insert (chunks, calendar, chunk);
+          g_queue_push_tail (&self->chunks, chunk);
+        }
+
+      g_ptr_array_add (chunk->events, g_object_ref (event));
+      self->n_events++;
+    }
+
+  return self;
+}
+
+/**
+ * gcal_event_batch_free:
+ * @self: a #GcalEventBatch
+ *
+ * Frees @self.
+ */
+void
+gcal_event_batch_free (GcalEventBatch *self)
+{
+  g_return_if_fail (self != NULL);
+
+  g_queue_clear_full (&self->chunks, (GDestroyNotify) batch_chunk_free);
+  g_clear_pointer (&self->current_chunk, batch_chunk_free);
+  g_free (self);
+}
+
+/**
+ * gcal_event_batch_get_n_events:
+ * @self: a #GcalEventBatch
+ *
+ * Retrieves the number of events in all chunks of @self, after
+ * duplicated and skipped events were left out.
+ *
+ * Returns: the number of events in @self
+ */
+guint
+gcal_event_batch_get_n_events (GcalEventBatch *self)
+{
+  g_return_val_if_fail (self != NULL, 0);
+
+  return self->n_events;
+}
+
+/**
+ * gcal_event_batch_next_chunk:
+ * @self: a #GcalEventBatch
+ *
+ * Moves to the next chunk of @self, dropping the current one.
+ *
+ * Returns: %TRUE if there is a chunk, %FALSE if all chunks were consumed
+ */
+gboolean
+gcal_event_batch_next_chunk (GcalEventBatch *self)
+{
+  g_return_val_if_fail (self != NULL, FALSE);
+
+  g_clear_pointer (&self->current_chunk, batch_chunk_free);
+  self->current_chunk = g_queue_pop_head (&self->chunks);
+
+  return self->current_chunk != NULL;
+}
+
+/**
+ * gcal_event_batch_get_chunk_calendar:
+ * @self: a #GcalEventBatch
+ *
+ * Retrieves the calendar of all events in the current chunk.
+ *
+ * Returns: (transfer none): a #GcalCalendar
+ */
+GcalCalendar*
+gcal_event_batch_get_chunk_calendar (GcalEventBatch *self)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+  g_return_val_if_fail (self->current_chunk != NULL, NULL);
+
+  return self->current_chunk->calendar;
+}
+
+/**
+ * gcal_event_batch_get_chunk_n_events:
+ * @self: a #GcalEventBatch
+ *
+ * Retrieves the number of events in the current chunk.
+ *
+ * Returns: the number of events in the current chunk
+ */
+guint
+gcal_event_batch_get_chunk_n_events (GcalEventBatch *self)
+{
+  g_return_val_if_fail (self != NULL, 0);
+  g_return_val_if_fail (self->current_chunk != NULL, 0);
+
+  return self->current_chunk->events->len;
+}
+
+/**
+ * gcal_event_batch_get_chunk_components:
+ * @self: a #GcalEventBatch
+ *
+ * Retrieves the components of the events in the current chunk.
+ *
+ * Returns: (transfer container) (element-type ICalComponent): the components
+ */
+GSList*
+gcal_event_batch_get_chunk_components (GcalEventBatch *self)
+{
+  GSList *components = NULL;
+
+  g_return_val_if_fail (self != NULL, NULL);
+  g_return_val_if_fail (self->current_chunk != NULL, NULL);
+
+  for (guint i = self->current_chunk->events->len; i > 0; i--)
+    {
+      GcalEvent *event = g_ptr_array_index (self->current_chunk->events, i - 1);
+
+      components = g_slist_prepend (components, e_cal_component_get_icalcomponent (gcal_event_get_component (event)));
+    }
+
+  return components;
+}
+
+/**
+ * gcal_event_batch_get_chunk_ids:
+ * @self: a #GcalEventBatch
+ * @mod: the #GcalRecurrenceModType the objects are removed with
+ *
+ * Retrieves the ids of the objects of the events in the current chunk.
+ *
+ * Returns: (transfer full) (element-type ECalComponentId): the ids
+ */
+GSList*
+gcal_event_batch_get_chunk_ids (GcalEventBatch        *self,
+                                GcalRecurrenceModType  mod)
+{
+  GSList *ids = NULL;
+
+  g_return_val_if_fail (self != NULL, NULL);
+  g_return_val_if_fail (self->current_chunk != NULL, NULL);
+
+  for (guint i = self->current_chunk->events->len; i > 0; i--)
+    {
+      GcalEvent *event = g_ptr_array_index (self->current_chunk->events, i - 1);
+      g_autofree gchar *rid = get_event_rid (event, mod);
+
+      ids = g_slist_prepend (ids, e_cal_component_id_new (e_cal_component_get_uid (gcal_event_get_component (event)), rid));
+    }
+
+  return ids;
+}
@@ -0,0 +1,53 @@
+/* gcal-event-batch.h
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "gcal-calendar.h"
+#include "gcal-recurrence.h"
+
+G_BEGIN_DECLS
+
+#define GCAL_EVENT_BATCH_CHUNK_SIZE 100
+
+typedef struct _GcalEventBatch GcalEventBatch;
+
+GcalEventBatch*      gcal_event_batch_new                        (GPtrArray             *events,
+                                                                  GcalRecurrenceModType  mod,
+                                                                  GcalCalendar          *destination);
+
+void                 gcal_event_batch_free                       (GcalEventBatch        *self);
+
+guint                gcal_event_batch_get_n_events               (GcalEventBatch        *self);
+
+gboolean             gcal_event_batch_next_chunk                 (GcalEventBatch        *self);
+
+GcalCalendar*        gcal_event_batch_get_chunk_calendar         (GcalEventBatch        *self);
+
+guint                gcal_event_batch_get_chunk_n_events         (GcalEventBatch        *self);
+
+GSList*              gcal_event_batch_get_chunk_components       (GcalEventBatch        *self);
+
+GSList*              gcal_event_batch_get_chunk_ids              (GcalEventBatch        *self,
+                                                                  GcalRecurrenceModType  mod);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GcalEventBatch, gcal_event_batch_free)
+
+G_END_DECLS
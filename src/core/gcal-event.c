@@ -19,12 +19,13 @@
 #define G_LOG_DOMAIN "GcalEvent"
 
 #include "gcal-event.h"
-#include "gcal-application.h"
-#include "gcal-context.h"
+#include "gcal-date-format-cache.h"
 #include "gcal-debug.h"
 #include "gcal-event-attendee.h"
 #include "gcal-event-organizer.h"
 #include "gcal-recurrence.h"
+#include "gcal-time-zone-cache.h"
+#include "gcal-time-zone-monitor.h"
 #include "gcal-utils.h"
 
 #include <gio/gio.h>
@@ -75,12 +76,17 @@ struct _GcalEvent
 {
   GObject             parent;
 
-  gchar              *uid;
+  /* Shared with the tables of the calendar monitors */
+  GRefString         *uid;
   gboolean            has_recurrence;
 
-  /* These are cached, because ECalComponent returns newly allocated data for them */
-  gchar              *summary;
-  gchar              *location;
+  /*
+   * These are cached, because ECalComponent returns newly allocated data
+   * for them. They are interned, so that the instances of a recurring event,
+   * and events with a common summary or location, all share one copy.
+   */
+  GRefString         *summary;
+  GRefString         *location;
 
   /*
    * The description is cached in the class because it
@@ -89,10 +95,32 @@ struct _GcalEvent
    */
   gchar              *description;
 
+  /*
+   * Fields that the views don't need are only decoded
+   * from the component when first accessed. Decoding is
+   * serialized by the mutex, and @decoded_fields is a
+   * mask of GcalEventField.
+   */
+  GMutex              decode_mutex;
+  gint                decoded_fields;
+
   GDateTime          *dt_start;
   GDateTime          *dt_end;
   GcalRange          *range;
 
+  /*
+   * Integer representation of the dates, for layout code. The
+   * first and last days are inclusive Julian days in the local
+   * time zone, and are recalculated when the time zone serial
+   * changes.
+   */
+  gint64              start_unix;
+  gint64              end_unix;
+  gint64              first_day;
+  gint64              last_day;
+  gboolean            multiday;
+  guint               local_days_serial;
+
   GdkRGBA            *color;
   GBinding           *color_binding;
 
@@ -107,6 +135,9 @@ struct _GcalEvent
   GcalCalendar       *calendar;
 
   GcalRecurrence     *recurrence;
+
+  /* Read-only copy shown while the calendar loads */
+  gboolean            placeholder;
 };
 
 static void          gcal_event_initable_iface_init              (GInitableIface *iface);
@@ -137,6 +168,15 @@ enum {
 
 static GParamSpec* properties[N_PROPS] = { NULL, };
 
+typedef enum
+{
+  GCAL_EVENT_FIELD_DESCRIPTION = 1 << 0,
+  GCAL_EVENT_FIELD_ALARMS      = 1 << 1,
+  GCAL_EVENT_FIELD_ATTENDEES   = 1 << 2,
+  GCAL_EVENT_FIELD_ORGANIZER   = 1 << 3,
+  GCAL_EVENT_FIELD_RECURRENCE  = 1 << 4,
+} GcalEventField;
+
 /*
  * Auxiliary methods
  */
@@ -144,14 +184,60 @@ static GParamSpec* properties[N_PROPS] = { NULL, };
 static void
 clear_range (GcalEvent *self)
 {
+  self->local_days_serial = 0;
   g_clear_pointer (&self->range, gcal_range_unref);
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_RANGE]);
 }
 
+static void
+update_local_days (GcalEvent *self,
+                   guint      serial)
+{
+  GDateTime *dt_end;
+
+  if (!self->dt_start)
+    return;
+
+  dt_end = self->dt_end ? self->dt_end : self->dt_start;
+
+  self->start_unix = g_date_time_to_unix (self->dt_start);
+  self->end_unix = g_date_time_to_unix (dt_end);
+
+  if (self->all_day)
+    {
+      /* All day events are floating, and their end date is exclusive */
+      self->first_day = gcal_date_time_get_julian_day (self->dt_start);
+      self->last_day = gcal_date_time_get_julian_day (dt_end) - 1;
+    }
+  else
+    {
+      g_autoptr (GTimeZone) local_tz = g_time_zone_new_local ();
+
+      self->first_day = gcal_date_time_get_julian_day_at_timezone (self->start_unix, local_tz);
+      self->last_day = gcal_date_time_get_julian_day_at_timezone (self->end_unix - 1, local_tz);
+    }
+
+  self->last_day = MAX (self->last_day, self->first_day);
+  self->multiday = self->last_day > self->first_day;
+  self->local_days_serial = serial;
+}
+
+static inline void
+ensure_local_days (GcalEvent *self)
+{
+  guint serial = gcal_time_zone_monitor_get_serial ();
+
+  if (G_LIKELY (self->local_days_serial == serial))
+    return;
+
+  update_local_days (self, serial);
+}
+
 static GTimeZone*
 get_timezone_from_ical (GcalEvent             *self,
                         ECalComponentDateTime *comp)
 {
+  g_autoptr (ICalTimezone) calendar_zone = NULL;
   g_autoptr (GTimeZone) tz = NULL;
   ICalTimezone *zone;
   ICalTime *itt;
@@ -178,30 +264,25 @@ get_timezone_from_ical (GcalEvent             *self,
       if (g_str_has_prefix (tzid, LIBICAL_TZID_PREFIX))
         tzid += strlen (LIBICAL_TZID_PREFIX);
 
-      tz = g_time_zone_new_identifier (tzid);
+      tz = gcal_time_zone_cache_lookup_identifier (tzid);
 
       if (!tz && self->calendar)
         {
-          ICalTimezone *tzone = NULL;
-          ECalClient *client;
-
-          client = gcal_calendar_get_client (self->calendar);
+          calendar_zone = gcal_time_zone_cache_lookup_calendar_zone (self->calendar, original_tzid);
 
-          if (client && e_cal_client_get_timezone_sync (client, original_tzid, &tzone, NULL, NULL))
-            zone = tzone;
+          if (calendar_zone)
+            zone = calendar_zone;
         }
     }
 
   if (!tz && zone)
     {
-      g_autofree gchar *tzid = NULL;
       gint offset;
       gint is_daylight = 0;
 
       /* libical-glib prior to 3.0.12 fails if no return location for is_daylight is passed */
       offset = i_cal_timezone_get_utc_offset (zone, itt, &is_daylight);
-      tzid = format_utc_offset (offset);
-      tz = g_time_zone_new_identifier (tzid);
+      tz = gcal_time_zone_cache_lookup_offset (offset);
     }
 
   /*
@@ -253,6 +334,7 @@ build_component_from_datetime (GcalEvent *self,
 static void
 gcal_event_update_uid_internal (GcalEvent *self)
 {
+  g_autofree gchar *uid = NULL;
   ECalComponentId *id;
   const gchar *source_id;
 
@@ -262,18 +344,21 @@ gcal_event_update_uid_internal (GcalEvent *self)
 
   if (e_cal_component_id_get_rid (id) != NULL)
     {
-      self->uid = g_strdup_printf ("%s:%s:%s",
-                                   source_id,
-                                   e_cal_component_id_get_uid (id),
-                                   e_cal_component_id_get_rid (id));
+      uid = g_strdup_printf ("%s:%s:%s",
+                             source_id,
+                             e_cal_component_id_get_uid (id),
+                             e_cal_component_id_get_rid (id));
     }
   else
     {
-      self->uid = g_strdup_printf ("%s:%s",
-                                   source_id,
-                                   e_cal_component_id_get_uid (id));
+      uid = g_strdup_printf ("%s:%s",
+                             source_id,
+                             e_cal_component_id_get_uid (id));
     }
 
+  g_clear_pointer (&self->uid, g_ref_string_release);
+  self->uid = g_ref_string_new (uid);
+
   e_cal_component_id_free (id);
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_UID]);
 }
@@ -283,6 +368,7 @@ load_alarms (GcalEvent *self)
 {
   GSList *alarm_uids, *l;
 
+  self->alarms = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
   alarm_uids = e_cal_component_get_alarm_uids (self->component);
 
   for (l = alarm_uids; l != NULL; l = l->next)
@@ -312,6 +398,11 @@ load_attendees (GcalEvent *self)
 {
   GSList *ecal_attendees = NULL, *c = NULL;
 
+  self->attendees = g_list_store_new (GCAL_TYPE_EVENT_ATTENDEE);
+
+  if (!e_cal_component_has_attendees (self->component))
+    return;
+
   ecal_attendees = e_cal_component_get_attendees (self->component);
 
   for (c = ecal_attendees; c != NULL; c = c->next)
@@ -324,6 +415,73 @@ load_attendees (GcalEvent *self)
   g_slist_free_full (ecal_attendees, e_cal_component_attendee_free);
 }
 
+static void
+load_organizer (GcalEvent *self)
+{
+  ECalComponentOrganizer *organizer;
+
+  organizer = e_cal_component_get_organizer (self->component);
+
+  if (organizer)
+    self->organizer = gcal_event_organizer_new (organizer);
+
+  e_cal_component_organizer_free (organizer);
+}
+
+static void
+decode_field (GcalEvent      *self,
+              GcalEventField  field)
+{
+  g_mutex_lock (&self->decode_mutex);
+
+  if (!(g_atomic_int_get (&self->decoded_fields) & field))
+    {
+      GCAL_TRACE_MSG ("Decoding field %d of event %s", field, self->uid);
+
+      switch (field)
+        {
+        case GCAL_EVENT_FIELD_DESCRIPTION:
+          self->description = get_desc_from_component (self->component, "\n\n");
+          if (self->description && !*self->description)
+            g_clear_pointer (&self->description, g_free);
+          break;
+
+        case GCAL_EVENT_FIELD_ALARMS:
+          load_alarms (self);
+          break;
+
+        case GCAL_EVENT_FIELD_ATTENDEES:
+          load_attendees (self);
+          break;
+
+        case GCAL_EVENT_FIELD_ORGANIZER:
+          load_organizer (self);
+          break;
+
+        case GCAL_EVENT_FIELD_RECURRENCE:
+          self->recurrence = gcal_recurrence_parse_recurrence_rules (self->component);
+          break;
+
+        default:
+          g_assert_not_reached ();
+        }
+
+      g_atomic_int_or (&self->decoded_fields, field);
+    }
+
+  g_mutex_unlock (&self->decode_mutex);
+}
+
+static inline void
+ensure_field (GcalEvent      *self,
+              GcalEventField  field)
+{
+  if (G_LIKELY (g_atomic_int_get (&self->decoded_fields) & field))
+    return;
+
+  decode_field (self, field);
+}
+
 static gboolean
 setup_component (GcalEvent  *self,
                  GError    **error)
@@ -335,8 +493,7 @@ setup_component (GcalEvent  *self,
   ECalComponentText *text;
   ICalTime *date;
   gboolean start_is_all_day, end_is_all_day;
-  gchar *description, *location;
-  ECalComponentOrganizer *organizer = NULL;
+  gchar *location;
 
   g_assert (self->component != NULL);
 
@@ -422,41 +579,26 @@ setup_component (GcalEvent  *self,
   location = e_cal_component_get_location (self->component);
   gcal_event_set_location (self, location ? location : "");
 
-  /* Setup description */
-  description = get_desc_from_component (self->component, "\n\n");
-  gcal_event_set_description (self, description);
-
   /* Setup UID */
   gcal_event_update_uid_internal (self);
 
   /* Set has-recurrence to check if the component has recurrence or not */
   self->has_recurrence = e_cal_component_has_recurrences (self->component);
 
-  /* Load the recurrence-rules in GcalRecurrence struct */
-  self->recurrence = gcal_recurrence_parse_recurrence_rules (self->component);
-
-  /* Load and setup the alarms */
-  load_alarms (self);
-
-  /* Load and setup organizer */
-  organizer = e_cal_component_get_organizer (self->component);
-  if (organizer)
-    self->organizer = gcal_event_organizer_new (organizer);
+  /*
+   * The description, recurrence rules, alarms, organizer and attendees
+   * are decoded on demand, see decode_field().
+   */
 
-  /* load and setup attendees */
-  if (e_cal_component_has_attendees (self->component))
-    load_attendees (self);
+  update_local_days (self, gcal_time_zone_monitor_get_serial ());
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_HAS_RECURRENCE]);
-  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_RECURRENCE]);
 
-  g_clear_pointer (&description, g_free);
   g_clear_pointer (&location, g_free);
 
   e_cal_component_text_free (text);
   e_cal_component_datetime_free (start);
   e_cal_component_datetime_free (end);
-  e_cal_component_organizer_free (organizer);
 
   return TRUE;
 }
@@ -466,6 +608,11 @@ gcal_event_set_component_internal (GcalEvent     *self,
                                    ECalComponent *component)
 {
   g_assert (self->component == NULL);
+
+  /* gcal_event_new_take() sets the component itself */
+  if (!component)
+    return;
+
   self->component = e_cal_component_clone (component);
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_COMPONENT]);
 }
@@ -498,11 +645,11 @@ gcal_event_finalize (GObject *object)
   g_clear_pointer (&self->dt_start, g_date_time_unref);
   g_clear_pointer (&self->dt_end, g_date_time_unref);
   g_clear_pointer (&self->range, gcal_range_unref);
-  g_clear_pointer (&self->summary, g_free);
-  g_clear_pointer (&self->location, g_free);
+  g_clear_pointer (&self->summary, g_ref_string_release);
+  g_clear_pointer (&self->location, g_ref_string_release);
   g_clear_pointer (&self->description, g_free);
   g_clear_pointer (&self->alarms, g_hash_table_unref);
-  g_clear_pointer (&self->uid, g_free);
+  g_clear_pointer (&self->uid, g_ref_string_release);
   g_clear_pointer (&self->color, gdk_rgba_free);
   g_clear_pointer (&self->recurrence, gcal_recurrence_unref);
   g_clear_object (&self->component);
@@ -510,6 +657,8 @@ gcal_event_finalize (GObject *object)
   g_clear_object (&self->attendees);
   g_clear_object (&self->organizer);
 
+  g_mutex_clear (&self->decode_mutex);
+
   G_OBJECT_CLASS (gcal_event_parent_class)->finalize (object);
 }
 
@@ -572,7 +721,7 @@ gcal_event_get_property (GObject    *object,
       break;
 
     case PROP_RECURRENCE:
-      g_value_set_boxed (value, self->recurrence);
+      g_value_set_boxed (value, gcal_event_get_recurrence (self));
       break;
 
     default:
@@ -811,11 +960,7 @@ gcal_event_init (GcalEvent *self)
   gdk_rgba_parse (&rgba, "#ffffff");
   self->color = gdk_rgba_copy (&rgba);
 
-  /* Alarms */
-  self->alarms = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
-
-  /* Attendees */
-  self->attendees = g_list_store_new (GCAL_TYPE_EVENT_ATTENDEE);
+  g_mutex_init (&self->decode_mutex);
 }
 
 /**
@@ -844,7 +989,40 @@ gcal_event_new (GcalCalendar   *calendar,
 }
 
 /**
- * gcal_event_new:
+ * gcal_event_new_take:
+ * @calendar: (nullable): a #GcalCalendar
+ * @component: (transfer full): a #ECalComponent
+ * @error: (nullable): return location for a #GError
+ *
+ * Creates a new event for @calendar, taking ownership of @component
+ * instead of cloning it. The caller must not use @component after
+ * calling this function, even when it fails.
+ *
+ * Returns: (transfer full)(nullable): a #GcalEvent
+ */
+GcalEvent*
+gcal_event_new_take (GcalCalendar   *calendar,
+                     ECalComponent  *component,
+                     GError        **error)
+{
+  g_autoptr (GcalEvent) self = NULL;
+
+  g_return_val_if_fail (E_IS_CAL_COMPONENT (component), NULL);
+
+  self = g_object_new (GCAL_TYPE_EVENT, NULL);
+  self->component = component;
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_COMPONENT]);
+
+  gcal_event_set_calendar (self, calendar);
+
+  if (!g_initable_init (G_INITABLE (self), NULL, error))
+    return NULL;
+
+  return g_steal_pointer (&self);
+}
+
+/**
+ * gcal_event_new_from_event:
  * @self: a #GcalEvent
  *
  * Clones @event into a new #GcalEvent instance. This is useful
@@ -855,14 +1033,14 @@ gcal_event_new (GcalCalendar   *calendar,
 GcalEvent*
 gcal_event_new_from_event (GcalEvent *self)
 {
-  g_autoptr (ECalComponent) component = NULL;
+  ECalComponent *component;
 
   g_return_val_if_fail (GCAL_IS_EVENT (self), NULL);
 
   component = e_cal_component_clone (self->component);
   e_cal_component_commit_sequence (component);
 
-  return gcal_event_new (self->calendar, component, NULL);
+  return gcal_event_new_take (self->calendar, component, NULL);
 }
 
 /**
@@ -1078,6 +1256,70 @@ gcal_event_get_range (GcalEvent *self)
   return self->range;
 }
 
+/**
+ * gcal_event_get_start_unix:
+ * @self: a #GcalEvent
+ *
+ * Retrieves the start date of @self as a UNIX timestamp.
+ *
+ * Returns: the start of @self, in seconds since the epoch
+ */
+gint64
+gcal_event_get_start_unix (GcalEvent *self)
+{
+  g_return_val_if_fail (GCAL_IS_EVENT (self), 0);
+
+  ensure_local_days (self);
+
+  return self->start_unix;
+}
+
+/**
+ * gcal_event_get_end_unix:
+ * @self: a #GcalEvent
+ *
+ * Retrieves the end date of @self as a UNIX timestamp.
+ *
+ * Returns: the end of @self, in seconds since the epoch
+ */
+gint64
+gcal_event_get_end_unix (GcalEvent *self)
+{
+  g_return_val_if_fail (GCAL_IS_EVENT (self), 0);
+
+  ensure_local_days (self);
+
+  return self->end_unix;
+}
+
+/**
+ * gcal_event_get_local_days:
+ * @self: a #GcalEvent
+ * @out_first_day: (out)(optional): return location for the first day
+ * @out_last_day: (out)(optional): return location for the last day
+ *
+ * Retrieves the Julian days of the first and last days, inclusive,
+ * that @self spans in the local time zone. All day events are not
+ * affected by time zones.
+ *
+ * This doesn't allocate memory, and is meant for layout code.
+ */
+void
+gcal_event_get_local_days (GcalEvent *self,
+                           gint64    *out_first_day,
+                           gint64    *out_last_day)
+{
+  g_return_if_fail (GCAL_IS_EVENT (self));
+
+  ensure_local_days (self);
+
+  if (out_first_day)
+    *out_first_day = self->first_day;
+
+  if (out_last_day)
+    *out_last_day = self->last_day;
+}
+
 /**
  * gcal_event_get_description:
  * @self a #GcalEvent
@@ -1091,6 +1333,8 @@ gcal_event_get_description (GcalEvent *self)
 {
   g_return_val_if_fail (GCAL_IS_EVENT (self), NULL);
 
+  ensure_field (self, GCAL_EVENT_FIELD_DESCRIPTION);
+
   return self->description ? self->description : "";
 }
 
@@ -1110,6 +1354,8 @@ gcal_event_set_description (GcalEvent   *self,
   if (description && !*description)
     description = NULL;
 
+  ensure_field (self, GCAL_EVENT_FIELD_DESCRIPTION);
+
   if (g_strcmp0 (self->description, description) != 0)
     {
       g_clear_pointer (&self->description, g_free);
@@ -1236,6 +1482,8 @@ gcal_event_remove_all_alarms (GcalEvent *self)
 
   g_return_if_fail (GCAL_IS_EVENT (self));
 
+  ensure_field (self, GCAL_EVENT_FIELD_ALARMS);
+
   g_hash_table_iter_init (&iter, self->alarms);
   while (g_hash_table_iter_next (&iter, (gpointer*) &minutes, (gpointer*) &alarm_uid))
     {
@@ -1270,6 +1518,8 @@ gcal_event_add_alarm (GcalEvent          *self,
 
   g_return_if_fail (GCAL_IS_EVENT (self));
 
+  ensure_field (self, GCAL_EVENT_FIELD_ALARMS);
+
   new_alarm = e_cal_component_alarm_copy (alarm);
   minutes = get_alarm_trigger_minutes (self, alarm);
 
@@ -1314,6 +1564,8 @@ gcal_event_remove_alarm (GcalEvent *self,
 
   g_return_if_fail (GCAL_IS_EVENT (self));
 
+  ensure_field (self, GCAL_EVENT_FIELD_ALARMS);
+
   alarm_uid = g_hash_table_lookup (self->alarms, GINT_TO_POINTER (type));
 
   /* Only 1 alarm per relative time */
@@ -1366,8 +1618,8 @@ gcal_event_set_location (GcalEvent   *self,
       e_cal_component_set_location (self->component, (location && *location) ? location : NULL);
       e_cal_component_commit_sequence (self->component);
 
-      g_clear_pointer (&self->location, g_free);
-      self->location = g_strdup (location ? location : "");
+      g_clear_pointer (&self->location, g_ref_string_release);
+      self->location = g_ref_string_new_intern (location ? location : "");
 
       g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_LOCATION]);
     }
@@ -1471,8 +1723,8 @@ gcal_event_set_summary (GcalEvent   *self,
 
       e_cal_component_text_free (text_component);
 
-      g_clear_pointer (&self->summary, g_free);
-      self->summary = g_strdup (summary ? summary : "");
+      g_clear_pointer (&self->summary, g_ref_string_release);
+      self->summary = g_ref_string_new_intern (summary ? summary : "");
 
       g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SUMMARY]);
     }
@@ -1497,6 +1749,87 @@ gcal_event_get_uid (GcalEvent *self)
   return self->uid;
 }
 
+/**
+ * gcal_event_get_uid_ref:
+ * @self: a #GcalEvent
+ *
+ * Retrieves the unique identifier of the event as a #GRefString,
+ * so that tables keyed by event ids can share it with @self by
+ * calling g_ref_string_acquire() instead of copying it.
+ *
+ * Returns: (transfer none): the unique identifier of the event
+ */
+GRefString*
+gcal_event_get_uid_ref (GcalEvent *self)
+{
+  g_return_val_if_fail (GCAL_IS_EVENT (self), NULL);
+
+  return self->uid;
+}
+
+/**
+ * gcal_event_get_memory_size:
+ * @self: a #GcalEvent
+ *
+ * Estimates the number of bytes owned by @self, excluding its
+ * interned summary and location, which are shared with other
+ * events, and excluding the iCalendar component.
+ *
+ * This is only meant for diagnostics.
+ *
+ * Returns: the approximate size of @self, in bytes
+ */
+gsize
+gcal_event_get_memory_size (GcalEvent *self)
+{
+  gsize size;
+
+  g_return_val_if_fail (GCAL_IS_EVENT (self), 0);
+
+  size = sizeof (GcalEvent);
+
+  if (self->uid)
+    size += g_ref_string_length (self->uid) + 1;
+
+  if (self->description)
+    size += strlen (self->description) + 1;
+
+  return size;
+}
+
+/**
+ * gcal_event_is_placeholder:
+ * @self: a #GcalEvent
+ *
+ * Retrieves whether @self is a placeholder, that is, a read-only
+ * copy of an event that is shown while its calendar is loading.
+ *
+ * Returns: %TRUE if @self is a placeholder
+ */
+gboolean
+gcal_event_is_placeholder (GcalEvent *self)
+{
+  g_return_val_if_fail (GCAL_IS_EVENT (self), FALSE);
+
+  return self->placeholder;
+}
+
+/**
+ * gcal_event_set_placeholder:
+ * @self: a #GcalEvent
+ * @placeholder: whether @self is a placeholder
+ *
+ * Marks @self as a placeholder. See gcal_event_is_placeholder().
+ */
+void
+gcal_event_set_placeholder (GcalEvent *self,
+                            gboolean   placeholder)
+{
+  g_return_if_fail (GCAL_IS_EVENT (self));
+
+  self->placeholder = !!placeholder;
+}
+
 /**
  * gcal_event_is_multiday:
  * @self: a #GcalEvent
@@ -1520,43 +1853,11 @@ gcal_event_get_uid (GcalEvent *self)
 gboolean
 gcal_event_is_multiday (GcalEvent *self)
 {
-  g_autoptr (GDateTime) start_date = NULL;
-  g_autoptr (GDateTime) end_date = NULL;
-  GDate start_dt;
-  GDate end_dt;
-  gint n_days;
-
   g_return_val_if_fail (GCAL_IS_EVENT (self), FALSE);
 
-  if (self->all_day)
-    {
-      start_date = g_date_time_ref (self->dt_start);
-      end_date = g_date_time_ref (gcal_event_get_date_end (self));
-      n_days = 1;
-    }
-  else
-    {
-      g_autoptr (GDateTime) inclusive_end_date = NULL;
-
-      inclusive_end_date = g_date_time_add_seconds (gcal_event_get_date_end (self), -1);
-      start_date = g_date_time_to_local (self->dt_start);
-      end_date = g_date_time_to_local (inclusive_end_date);
-      n_days = 0;
-    }
-
-  g_date_clear (&start_dt, 1);
-  g_date_set_dmy (&start_dt,
-                  g_date_time_get_day_of_month (start_date),
-                  g_date_time_get_month (start_date),
-                  g_date_time_get_year (start_date));
+  ensure_local_days (self);
 
-  g_date_clear (&end_dt, 1);
-  g_date_set_dmy (&end_dt,
-                  g_date_time_get_day_of_month (end_date),
-                  g_date_time_get_month (end_date),
-                  g_date_time_get_year (end_date));
-
-  return g_date_days_between (&start_dt, &end_dt) > n_days;
+  return self->multiday;
 }
 
 /**
@@ -1843,6 +2144,8 @@ gcal_event_set_recurrence (GcalEvent      *self,
   comp = gcal_event_get_component (self);
   icalcomp = e_cal_component_get_icalcomponent (comp);
 
+  ensure_field (self, GCAL_EVENT_FIELD_RECURRENCE);
+
   g_clear_pointer (&self->recurrence, gcal_recurrence_unref);
   self->recurrence = gcal_recurrence_copy (recur);
 
@@ -1877,6 +2180,8 @@ gcal_event_get_recurrence (GcalEvent *self)
 {
   g_return_val_if_fail (GCAL_IS_EVENT (self), NULL);
 
+  ensure_field (self, GCAL_EVENT_FIELD_RECURRENCE);
+
   return self->recurrence;
 }
 
@@ -1894,40 +2199,29 @@ gchar*
 gcal_event_format_date (GcalEvent *self)
 {
   g_autofree gchar *formatted_string = NULL;
-  g_autofree gchar *start_date = NULL;
-  g_autofree gchar *start_time = NULL;
-  g_autofree gchar *end_date = NULL;
-  g_autofree gchar *end_time = NULL;
-  GcalApplication *application;
-  GcalTimeFormat time_format;
-  GcalContext *context;
+  const gchar *hour_format;
+  const gchar *start_date;
+  const gchar *start_time;
+  const gchar *end_date;
+  const gchar *end_time;
   GDateTime *date_start;
   GDateTime *date_end;
-  const gchar *hour_format;
   gboolean is_multiday;
   gboolean is_all_day;
 
   g_return_val_if_fail (GCAL_IS_EVENT (self), NULL);
 
-  /* XXX: nasty... */
-  application = GCAL_APPLICATION (g_application_get_default ());
-  context = gcal_application_get_context (application);
-  time_format = gcal_context_get_time_format (context);
-
-  if (time_format == GCAL_TIME_FORMAT_24H)
-    hour_format = "%R";
-  else
-    hour_format = "%I:%M %P";
+  hour_format = gcal_date_format_cache_get_hour_format ();
 
   date_start = gcal_event_get_date_start (self);
   date_end = gcal_event_get_date_end (self);
   is_multiday = gcal_event_is_multiday (self);
   is_all_day = gcal_event_get_all_day (self);
 
-  start_date = g_date_time_format (date_start, "%x");
-  start_time = g_date_time_format (date_start, hour_format);
-  end_date = g_date_time_format (date_end, "%x");
-  end_time = g_date_time_format (date_end, hour_format);
+  start_date = gcal_date_format_cache_format_date (date_start, "%x");
+  start_time = gcal_date_format_cache_format_time (date_start, hour_format);
+  end_date = gcal_date_format_cache_format_date (date_end, "%x");
+  end_time = gcal_date_format_cache_format_time (date_end, hour_format);
 
   if (is_multiday)
     {
@@ -1953,7 +2247,7 @@ gcal_event_format_date (GcalEvent *self)
     {
       if (is_all_day)
         {
-          formatted_string = g_steal_pointer (&start_date);
+          formatted_string = g_strdup (start_date);
         }
       else
         {
@@ -1976,11 +2270,10 @@ gboolean
 gcal_event_overlaps (GcalEvent *self,
                      GcalRange *range)
 {
-  GcalRangeOverlap overlap;
-
   g_return_val_if_fail (GCAL_IS_EVENT (self), FALSE);
-  overlap = gcal_range_calculate_overlap (gcal_event_get_range (self), range, NULL);
-  return overlap != GCAL_RANGE_NO_OVERLAP;
+
+  return gcal_range_value_overlaps (gcal_range_get_value (gcal_event_get_range (self)),
+                                    gcal_range_get_value (range));
 }
 
 /**
@@ -1997,8 +2290,7 @@ gcal_event_get_attendees (GcalEvent *self)
 {
   g_return_val_if_fail (GCAL_IS_EVENT (self), NULL);
 
-  if (self->attendees == NULL)
-    return NULL;
+  ensure_field (self, GCAL_EVENT_FIELD_ATTENDEES);
 
   return G_LIST_MODEL (self->attendees);
 }
@@ -2014,5 +2306,7 @@ gcal_event_get_organizer (GcalEvent *self)
 {
   g_return_val_if_fail (GCAL_IS_EVENT (self), NULL);
 
+  ensure_field (self, GCAL_EVENT_FIELD_ORGANIZER);
+
   return self->organizer;
 }
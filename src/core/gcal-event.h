@@ -55,6 +55,10 @@ GcalEvent*           gcal_event_new                              (GcalCalendar
                                                                   ECalComponent      *component,
                                                                   GError            **error);
 
+GcalEvent*           gcal_event_new_take                         (GcalCalendar       *calendar,
+                                                                  ECalComponent      *component,
+                                                                  GError            **error);
+
 GcalEvent*           gcal_event_new_from_event                   (GcalEvent          *self);
 
 gboolean             gcal_event_get_all_day                      (GcalEvent          *self);
@@ -81,6 +85,14 @@ void                 gcal_event_set_date_start                   (GcalEvent
 
 GcalRange*           gcal_event_get_range                        (GcalEvent          *self);
 
+gint64               gcal_event_get_start_unix                   (GcalEvent          *self);
+
+gint64               gcal_event_get_end_unix                     (GcalEvent          *self);
+
+void                 gcal_event_get_local_days                   (GcalEvent          *self,
+                                                                  gint64             *out_first_day,
+                                                                  gint64             *out_last_day);
+
 const gchar*         gcal_event_get_description                  (GcalEvent          *self);
 
 void                 gcal_event_set_description                  (GcalEvent          *self,
@@ -117,6 +129,15 @@ void                 gcal_event_set_summary                      (GcalEvent
 
 const gchar*         gcal_event_get_uid                          (GcalEvent          *self);
 
+GRefString*          gcal_event_get_uid_ref                      (GcalEvent          *self);
+
+gsize                gcal_event_get_memory_size                  (GcalEvent          *self);
+
+gboolean             gcal_event_is_placeholder                   (GcalEvent          *self);
+
+void                 gcal_event_set_placeholder                  (GcalEvent          *self,
+                                                                  gboolean            placeholder);
+
 /* Utilities */
 
 gboolean             gcal_event_is_multiday                      (GcalEvent          *self);
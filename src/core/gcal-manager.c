@@ -20,11 +20,15 @@
 
 #include "gcal-application.h"
 #include "gcal-debug.h"
+#include "gcal-event-batch.h"
 #include "gcal-manager.h"
+#include "gcal-startup-profile.h"
+#include "gcal-time-zone-cache.h"
 #include "gcal-timeline.h"
 #include "gcal-timeline-subscriber.h"
 #include "gcal-utils.h"
 
+#include <errno.h>
 #include <libedataserverui4/libedataserverui4.h>
 
 /**
@@ -36,14 +40,76 @@
  * #GcalManager is the backend of GNOME Calendar. It sets everything
  * up, connects to the Online Accounts daemon, and manages the events
  * and calendars.
+ *
+ * Startup is staged so that the window can be shown before any of
+ * the calendars are available. The source registry is created
+ * asynchronously, and once it is connected, the visible calendars
+ * are opened first. Hidden calendars and the credentials prompter
+ * are only set up after the visible calendars finished loading, or
+ * after %DEFERRED_STARTUP_TIMEOUT_SECONDS, whichever comes first.
  */
 
+#define DEFERRED_STARTUP_TIMEOUT_SECONDS 2
+
+typedef enum
+{
+  LOAD_STAGE_REGULAR,
+  LOAD_STAGE_STARTUP_VISIBLE,
+  LOAD_STAGE_STARTUP_DEFERRED,
+} LoadStage;
+
+typedef struct
+{
+  GcalManager        *manager;
+  LoadStage           stage;
+} LoadSourceData;
+
 typedef struct
 {
   GcalEvent          *event;
   GcalManager        *manager;
+  guint               change_id;
 } AsyncOpsData;
 
+typedef struct
+{
+  GcalManager        *manager;
+  gchar              *source_uid;
+  gboolean            collection;
+  gboolean            queued;
+  gboolean            running;
+  guint               n_failures;
+  gint64              start_time;
+  gint64              retry_time;
+  guint               retry_timeout_id;
+  gint64              latency;
+} RefreshSource;
+
+typedef struct
+{
+  GcalManager        *manager;
+  gchar              *source_uid;
+} RefreshData;
+
+typedef enum
+{
+  BATCH_CREATE,
+  BATCH_UPDATE,
+  BATCH_REMOVE,
+  BATCH_MOVE,
+} BatchOperation;
+
+typedef struct
+{
+  BatchOperation      operation;
+  GcalRecurrenceModType mod;
+  GcalCalendar       *destination;
+  GcalEventBatch     *batch;
+  guint               n_completed;
+  GcalManagerProgressFunc progress_func;
+  gpointer            progress_data;
+} BatchData;
+
 typedef struct
 {
   gchar              *event_uid;
@@ -70,9 +136,22 @@ struct _GcalManager
 
   GCancellable       *async_ops;
 
-  gint                clients_synchronizing;
+  /* Refresh scheduler */
+  GHashTable         *refresh_sources;
+  GQueue              refresh_queue;
+  guint               n_running_refreshes;
+  guint               max_concurrent_refreshes;
+  gboolean            synchronizing;
 
   GcalTimeline       *timeline;
+
+  /* Staged startup */
+  GQueue              deferred_sources;
+  guint               deferred_startup_id;
+  gboolean            deferred_startup_done;
+  gboolean            visible_calendars_loaded;
+  guint               n_visible_loads;
+  guint               n_startup_loads;
 };
 
 G_DEFINE_TYPE (GcalManager, gcal_manager, G_TYPE_OBJECT)
@@ -81,6 +160,7 @@ enum
 {
   PROP_0,
   PROP_DEFAULT_CALENDAR,
+  PROP_MAX_CONCURRENT_REFRESHES,
   PROP_SYNCHRONIZING,
   NUM_PROPS
 };
@@ -90,12 +170,47 @@ enum
   CALENDAR_ADDED,
   CALENDAR_CHANGED,
   CALENDAR_REMOVED,
+  EVENT_CHANGE_FAILED,
   NUM_SIGNALS
 };
 
 static guint       signals[NUM_SIGNALS] = { 0, };
 static GParamSpec *properties[NUM_PROPS] = { NULL, };
 
+static gboolean      run_deferred_startup_cb                     (gpointer            user_data);
+
+static void          run_refreshes                               (GcalManager        *self);
+
+static void          on_collection_source_refreshed              (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
+static void          on_client_refreshed                         (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
+static void          on_batch_objects_created_cb                 (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
+static void          on_batch_objects_modified_cb                (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
+static void          on_batch_objects_removed_cb                 (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
+#define DEFAULT_MAX_CONCURRENT_REFRESHES 4
+#define REFRESH_BACKOFF_MIN_SECONDS 30
+#define REFRESH_BACKOFF_MAX_SECONDS (30 * 60)
+
+static gchar*
+get_snapshot_path (void)
+{
+  return g_build_filename (g_get_user_cache_dir (), "gnome-calendar", "timeline-snapshot", NULL);
+}
+
 static void
 free_async_ops_data (AsyncOpsData *data)
 {
@@ -103,10 +218,319 @@ free_async_ops_data (AsyncOpsData *data)
   g_free (data);
 }
 
+static AsyncOpsData*
+async_ops_data_new (GcalManager *self,
+                    GcalEvent   *event,
+                    guint        change_id)
+{
+  AsyncOpsData *data;
+
+  data = g_new0 (AsyncOpsData, 1);
+  data->event = g_object_ref (event);
+  data->manager = self;
+  data->change_id = change_id;
+
+  return data;
+}
+
+/*
+ * Only changes to single events are applied optimistically. Changes
+ * to whole recurrence series are only shown once they are saved.
+ */
+static gboolean
+can_apply_optimistically (GcalEvent             *event,
+                          GcalRecurrenceModType  mod)
+{
+  return !gcal_event_has_recurrence (event) || mod == GCAL_RECURRENCE_MOD_THIS_ONLY;
+}
+
+static void
+resolve_event_change (AsyncOpsData *data,
+                      const GError *error)
+{
+  if (data->change_id != 0)
+    gcal_timeline_resolve_pending_change (data->manager->timeline, data->change_id, error == NULL);
+
+  if (error && !g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    g_signal_emit (data->manager, signals[EVENT_CHANGE_FAILED], 0, data->event, error);
+}
+
+static void
+refresh_source_free (RefreshSource *refresh)
+{
+  g_clear_handle_id (&refresh->retry_timeout_id, g_source_remove);
+  g_clear_pointer (&refresh->source_uid, g_free);
+  g_free (refresh);
+}
+
+static void
+refresh_data_free (RefreshData *data)
+{
+  g_clear_object (&data->manager);
+  g_clear_pointer (&data->source_uid, g_free);
+  g_free (data);
+}
+
+static GcalCalendar*
+get_calendar_for_uid (GcalManager *self,
+                      const gchar *source_uid)
+{
+  g_autoptr (ESource) source = NULL;
+
+  if (!self->source_registry)
+    return NULL;
+
+  source = e_source_registry_ref_source (self->source_registry, source_uid);
+
+  return source ? g_hash_table_lookup (self->clients, source) : NULL;
+}
+
+static void
+update_synchronizing (GcalManager *self)
+{
+  gboolean synchronizing;
+
+  synchronizing = self->n_running_refreshes > 0 || !g_queue_is_empty (&self->refresh_queue);
+
+  if (self->synchronizing == synchronizing)
+    return;
+
+  self->synchronizing = synchronizing;
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SYNCHRONIZING]);
+}
+
+/*
+ * Sources that failed to refresh are retried automatically once their
+ * backoff delay is over. Until then, they're only refreshed if @force
+ * is set, e.g. when the user explicitly asks for a refresh.
+ */
+static void
+queue_refresh (GcalManager *self,
+               const gchar *source_uid,
+               gboolean     collection,
+               gboolean     force)
+{
+  RefreshSource *refresh;
+
+  refresh = g_hash_table_lookup (self->refresh_sources, source_uid);
+
+  if (!refresh)
+    {
+      refresh = g_new0 (RefreshSource, 1);
+      refresh->manager = self;
+      refresh->source_uid = g_strdup (source_uid);
+      refresh->collection = collection;
+      refresh->latency = -1;
+
+      g_hash_table_insert (self->refresh_sources, refresh->source_uid, refresh);
+    }
+
+  if (refresh->queued || refresh->running)
+    return;
+
+  if (!force && refresh->retry_time > g_get_monotonic_time ())
+    {
+      GCAL_TRACE_MSG ("Not refreshing %s, backing off after %u failures", source_uid, refresh->n_failures);
+      return;
+    }
+
+  g_clear_handle_id (&refresh->retry_timeout_id, g_source_remove);
+
+  refresh->queued = TRUE;
+  g_queue_push_tail (&self->refresh_queue, refresh);
+}
+
+/*
+ * Visible calendars go first, then collections, so that new calendars
+ * are discovered early, and hidden calendars last.
+ */
+static guint
+get_refresh_priority (GcalManager   *self,
+                      RefreshSource *refresh)
+{
+  GcalCalendar *calendar;
+
+  if (refresh->collection)
+    return 1;
+
+  calendar = get_calendar_for_uid (self, refresh->source_uid);
+
+  return calendar && gcal_calendar_get_visible (calendar) ? 0 : 2;
+}
+
+static RefreshSource*
+pop_next_refresh (GcalManager *self)
+{
+  RefreshSource *refresh;
+  GList *best_link;
+  guint best_priority;
+
+  best_link = NULL;
+  best_priority = G_MAXUINT;
+
+  for (GList *l = self->refresh_queue.head; l; l = l->next)
+    {
+      guint priority = get_refresh_priority (self, l->data);
+
+      if (priority < best_priority)
+        {
+          best_link = l;
+          best_priority = priority;
+        }
+
+      if (priority == 0)
+        break;
+    }
+
+  if (!best_link)
+    return NULL;
+
+  refresh = best_link->data;
+  refresh->queued = FALSE;
+
+  g_queue_delete_link (&self->refresh_queue, best_link);
+
+  return refresh;
+}
+
+static gboolean
+retry_refresh_cb (gpointer user_data)
+{
+  RefreshSource *refresh = user_data;
+  GcalManager *self = refresh->manager;
+
+  refresh->retry_timeout_id = 0;
+
+  GCAL_TRACE_MSG ("Retrying to refresh %s", refresh->source_uid);
+
+  queue_refresh (self, refresh->source_uid, refresh->collection, TRUE);
+  run_refreshes (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+finish_refresh (GcalManager  *self,
+                const gchar  *source_uid,
+                const GError *error)
+{
+  RefreshSource *refresh;
+
+  g_assert (self->n_running_refreshes > 0);
+  self->n_running_refreshes--;
+
+  /* The source may have been removed in the meantime */
+  refresh = g_hash_table_lookup (self->refresh_sources, source_uid);
+
+  if (refresh)
+    {
+      refresh->running = FALSE;
+
+      if (!error)
+        {
+          refresh->latency = g_get_monotonic_time () - refresh->start_time;
+          refresh->n_failures = 0;
+          refresh->retry_time = 0;
+
+          g_debug ("Source %s refreshed in %.3lf s", source_uid, refresh->latency / (gdouble) G_USEC_PER_SEC);
+
+          if (!refresh->collection)
+            {
+              GcalCalendar *calendar = get_calendar_for_uid (self, source_uid);
+
+              /* The backend may define different time zones now */
+              if (calendar)
+                gcal_time_zone_cache_remove_calendar (calendar);
+            }
+        }
+      else if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        {
+          gint64 backoff;
+
+          refresh->n_failures++;
+
+          backoff = (gint64) REFRESH_BACKOFF_MIN_SECONDS << MIN (refresh->n_failures - 1, 8);
+          backoff = MIN (backoff, REFRESH_BACKOFF_MAX_SECONDS);
+          refresh->retry_time = g_get_monotonic_time () + backoff * G_USEC_PER_SEC;
+
+          g_clear_handle_id (&refresh->retry_timeout_id, g_source_remove);
+          refresh->retry_timeout_id = g_timeout_add_seconds (backoff, retry_refresh_cb, refresh);
+
+          g_warning ("Error refreshing source %s, retrying in %" G_GINT64_FORMAT " s: %s",
+                     source_uid,
+                     backoff,
+                     error->message);
+        }
+    }
+
+  run_refreshes (self);
+}
+
+static void
+run_refreshes (GcalManager *self)
+{
+  GCAL_ENTRY;
+
+  while (self->n_running_refreshes < self->max_concurrent_refreshes)
+    {
+      RefreshSource *refresh;
+      RefreshData *data;
+
+      refresh = pop_next_refresh (self);
+
+      if (!refresh)
+        break;
+
+      data = g_new0 (RefreshData, 1);
+      data->manager = g_object_ref (self);
+      data->source_uid = g_strdup (refresh->source_uid);
+
+      if (refresh->collection)
+        {
+          e_source_registry_refresh_backend (self->source_registry,
+                                             refresh->source_uid,
+                                             NULL,
+                                             on_collection_source_refreshed,
+                                             data);
+        }
+      else
+        {
+          GcalCalendar *calendar = get_calendar_for_uid (self, refresh->source_uid);
+
+          /* Removed while it was queued */
+          if (!calendar)
+            {
+              refresh_data_free (data);
+              continue;
+            }
+
+          e_client_refresh (E_CLIENT (gcal_calendar_get_client (calendar)),
+                            NULL,
+                            on_client_refreshed,
+                            data);
+        }
+
+      GCAL_TRACE_MSG ("Refreshing %s (%u running, %u queued)",
+                      refresh->source_uid,
+                      self->n_running_refreshes + 1,
+                      g_queue_get_length (&self->refresh_queue));
+
+      refresh->running = TRUE;
+      refresh->start_time = g_get_monotonic_time ();
+      self->n_running_refreshes++;
+    }
+
+  update_synchronizing (self);
+
+  GCAL_EXIT;
+}
+
 static void
 remove_source (GcalManager  *self,
                ESource      *source)
 {
+  RefreshSource *refresh;
+
   g_autoptr (GcalCalendar) calendar = NULL;
   guint position;
 
@@ -115,6 +539,20 @@ remove_source (GcalManager  *self,
   g_return_if_fail (GCAL_IS_MANAGER (self));
   g_return_if_fail (E_IS_SOURCE (source));
 
+  if (g_queue_remove (&self->deferred_sources, source))
+    g_object_unref (source);
+
+  refresh = g_hash_table_lookup (self->refresh_sources, e_source_get_uid (source));
+
+  if (refresh)
+    {
+      if (refresh->queued)
+        g_queue_remove (&self->refresh_queue, refresh);
+
+      g_hash_table_remove (self->refresh_sources, e_source_get_uid (source));
+      update_synchronizing (self);
+    }
+
   calendar = g_hash_table_lookup (self->clients, source);
 
   if (!calendar)
@@ -127,6 +565,7 @@ remove_source (GcalManager  *self,
   g_object_ref (calendar);
 
   gcal_timeline_remove_calendar (self->timeline, calendar);
+  gcal_time_zone_cache_remove_calendar (calendar);
   g_hash_table_remove (self->clients, source);
 
   g_list_store_find (self->calendars_model, calendar, &position);
@@ -160,22 +599,15 @@ on_collection_source_refreshed (GObject      *source_object,
                                 GAsyncResult *result,
                                 gpointer      user_data)
 {
-  GcalManager *self = GCAL_MANAGER (user_data);
-  GError *error = NULL;
+  RefreshData *data = user_data;
+  g_autoptr (GError) error = NULL;
 
   GCAL_ENTRY;
 
-  if (!e_source_registry_refresh_backend_finish (E_SOURCE_REGISTRY (source_object), result, &error))
-    {
-      /* FIXME: do something when there was some error */
-      if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
-        g_warning ("Error refreshing collection source backend: %s", error->message);
-      g_clear_error (&error);
-    }
+  e_source_registry_refresh_backend_finish (E_SOURCE_REGISTRY (source_object), result, &error);
+  finish_refresh (data->manager, data->source_uid, error);
 
-  self->clients_synchronizing--;
-  if (self->clients_synchronizing == 0)
-    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SYNCHRONIZING]);
+  refresh_data_free (data);
 
   GCAL_EXIT;
 }
@@ -185,26 +617,15 @@ on_client_refreshed (GObject      *source_object,
                      GAsyncResult *result,
                      gpointer      user_data)
 {
-  GcalManager *self = GCAL_MANAGER (user_data);
-  GError *error = NULL;
+  RefreshData *data = user_data;
+  g_autoptr (GError) error = NULL;
 
   GCAL_ENTRY;
 
-  if (e_client_refresh_finish (E_CLIENT (source_object), result, &error))
-    {
-      ESource *source = e_client_get_source (E_CLIENT (source_object));
-      /* FIXME: add notification to UI */
-      g_debug ("Client of source: %s refreshed successfully", e_source_get_uid (source));
-    }
-  else
-    {
-      /* FIXME: do something when there was some error */
-      g_warning ("Error synchronizing client");
-    }
+  e_client_refresh_finish (E_CLIENT (source_object), result, &error);
+  finish_refresh (data->manager, data->source_uid, error);
 
-  self->clients_synchronizing--;
-  if (self->clients_synchronizing == 0)
-    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SYNCHRONIZING]);
+  refresh_data_free (data);
 
   GCAL_EXIT;
 }
@@ -238,6 +659,64 @@ on_calendar_name_changed_cb (GcalCalendar *calendar,
   g_list_store_sort (self->calendars_model, sort_calendar_by_name_cb, NULL);
 }
 
+static void
+schedule_deferred_startup (GcalManager *self,
+                           gboolean     immediately)
+{
+  if (self->deferred_startup_done)
+    return;
+
+  g_clear_handle_id (&self->deferred_startup_id, g_source_remove);
+
+  if (immediately)
+    self->deferred_startup_id = g_idle_add_full (G_PRIORITY_LOW, run_deferred_startup_cb, self, NULL);
+  else
+    self->deferred_startup_id = g_timeout_add_seconds (DEFERRED_STARTUP_TIMEOUT_SECONDS, run_deferred_startup_cb, self);
+}
+
+static void
+maybe_advance_startup (GcalManager *self)
+{
+  if (self->n_visible_loads == 0 && !self->visible_calendars_loaded)
+    {
+      self->visible_calendars_loaded = TRUE;
+      gcal_startup_profile_mark (GCAL_STARTUP_STAGE_VISIBLE_CALENDARS_LOADED);
+      schedule_deferred_startup (self, TRUE);
+    }
+
+  if (self->deferred_startup_done && self->n_startup_loads == 0)
+    {
+      gcal_startup_profile_mark (GCAL_STARTUP_STAGE_ALL_CALENDARS_LOADED);
+
+      /* Calendars loaded from now on don't need placeholders */
+      gcal_timeline_set_snapshot (self->timeline, NULL);
+    }
+}
+
+static void
+finish_load (GcalManager *self,
+             LoadStage    stage)
+{
+  switch (stage)
+    {
+    case LOAD_STAGE_REGULAR:
+      return;
+
+    case LOAD_STAGE_STARTUP_VISIBLE:
+      g_assert (self->n_visible_loads > 0);
+      self->n_visible_loads--;
+      break;
+
+    case LOAD_STAGE_STARTUP_DEFERRED:
+      break;
+    }
+
+  g_assert (self->n_startup_loads > 0);
+  self->n_startup_loads--;
+
+  maybe_advance_startup (self);
+}
+
 static void
 on_calendar_created_cb (GObject      *source_object,
                         GAsyncResult *result,
@@ -246,22 +725,30 @@ on_calendar_created_cb (GObject      *source_object,
   g_autoptr (ESource) default_source = NULL;
   g_autoptr (GError) error = NULL;
   ESourceOffline *offline_extension;
+  LoadSourceData *data;
   GcalCalendar *calendar;
   GcalManager *self;
   ECalClient *client;
+  LoadStage stage;
   ESource *source;
   gboolean visible;
 
-  self = GCAL_MANAGER (user_data);
+  data = user_data;
+  self = data->manager;
+  stage = data->stage;
+  g_clear_pointer (&data, g_free);
+
   calendar = gcal_calendar_new_finish (result, &error);
 
   if (error)
     {
-      if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED) &&
-          !g_error_matches (error, GCAL_CALENDAR_ERROR, GCAL_CALENDAR_ERROR_NOT_CALENDAR))
-        {
-          g_warning ("Failed to open/connect to calendar: %s", error->message);
-        }
+      if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        return;
+
+      if (!g_error_matches (error, GCAL_CALENDAR_ERROR, GCAL_CALENDAR_ERROR_NOT_CALENDAR))
+        g_warning ("Failed to open/connect to calendar: %s", error->message);
+
+      finish_load (self, stage);
       return;
     }
 
@@ -282,10 +769,8 @@ on_calendar_created_cb (GObject      *source_object,
   /* refresh client when it's added */
   if (visible && e_client_check_refresh_supported (E_CLIENT (client)))
     {
-      e_client_refresh (E_CLIENT (client), NULL, on_client_refreshed, user_data);
-
-      self->clients_synchronizing++;
-      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SYNCHRONIZING]);
+      queue_refresh (self, e_source_get_uid (source), FALSE, FALSE);
+      run_refreshes (self);
     }
 
   /* Cache all the online calendars, so the user can see them offline */
@@ -303,13 +788,17 @@ on_calendar_created_cb (GObject      *source_object,
   default_source = e_source_registry_ref_default_calendar (self->source_registry);
   if (default_source == source)
     g_object_notify (G_OBJECT (self->source_registry), "default-calendar");
+
+  finish_load (self, stage);
 }
 
 static void
-load_source (GcalManager *self,
-             ESource     *source)
+load_source_full (GcalManager *self,
+                  ESource     *source,
+                  LoadStage    stage)
 {
   g_autoptr (ESource) parent = NULL;
+  LoadSourceData *data;
 
   GCAL_ENTRY;
 
@@ -321,13 +810,30 @@ load_source (GcalManager *self,
       return;
     }
 
+  if (stage == LOAD_STAGE_STARTUP_VISIBLE)
+    self->n_visible_loads++;
+
+  if (stage != LOAD_STAGE_REGULAR)
+    self->n_startup_loads++;
+
+  data = g_new0 (LoadSourceData, 1);
+  data->manager = self;
+  data->stage = stage;
+
   parent = e_source_registry_ref_source (self->source_registry, e_source_get_parent (source));
 
-  gcal_calendar_new (source, parent, self->async_ops, on_calendar_created_cb, self);
+  gcal_calendar_new (source, parent, self->async_ops, on_calendar_created_cb, data);
 
   GCAL_EXIT;
 }
 
+static void
+load_source (GcalManager *self,
+             ESource     *source)
+{
+  load_source_full (self, source, LOAD_STAGE_REGULAR);
+}
+
 static gboolean
 transform_e_source_to_gcal_calendar_cb (GBinding     *binding,
                                         const GValue *from_value,
@@ -368,11 +874,22 @@ on_event_created (GObject      *source_object,
     {
       /* Some error */
       g_warning ("Error creating object: %s", error->message);
+      resolve_event_change (data, error);
       g_error_free (error);
     }
   else
     {
+      /* The backend may assign another uid to the new event */
+      if (data->change_id != 0 && new_uid && g_strcmp0 (new_uid, e_cal_component_get_uid (gcal_event_get_component (data->event))) != 0)
+        {
+          g_autofree gchar *event_id = NULL;
+
+          event_id = g_strdup_printf ("%s:%s", gcal_calendar_get_id (gcal_event_get_calendar (data->event)), new_uid);
+          gcal_timeline_set_pending_change_event_id (data->manager->timeline, data->change_id, event_id);
+        }
+
       g_object_ref (data->event);
+      resolve_event_change (data, NULL);
       gcal_manager_set_default_calendar (data->manager, gcal_event_get_calendar (data->event));
       g_debug ("Event: %s created successfully", new_uid);
     }
@@ -387,10 +904,10 @@ on_event_created (GObject      *source_object,
  * on_component_updated:
  * @source_object: #ECalClient source
  * @result: result of the operation
- * @user_data: manager instance
+ * @user_data: an #AsyncOpsData
  *
- * Called when an component is modified. Currently, it only checks for
- * error, but a more sophisticated implementation will come in no time.
+ * Called when an component is modified. Resolves the pending
+ * change of the event, if any.
  *
  **/
 static void
@@ -398,6 +915,7 @@ on_event_updated (GObject      *source_object,
                   GAsyncResult *result,
                   gpointer      user_data)
 {
+  AsyncOpsData *data = user_data;
   GError *error = NULL;
 
   GCAL_ENTRY;
@@ -407,9 +925,12 @@ on_event_updated (GObject      *source_object,
                                            &error))
     {
       g_warning ("Error updating component: %s", error->message);
-      g_error_free (error);
     }
-  g_object_unref (E_CAL_COMPONENT (user_data));
+
+  resolve_event_change (data, error);
+
+  g_clear_error (&error);
+  free_async_ops_data (data);
 
   GCAL_EXIT;
 }
@@ -418,10 +939,10 @@ on_event_updated (GObject      *source_object,
  * on_event_removed:
  * @source_object: #ECalClient source
  * @result: result of the operation
- * @user_data: an #ECalComponent
+ * @user_data: an #AsyncOpsData
  *
- * Called when an component is removed. Currently, it only checks for
- * error, but a more sophisticated implementation will come in no time.*
+ * Called when an component is removed. Resolves the pending
+ * change of the event, if any.
  *
  **/
 static void
@@ -429,31 +950,247 @@ on_event_removed (GObject      *source_object,
                   GAsyncResult *result,
                   gpointer      user_data)
 {
+  AsyncOpsData *data;
   ECalClient *client;
-  GcalEvent *event;
   GError *error;
 
   GCAL_ENTRY;
 
   client = E_CAL_CLIENT (source_object);
-  event = user_data;
+  data = user_data;
   error = NULL;
 
   e_cal_client_remove_object_finish (client, result, &error);
 
+  if (error)
+    g_warning ("Error removing event: %s", error->message);
+
+  resolve_event_change (data, error);
+
+  g_clear_error (&error);
+  free_async_ops_data (data);
+
+  GCAL_EXIT;
+}
+
+static void
+batch_data_free (BatchData *data)
+{
+  g_clear_pointer (&data->batch, gcal_event_batch_free);
+  g_clear_object (&data->destination);
+  g_free (data);
+}
+
+static void
+remove_chunk_objects (GTask                 *task,
+                      GcalEventBatch        *batch,
+                      GcalRecurrenceModType  mod,
+                      GCancellable          *cancellable)
+{
+  GSList *ids = gcal_event_batch_get_chunk_ids (batch, mod);
+
+  e_cal_client_remove_objects (gcal_calendar_get_client (gcal_event_batch_get_chunk_calendar (batch)),
+                               ids,
+                               (ECalObjModType) mod,
+                               E_CAL_OPERATION_FLAG_NONE,
+                               cancellable,
+                               on_batch_objects_removed_cb,
+                               g_object_ref (task));
+
+  g_slist_free_full (ids, (GDestroyNotify) e_cal_component_id_free);
+}
+
+static void
+run_batch_chunk (GTask *task)
+{
+  GcalCalendar *calendar;
+  BatchData *data;
+  GSList *components;
+
+  GCAL_ENTRY;
+
+  if (g_task_return_error_if_cancelled (task))
+    GCAL_RETURN ();
+
+  data = g_task_get_task_data (task);
+
+  if (!gcal_event_batch_next_chunk (data->batch))
+    {
+      g_task_return_boolean (task, TRUE);
+      GCAL_RETURN ();
+    }
+
+  calendar = gcal_event_batch_get_chunk_calendar (data->batch);
+
+  GCAL_TRACE_MSG ("Running batch chunk of %u events in calendar '%s'",
+                  gcal_event_batch_get_chunk_n_events (data->batch),
+                  gcal_calendar_get_name (calendar));
+
+  switch (data->operation)
+    {
+    case BATCH_CREATE:
+      components = gcal_event_batch_get_chunk_components (data->batch);
+      e_cal_client_create_objects (gcal_calendar_get_client (calendar),
+                                   components,
+                                   E_CAL_OPERATION_FLAG_NONE,
+                                   g_task_get_cancellable (task),
+                                   on_batch_objects_created_cb,
+                                   g_object_ref (task));
+      g_slist_free (components);
+      break;
+
+    case BATCH_MOVE:
+      /* The events are only removed from their calendars once the copies exist */
+      components = gcal_event_batch_get_chunk_components (data->batch);
+      e_cal_client_create_objects (gcal_calendar_get_client (data->destination),
+                                   components,
+                                   E_CAL_OPERATION_FLAG_NONE,
+                                   g_task_get_cancellable (task),
+                                   on_batch_objects_created_cb,
+                                   g_object_ref (task));
+      g_slist_free (components);
+      break;
+
+    case BATCH_UPDATE:
+      components = gcal_event_batch_get_chunk_components (data->batch);
+      e_cal_client_modify_objects (gcal_calendar_get_client (calendar),
+                                   components,
+                                   (ECalObjModType) data->mod,
+                                   E_CAL_OPERATION_FLAG_NONE,
+                                   g_task_get_cancellable (task),
+                                   on_batch_objects_modified_cb,
+                                   g_object_ref (task));
+      g_slist_free (components);
+      break;
+
+    case BATCH_REMOVE:
+      remove_chunk_objects (task, data->batch, data->mod, g_task_get_cancellable (task));
+      break;
+
+    default:
+      g_assert_not_reached ();
+    }
+
+  GCAL_EXIT;
+}
+
+static void
+complete_batch_chunk (GTask *task)
+{
+  BatchData *data = g_task_get_task_data (task);
+
+  data->n_completed += gcal_event_batch_get_chunk_n_events (data->batch);
+
+  if (data->progress_func)
+    data->progress_func (data->n_completed, gcal_event_batch_get_n_events (data->batch), data->progress_data);
+
+  run_batch_chunk (task);
+}
+
+static void
+on_batch_objects_created_cb (GObject      *source_object,
+                             GAsyncResult *result,
+                             gpointer      user_data)
+{
+  g_autoptr (GTask) task = user_data;
+  g_autoptr (GError) error = NULL;
+  GSList *uids = NULL;
+  BatchData *data;
+
+  GCAL_ENTRY;
+
+  e_cal_client_create_objects_finish (E_CAL_CLIENT (source_object), result, &uids, &error);
+  g_slist_free_full (uids, g_free);
+
   if (error)
     {
-      /* FIXME: Notify the user somehow */
-      g_warning ("Error removing event: %s", error->message);
-      g_error_free (error);
+      g_task_return_error (task, g_steal_pointer (&error));
+      GCAL_RETURN ();
+    }
+
+  data = g_task_get_task_data (task);
+
+  /*
+   * The copies exist now, so the originals must be removed even if the
+   * batch was cancelled meanwhile; otherwise every event would end up
+   * duplicated. Cancelling stops the batch before the next chunk.
+   */
+  if (data->operation == BATCH_MOVE)
+    remove_chunk_objects (task, data->batch, data->mod, NULL);
+  else
+    complete_batch_chunk (task);
+
+  GCAL_EXIT;
+}
+
+static void
+on_batch_objects_modified_cb (GObject      *source_object,
+                              GAsyncResult *result,
+                              gpointer      user_data)
+{
+  g_autoptr (GTask) task = user_data;
+  g_autoptr (GError) error = NULL;
+
+  GCAL_ENTRY;
+
+  if (!e_cal_client_modify_objects_finish (E_CAL_CLIENT (source_object), result, &error))
+    {
+      g_task_return_error (task, g_steal_pointer (&error));
       GCAL_RETURN ();
     }
 
-  g_object_unref (event);
+  complete_batch_chunk (task);
 
   GCAL_EXIT;
 }
 
+static void
+on_batch_objects_removed_cb (GObject      *source_object,
+                             GAsyncResult *result,
+                             gpointer      user_data)
+{
+  g_autoptr (GTask) task = user_data;
+  g_autoptr (GError) error = NULL;
+
+  GCAL_ENTRY;
+
+  if (!e_cal_client_remove_objects_finish (E_CAL_CLIENT (source_object), result, &error))
+    {
+      g_task_return_error (task, g_steal_pointer (&error));
+      GCAL_RETURN ();
+    }
+
+  complete_batch_chunk (task);
+
+  GCAL_EXIT;
+}
+
+static void
+run_batch (GcalManager             *self,
+           BatchData               *data,
+           GPtrArray               *events,
+           GCancellable            *cancellable,
+           GcalManagerProgressFunc  progress_func,
+           gpointer                 progress_data,
+           gpointer                 source_tag,
+           GAsyncReadyCallback      callback,
+           gpointer                 user_data)
+{
+  g_autoptr (GTask) task = NULL;
+
+  data->progress_func = progress_func;
+  data->progress_data = progress_data;
+  data->batch = gcal_event_batch_new (events, data->mod, data->destination);
+
+  task = g_task_new (self, cancellable, callback, user_data);
+  g_task_set_source_tag (task, source_tag);
+  g_task_set_task_data (task, data, (GDestroyNotify) batch_data_free);
+
+  GCAL_TRACE_MSG ("Starting batch of %u events", gcal_event_batch_get_n_events (data->batch));
+
+  run_batch_chunk (task);
+}
+
 static void
 show_source_error (const gchar  *where,
                    const gchar  *what,
@@ -596,6 +1333,169 @@ source_get_last_credentials_required_arguments_cb (GObject      *source_object,
   GCAL_EXIT;
 }
 
+static void
+setup_credentials_prompter (GcalManager *self)
+{
+  ESourceCredentialsProvider *credentials_provider;
+  g_autolist (ESource) sources = NULL;
+  g_autolist (ESource) calendar_sources = NULL;
+
+  GCAL_ENTRY;
+
+  self->credentials_prompter = e_credentials_prompter_new (self->source_registry);
+
+  /* First disable credentials prompt for all but calendar sources... */
+  sources = e_source_registry_list_sources (self->source_registry, NULL);
+
+  for (GList *l = sources; l != NULL; l = g_list_next (l))
+    {
+      ESource *source = E_SOURCE (l->data);
+
+      /* Mark for skip also currently disabled sources */
+      if (!e_source_has_extension (source, E_SOURCE_EXTENSION_CALENDAR) &&
+          !e_source_has_extension (source, E_SOURCE_EXTENSION_COLLECTION))
+        {
+          e_credentials_prompter_set_auto_prompt_disabled_for (self->credentials_prompter, source, TRUE);
+        }
+      else
+        {
+          e_source_get_last_credentials_required_arguments (source,
+                                                            NULL,
+                                                            source_get_last_credentials_required_arguments_cb,
+                                                            self);
+        }
+    }
+
+  credentials_provider = e_credentials_prompter_get_provider (self->credentials_prompter);
+
+  /* ...then enable credentials prompt for credential source of the calendar sources,
+     which can be a collection source.  */
+  calendar_sources = e_source_registry_list_sources (self->source_registry, E_SOURCE_EXTENSION_CALENDAR);
+
+  for (GList *l = calendar_sources; l != NULL; l = g_list_next (l))
+    {
+      ESource *source, *cred_source;
+
+      source = l->data;
+      cred_source = e_source_credentials_provider_ref_credentials_source (credentials_provider, source);
+
+      if (cred_source && !e_source_equal (source, cred_source))
+        {
+          e_credentials_prompter_set_auto_prompt_disabled_for (self->credentials_prompter, cred_source, FALSE);
+
+          /* Only consider SSL errors */
+          if (e_source_get_connection_status (cred_source) != E_SOURCE_CONNECTION_STATUS_SSL_FAILED)
+            {
+              g_clear_object (&cred_source);
+              continue;
+            }
+
+          e_source_get_last_credentials_required_arguments (cred_source,
+                                                            NULL,
+                                                            source_get_last_credentials_required_arguments_cb,
+                                                            self);
+        }
+
+      g_clear_object (&cred_source);
+    }
+
+  /* The eds_credentials_prompter responses to REQUIRED and REJECTED reasons,
+     the SSL_FAILED should be handled elsewhere. */
+  g_signal_connect_object (self->source_registry, "credentials-required", G_CALLBACK (source_credentials_required_cb), self, 0);
+
+  e_credentials_prompter_process_awaiting_credentials (self->credentials_prompter);
+
+  GCAL_EXIT;
+}
+
+static gboolean
+run_deferred_startup_cb (gpointer user_data)
+{
+  GcalManager *self = GCAL_MANAGER (user_data);
+  ESource *source;
+
+  GCAL_ENTRY;
+
+  self->deferred_startup_id = 0;
+  self->deferred_startup_done = TRUE;
+
+  GCAL_TRACE_MSG ("Running deferred startup, %u visible calendars still loading", self->n_visible_loads);
+
+  setup_credentials_prompter (self);
+
+  while ((source = g_queue_pop_head (&self->deferred_sources)) != NULL)
+    {
+      load_source_full (self, source, LOAD_STAGE_STARTUP_DEFERRED);
+      g_object_unref (source);
+    }
+
+  maybe_advance_startup (self);
+
+  GCAL_RETURN (G_SOURCE_REMOVE);
+}
+
+static void
+on_source_registry_created_cb (GObject      *source_object,
+                               GAsyncResult *result,
+                               gpointer      user_data)
+{
+  g_autoptr (GcalManager) self = GCAL_MANAGER (user_data);
+  g_autolist (ESource) sources = NULL;
+  g_autoptr (GError) error = NULL;
+
+  GCAL_ENTRY;
+
+  self->source_registry = e_source_registry_new_finish (result, &error);
+
+  if (!self->source_registry)
+    {
+      g_warning ("Failed to access calendar configuration: %s", error->message);
+      GCAL_EXIT;
+      return;
+    }
+
+  gcal_startup_profile_mark (GCAL_STARTUP_STAGE_REGISTRY_CONNECTED);
+
+  g_object_bind_property_full (self->source_registry,
+                               "default-calendar",
+                               self,
+                               "default-calendar",
+                               G_BINDING_DEFAULT,
+                               transform_e_source_to_gcal_calendar_cb,
+                               NULL,
+                               self,
+                               NULL);
+
+  g_signal_connect_object (self->source_registry, "source-added", G_CALLBACK (load_source), self, G_CONNECT_SWAPPED);
+  g_signal_connect_object (self->source_registry, "source-removed", G_CALLBACK (remove_source), self, G_CONNECT_SWAPPED);
+  g_signal_connect_object (self->source_registry, "source-changed", G_CALLBACK (source_changed), self, G_CONNECT_SWAPPED);
+
+  /* Open the visible calendars right away, and defer the hidden ones */
+  sources = e_source_registry_list_enabled (self->source_registry, E_SOURCE_EXTENSION_CALENDAR);
+
+  for (GList *l = sources; l != NULL; l = l->next)
+    {
+      ESource *source = l->data;
+      ESourceSelectable *selectable;
+
+      selectable = e_source_get_extension (source, E_SOURCE_EXTENSION_CALENDAR);
+
+      if (e_source_selectable_get_selected (selectable))
+        load_source_full (self, source, LOAD_STAGE_STARTUP_VISIBLE);
+      else
+        g_queue_push_tail (&self->deferred_sources, g_object_ref (source));
+    }
+
+  GCAL_TRACE_MSG ("Loading %u visible calendars, deferring %u hidden calendars",
+                  self->n_visible_loads,
+                  g_queue_get_length (&self->deferred_sources));
+
+  schedule_deferred_startup (self, FALSE);
+  maybe_advance_startup (self);
+
+  GCAL_EXIT;
+}
+
 static void
 gcal_manager_finalize (GObject *object)
 {
@@ -603,6 +1503,12 @@ gcal_manager_finalize (GObject *object)
 
   GCAL_ENTRY;
 
+  g_clear_handle_id (&self->deferred_startup_id, g_source_remove);
+  g_queue_clear_full (&self->deferred_sources, g_object_unref);
+
+  g_queue_clear (&self->refresh_queue);
+  g_clear_pointer (&self->refresh_sources, g_hash_table_destroy);
+
   g_clear_object (&self->timeline);
 
   g_clear_object (&self->calendars_model);
@@ -629,6 +1535,10 @@ gcal_manager_set_property (GObject      *object,
       gcal_manager_set_default_calendar (self, g_value_get_object (value));
       break;
 
+    case PROP_MAX_CONCURRENT_REFRESHES:
+      gcal_manager_set_max_concurrent_refreshes (self, g_value_get_uint (value));
+      break;
+
     case PROP_SYNCHRONIZING:
       g_assert_not_reached ();
       break;
@@ -656,8 +1566,12 @@ gcal_manager_get_property (GObject    *object,
       g_value_set_object (value, gcal_manager_get_default_calendar (self));
       break;
 
+    case PROP_MAX_CONCURRENT_REFRESHES:
+      g_value_set_uint (value, self->max_concurrent_refreshes);
+      break;
+
     case PROP_SYNCHRONIZING:
-      g_value_set_boolean (value, self->clients_synchronizing != 0);
+      g_value_set_boolean (value, self->synchronizing);
       break;
 
     default:
@@ -687,6 +1601,19 @@ gcal_manager_class_init (GcalManagerClass *klass)
                                                            GCAL_TYPE_CALENDAR,
                                                            G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * GcalManager:max-concurrent-refreshes:
+   *
+   * The maximum number of sources that are refreshed at the same time.
+   */
+  properties[PROP_MAX_CONCURRENT_REFRESHES] = g_param_spec_uint ("max-concurrent-refreshes",
+                                                                 "Maximum concurrent refreshes",
+                                                                 "The maximum number of sources refreshed at the same time",
+                                                                 1,
+                                                                 G_MAXUINT,
+                                                                 DEFAULT_MAX_CONCURRENT_REFRESHES,
+                                                                 G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
   /**
    * GcalManager:refreshing:
    *
@@ -724,12 +1651,35 @@ gcal_manager_class_init (GcalManagerClass *klass)
                                             G_TYPE_NONE,
                                             1,
                                             GCAL_TYPE_CALENDAR);
+
+  /**
+   * GcalManager::event-change-failed:
+   * @manager: a #GcalManager
+   * @event: the #GcalEvent that failed to be saved
+   * @error: the #GError
+   *
+   * Emitted when creating, updating or removing @event failed. If
+   * the change was already shown, it is rolled back at this point.
+   */
+  signals[EVENT_CHANGE_FAILED] = g_signal_new ("event-change-failed",
+                                               GCAL_TYPE_MANAGER,
+                                               G_SIGNAL_RUN_LAST,
+                                               0, NULL, NULL, NULL,
+                                               G_TYPE_NONE,
+                                               2,
+                                               GCAL_TYPE_EVENT,
+                                               G_TYPE_ERROR);
 }
 
 static void
 gcal_manager_init (GcalManager *self)
 {
   self->calendars_model = g_list_store_new (GCAL_TYPE_CALENDAR);
+  g_queue_init (&self->deferred_sources);
+
+  self->refresh_sources = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) refresh_source_free);
+  self->max_concurrent_refreshes = DEFAULT_MAX_CONCURRENT_REFRESHES;
+  g_queue_init (&self->refresh_queue);
 }
 
 /* Public API */
@@ -764,6 +1714,10 @@ gcal_manager_get_source (GcalManager *self,
 {
   g_return_val_if_fail (GCAL_IS_MANAGER (self), NULL);
 
+  /* The registry is created asynchronously at startup */
+  if (!self->source_registry)
+    return NULL;
+
   return e_source_registry_ref_source (self->source_registry, uid);
 }
 
@@ -805,6 +1759,9 @@ gcal_manager_get_default_calendar (GcalManager *self)
 
   g_return_val_if_fail (GCAL_IS_MANAGER (self), NULL);
 
+  if (!self->source_registry)
+    return NULL;
+
   default_source = e_source_registry_ref_default_calendar (self->source_registry);
   return g_hash_table_lookup (self->clients, default_source);
 }
@@ -822,7 +1779,7 @@ gcal_manager_set_default_calendar (GcalManager  *self,
 {
   g_return_if_fail (GCAL_IS_MANAGER (self));
 
-  if (calendar == gcal_manager_get_default_calendar (self))
+  if (!self->source_registry || calendar == gcal_manager_get_default_calendar (self))
     return;
 
   e_source_registry_set_default_calendar (self->source_registry,
@@ -872,6 +1829,9 @@ gcal_manager_add_source (GcalManager *self,
 
   g_return_val_if_fail (GCAL_IS_MANAGER (self), NULL);
 
+  if (!self->source_registry)
+    GCAL_RETURN (NULL);
+
   source = e_source_new (NULL, NULL, NULL);
   extension = E_SOURCE_CALENDAR (e_source_get_extension (source, E_SOURCE_EXTENSION_CALENDAR));
 
@@ -919,6 +1879,9 @@ gcal_manager_save_source (GcalManager *self,
   g_return_if_fail (GCAL_IS_MANAGER (self));
   g_return_if_fail (E_IS_SOURCE (source));
 
+  if (!self->source_registry)
+    GCAL_RETURN ();
+
   e_source_registry_commit_source_sync (self->source_registry, source, NULL, &error);
 
   if (error)
@@ -937,57 +1900,50 @@ gcal_manager_save_source (GcalManager *self,
  *
  * Forces a full refresh and synchronization of all available
  * calendars.
+ *
+ * Sources are refreshed at most #GcalManager:max-concurrent-refreshes
+ * at a time, visible calendars first. Since this is only called when
+ * the user asks for it, sources that failed to refresh recently are
+ * refreshed as well, without waiting for their automatic retry.
  */
 void
 gcal_manager_refresh (GcalManager *self)
 {
   g_autolist(ESource) collections = NULL;
-  g_autoptr(GList) clients = NULL;
+  GHashTableIter iter;
+  GcalCalendar *calendar;
+  ESource *source;
 
   GCAL_ENTRY;
 
   g_return_if_fail (GCAL_IS_MANAGER (self));
 
+  if (!self->source_registry)
+    GCAL_RETURN ();
+
   /* First, refresh collection sources to get latest calendar list */
   collections = e_source_registry_list_sources (self->source_registry, E_SOURCE_EXTENSION_COLLECTION);
   for (GList *l = collections; l != NULL; l = l->next)
     {
-      ESource *source = E_SOURCE (l->data);
+      source = E_SOURCE (l->data);
 
       if (!e_source_registry_check_enabled (self->source_registry, source))
         continue;
 
-      self->clients_synchronizing++;
-
-      e_source_registry_refresh_backend (self->source_registry,
-                                         e_source_get_uid (source),
-                                         NULL,
-                                         on_collection_source_refreshed,
-                                         self);
+      queue_refresh (self, e_source_get_uid (source), TRUE, TRUE);
     }
 
-  clients = g_hash_table_get_values (self->clients);
-
   /* refresh clients */
-  for (GList *l = clients; l != NULL; l = l->next)
+  g_hash_table_iter_init (&iter, self->clients);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &source, (gpointer *) &calendar))
     {
-      GcalCalendar *calendar = l->data;
-      EClient *client;
-
-      client = E_CLIENT (gcal_calendar_get_client (calendar));
-
-      if (!e_client_check_refresh_supported (client))
+      if (!e_client_check_refresh_supported (E_CLIENT (gcal_calendar_get_client (calendar))))
         continue;
 
-      self->clients_synchronizing++;
-
-      e_client_refresh (client,
-                        NULL,
-                        on_client_refreshed,
-                        self);
+      queue_refresh (self, e_source_get_uid (source), FALSE, TRUE);
     }
 
-  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SYNCHRONIZING]);
+  run_refreshes (self);
 
   GCAL_EXIT;
 }
@@ -1007,6 +1963,7 @@ gcal_manager_create_event (GcalManager *self,
   ECalComponent *component;
   GcalCalendar *calendar;
   AsyncOpsData *data;
+  guint change_id;
 
   GCAL_ENTRY;
 
@@ -1015,12 +1972,20 @@ gcal_manager_create_event (GcalManager *self,
 
   component = gcal_event_get_component (event);
   calendar = gcal_event_get_calendar (event);
+  change_id = 0;
 
   new_event_icalcomp = e_cal_component_get_icalcomponent (component);
 
-  data = g_new0 (AsyncOpsData, 1);
-  data->event = g_object_ref (event);
-  data->manager = self;
+  /* Show the new event right away */
+  if (!gcal_event_has_recurrence (event))
+    {
+      g_autoptr (GcalEvent) pending_event = gcal_event_new_from_event (event);
+
+      if (pending_event)
+        change_id = gcal_timeline_add_pending_change (self->timeline, calendar, gcal_event_get_uid (event), pending_event);
+    }
+
+  data = async_ops_data_new (self, event, change_id);
 
   e_cal_client_create_object (gcal_calendar_get_client (calendar),
                               new_event_icalcomp,
@@ -1039,6 +2004,9 @@ gcal_manager_create_event (GcalManager *self,
  * @mod: an #GcalRecurrenceModType
  *
  * Saves all changes made to @event persistently.
+ *
+ * The changes are shown right away, and rolled back if saving
+ * them fails.
  */
 void
 gcal_manager_update_event (GcalManager           *self,
@@ -1047,6 +2015,7 @@ gcal_manager_update_event (GcalManager           *self,
 {
   ECalComponent *component;
   GcalCalendar *calendar;
+  guint change_id;
 
   GCAL_ENTRY;
 
@@ -1055,6 +2024,15 @@ gcal_manager_update_event (GcalManager           *self,
 
   calendar = gcal_event_get_calendar (event);
   component = gcal_event_get_component (event);
+  change_id = 0;
+
+  if (can_apply_optimistically (event, mod))
+    {
+      g_autoptr (GcalEvent) pending_event = gcal_event_new_from_event (event);
+
+      if (pending_event)
+        change_id = gcal_timeline_add_pending_change (self->timeline, calendar, gcal_event_get_uid (event), pending_event);
+    }
 
   e_cal_client_modify_object (gcal_calendar_get_client (calendar),
                               e_cal_component_get_icalcomponent (component),
@@ -1062,7 +2040,7 @@ gcal_manager_update_event (GcalManager           *self,
                               E_CAL_OPERATION_FLAG_NONE,
                               NULL,
                               on_event_updated,
-                              g_object_ref (component));
+                              async_ops_data_new (self, event, change_id));
 
   GCAL_EXIT;
 }
@@ -1073,7 +2051,8 @@ gcal_manager_update_event (GcalManager           *self,
  * @event: a #GcalEvent
  * @mod: an #GcalRecurrenceModType
  *
- * Deletes @event.
+ * Deletes @event. The event is hidden right away, and shown
+ * again if removing it fails.
  */
 void
 gcal_manager_remove_event (GcalManager           *self,
@@ -1082,6 +2061,7 @@ gcal_manager_remove_event (GcalManager           *self,
 {
   ECalComponent *component;
   GcalCalendar *calendar;
+  guint change_id;
   gchar *rid;
   const gchar *uid;
 
@@ -1092,8 +2072,12 @@ gcal_manager_remove_event (GcalManager           *self,
 
   component = gcal_event_get_component (event);
   calendar = gcal_event_get_calendar (event);
+  change_id = 0;
   rid = NULL;
 
+  if (can_apply_optimistically (event, mod))
+    change_id = gcal_timeline_add_pending_change (self->timeline, calendar, gcal_event_get_uid (event), NULL);
+
   uid = e_cal_component_get_uid (component);
 
   if (gcal_event_has_recurrence (event))
@@ -1106,7 +2090,7 @@ gcal_manager_remove_event (GcalManager           *self,
                               E_CAL_OPERATION_FLAG_NONE,
                               self->async_ops,
                               on_event_removed,
-                              g_object_ref (event));
+                              async_ops_data_new (self, event, change_id));
 
   g_free (rid);
 
@@ -1210,118 +2194,428 @@ gcal_manager_get_synchronizing (GcalManager *self)
 {
   g_return_val_if_fail (GCAL_IS_MANAGER (self), FALSE);
 
-  return self->clients_synchronizing != 0;
+  return self->synchronizing;
+}
+
+/**
+ * gcal_manager_get_max_concurrent_refreshes:
+ * @self: a #GcalManager
+ *
+ * Retrieves the maximum number of sources that are refreshed
+ * at the same time.
+ *
+ * Returns: the maximum number of concurrent refreshes
+ */
+guint
+gcal_manager_get_max_concurrent_refreshes (GcalManager *self)
+{
+  g_return_val_if_fail (GCAL_IS_MANAGER (self), 0);
+
+  return self->max_concurrent_refreshes;
+}
+
+/**
+ * gcal_manager_set_max_concurrent_refreshes:
+ * @self: a #GcalManager
+ * @max_concurrent_refreshes: the maximum number of concurrent refreshes
+ *
+ * Sets the maximum number of sources that are refreshed at the same
+ * time. Refreshes that are already running are not affected.
+ */
+void
+gcal_manager_set_max_concurrent_refreshes (GcalManager *self,
+                                           guint        max_concurrent_refreshes)
+{
+  g_return_if_fail (GCAL_IS_MANAGER (self));
+  g_return_if_fail (max_concurrent_refreshes > 0);
+
+  if (self->max_concurrent_refreshes == max_concurrent_refreshes)
+    return;
+
+  self->max_concurrent_refreshes = max_concurrent_refreshes;
+
+  if (self->source_registry)
+    run_refreshes (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_MAX_CONCURRENT_REFRESHES]);
+}
+
+/**
+ * gcal_manager_get_refresh_info:
+ * @self: a #GcalManager
+ * @calendar: a #GcalCalendar
+ * @out_latency: (out)(optional): return location for the duration of the
+ *   last successful refresh, in microseconds, or -1
+ * @out_n_failures: (out)(optional): return location for the number of
+ *   consecutive failed refreshes
+ *
+ * Retrieves how the last refreshes of @calendar went.
+ *
+ * Returns: %TRUE if @calendar was refreshed at least once, %FALSE otherwise
+ */
+gboolean
+gcal_manager_get_refresh_info (GcalManager  *self,
+                               GcalCalendar *calendar,
+                               gint64       *out_latency,
+                               guint        *out_n_failures)
+{
+  RefreshSource *refresh;
+
+  g_return_val_if_fail (GCAL_IS_MANAGER (self), FALSE);
+  g_return_val_if_fail (GCAL_IS_CALENDAR (calendar), FALSE);
+
+  refresh = g_hash_table_lookup (self->refresh_sources, gcal_calendar_get_id (calendar));
+
+  if (!refresh || (refresh->latency < 0 && refresh->n_failures == 0))
+    return FALSE;
+
+  if (out_latency)
+    *out_latency = refresh->latency;
+
+  if (out_n_failures)
+    *out_n_failures = refresh->n_failures;
+
+  return TRUE;
 }
 
+/**
+ * gcal_manager_startup:
+ * @self: a #GcalManager
+ *
+ * Starts connecting to the source registry. This returns immediately;
+ * calendars are added asynchronously, visible calendars first.
+ */
 void
 gcal_manager_startup (GcalManager *self)
 {
-  ESourceCredentialsProvider *credentials_provider;
-  GList *sources, *l;
-  GError *error = NULL;
+  g_autoptr (GcalTimelineSnapshot) snapshot = NULL;
+  g_autofree gchar *snapshot_path = NULL;
+  g_autoptr (GError) error = NULL;
 
   GCAL_ENTRY;
 
+  g_return_if_fail (GCAL_IS_MANAGER (self));
+
   self->timeline = gcal_timeline_new_augmented (2.0);
   self->clients = g_hash_table_new_full ((GHashFunc) e_source_hash,
                                          (GEqualFunc) e_source_equal,
                                          g_object_unref,
                                          g_object_unref);
 
-  /* reading sources and schedule its connecting */
-  self->source_registry = e_source_registry_new_sync (NULL, &error);
+  /* Events of the last session are shown while calendars load */
+  snapshot_path = get_snapshot_path ();
+  snapshot = gcal_timeline_snapshot_load (snapshot_path, &error);
 
-  if (!self->source_registry)
-    {
-      g_warning ("Failed to access calendar configuration: %s", error->message);
-      g_error_free (error);
-      return;
-    }
+  if (snapshot)
+    gcal_timeline_set_snapshot (self->timeline, g_steal_pointer (&snapshot));
+  else if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+    g_debug ("Ignoring timeline snapshot: %s", error->message);
 
-  g_object_bind_property_full (self->source_registry,
-                               "default-calendar",
-                               self,
-                               "default-calendar",
-                               G_BINDING_DEFAULT,
-                               transform_e_source_to_gcal_calendar_cb,
-                               NULL,
-                               self,
-                               NULL);
+  e_source_registry_new (NULL, on_source_registry_created_cb, g_object_ref (self));
 
-  self->credentials_prompter = e_credentials_prompter_new (self->source_registry);
+  GCAL_EXIT;
+}
 
-  /* First disable credentials prompt for all but calendar sources... */
-  sources = e_source_registry_list_sources (self->source_registry, NULL);
+/**
+ * gcal_manager_save_snapshot:
+ * @self: a #GcalManager
+ *
+ * Saves the events of the current range of the timeline, so that
+ * they can be shown right away on the next startup. This must be
+ * called while the views are still subscribed to the timeline.
+ */
+void
+gcal_manager_save_snapshot (GcalManager *self)
+{
+  g_autofree gchar *snapshot_path = NULL;
+  g_autofree gchar *snapshot_dir = NULL;
+  g_autoptr (GError) error = NULL;
+
+  GCAL_ENTRY;
 
-  for (l = sources; l != NULL; l = g_list_next (l))
+  g_return_if_fail (GCAL_IS_MANAGER (self));
+
+  if (!self->timeline)
+    GCAL_RETURN ();
+
+  snapshot_path = get_snapshot_path ();
+  snapshot_dir = g_path_get_dirname (snapshot_path);
+
+  if (g_mkdir_with_parents (snapshot_dir, 0700) != 0)
     {
-      ESource *source = E_SOURCE (l->data);
+      g_warning ("Failed to create cache directory %s: %s", snapshot_dir, g_strerror (errno));
+      GCAL_RETURN ();
+    }
 
-      /* Mark for skip also currently disabled sources */
-      if (!e_source_has_extension (source, E_SOURCE_EXTENSION_CALENDAR) &&
-          !e_source_has_extension (source, E_SOURCE_EXTENSION_COLLECTION))
-        {
-          e_credentials_prompter_set_auto_prompt_disabled_for (self->credentials_prompter, source, TRUE);
-        }
+  if (!gcal_timeline_save_snapshot (self->timeline, snapshot_path, &error))
+    {
+      if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_NOT_INITIALIZED) ||
+          g_error_matches (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+        g_debug ("Not saving timeline snapshot: %s", error->message);
       else
-        {
-          e_source_get_last_credentials_required_arguments (source,
-                                                            NULL,
-                                                            source_get_last_credentials_required_arguments_cb,
-                                                            self);
-        }
+        g_warning ("Failed to save timeline snapshot: %s", error->message);
     }
 
-  g_list_free_full (sources, g_object_unref);
+  GCAL_EXIT;
+}
 
-  credentials_provider = e_credentials_prompter_get_provider (self->credentials_prompter);
+/**
+ * gcal_manager_create_events:
+ * @self: a #GcalManager
+ * @events: (element-type GcalEvent): the events to create
+ * @cancellable: (nullable): a #GCancellable
+ * @progress_func: (nullable): function called as events are created
+ * @progress_data: data for @progress_func
+ * @callback: callback to call when the events are created
+ * @user_data: data for @callback
+ *
+ * Creates @events in their calendars. Events are sent to each
+ * calendar in chunks, instead of one by one. If creating a chunk
+ * fails, or @cancellable is cancelled, the remaining events are
+ * not created.
+ */
+void
+gcal_manager_create_events (GcalManager             *self,
+                            GPtrArray               *events,
+                            GCancellable            *cancellable,
+                            GcalManagerProgressFunc  progress_func,
+                            gpointer                 progress_data,
+                            GAsyncReadyCallback      callback,
+                            gpointer                 user_data)
+{
+  BatchData *data;
 
-  /* ...then enable credentials prompt for credential source of the calendar sources,
-     which can be a collection source.  */
-  sources = e_source_registry_list_sources (self->source_registry, E_SOURCE_EXTENSION_CALENDAR);
+  GCAL_ENTRY;
 
-  for (l = sources; l != NULL; l = g_list_next (l))
-    {
-      ESource *source, *cred_source;
+  g_return_if_fail (GCAL_IS_MANAGER (self));
+  g_return_if_fail (events != NULL);
 
-      source = l->data;
-      cred_source = e_source_credentials_provider_ref_credentials_source (credentials_provider, source);
+  data = g_new0 (BatchData, 1);
+  data->operation = BATCH_CREATE;
 
-      if (cred_source && !e_source_equal (source, cred_source))
-	{
-          e_credentials_prompter_set_auto_prompt_disabled_for (self->credentials_prompter, cred_source, FALSE);
+  run_batch (self, data, events, cancellable, progress_func, progress_data,
+             gcal_manager_create_events, callback, user_data);
 
-          /* Only consider SSL errors */
-          if (e_source_get_connection_status (cred_source) != E_SOURCE_CONNECTION_STATUS_SSL_FAILED)
-            continue;
+  GCAL_EXIT;
+}
 
-          e_source_get_last_credentials_required_arguments (cred_source,
-                                                            NULL,
-                                                            source_get_last_credentials_required_arguments_cb,
-                                                            self);
-        }
+/**
+ * gcal_manager_create_events_finish:
+ * @self: a #GcalManager
+ * @result: a #GAsyncResult
+ * @error: (nullable): return location for a #GError
+ *
+ * Finishes an operation started by gcal_manager_create_events().
+ *
+ * Returns: %TRUE if all events were created
+ */
+gboolean
+gcal_manager_create_events_finish (GcalManager   *self,
+                                   GAsyncResult  *result,
+                                   GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, self), FALSE);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == gcal_manager_create_events, FALSE);
 
-      g_clear_object (&cred_source);
-    }
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * gcal_manager_update_events:
+ * @self: a #GcalManager
+ * @events: (element-type GcalEvent): the events to save
+ * @mod: an #GcalRecurrenceModType
+ * @cancellable: (nullable): a #GCancellable
+ * @progress_func: (nullable): function called as events are saved
+ * @progress_data: data for @progress_func
+ * @callback: callback to call when the events are saved
+ * @user_data: data for @callback
+ *
+ * Saves all changes made to @events, in chunks per calendar. See
+ * gcal_manager_create_events().
+ */
+void
+gcal_manager_update_events (GcalManager             *self,
+                            GPtrArray               *events,
+                            GcalRecurrenceModType    mod,
+                            GCancellable            *cancellable,
+                            GcalManagerProgressFunc  progress_func,
+                            gpointer                 progress_data,
+                            GAsyncReadyCallback      callback,
+                            gpointer                 user_data)
+{
+  BatchData *data;
 
-  g_list_free_full (sources, g_object_unref);
+  GCAL_ENTRY;
 
-  /* The eds_credentials_prompter responses to REQUIRED and REJECTED reasons,
-     the SSL_FAILED should be handled elsewhere. */
-  g_signal_connect_object (self->source_registry, "credentials-required", G_CALLBACK (source_credentials_required_cb), self, 0);
+  g_return_if_fail (GCAL_IS_MANAGER (self));
+  g_return_if_fail (events != NULL);
 
-  e_credentials_prompter_process_awaiting_credentials (self->credentials_prompter);
+  data = g_new0 (BatchData, 1);
+  data->operation = BATCH_UPDATE;
+  data->mod = mod;
 
-  g_signal_connect_object (self->source_registry, "source-added", G_CALLBACK (load_source), self, G_CONNECT_SWAPPED);
-  g_signal_connect_object (self->source_registry, "source-removed", G_CALLBACK (remove_source), self, G_CONNECT_SWAPPED);
-  g_signal_connect_object (self->source_registry, "source-changed", G_CALLBACK (source_changed), self, G_CONNECT_SWAPPED);
+  run_batch (self, data, events, cancellable, progress_func, progress_data,
+             gcal_manager_update_events, callback, user_data);
 
-  sources = e_source_registry_list_enabled (self->source_registry, E_SOURCE_EXTENSION_CALENDAR);
+  GCAL_EXIT;
+}
+
+/**
+ * gcal_manager_update_events_finish:
+ * @self: a #GcalManager
+ * @result: a #GAsyncResult
+ * @error: (nullable): return location for a #GError
+ *
+ * Finishes an operation started by gcal_manager_update_events().
+ *
+ * Returns: %TRUE if all events were saved
+ */
+gboolean
+gcal_manager_update_events_finish (GcalManager   *self,
+                                   GAsyncResult  *result,
+                                   GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, self), FALSE);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == gcal_manager_update_events, FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * gcal_manager_remove_events:
+ * @self: a #GcalManager
+ * @events: (element-type GcalEvent): the events to remove
+ * @mod: an #GcalRecurrenceModType
+ * @cancellable: (nullable): a #GCancellable
+ * @progress_func: (nullable): function called as events are removed
+ * @progress_data: data for @progress_func
+ * @callback: callback to call when the events are removed
+ * @user_data: data for @callback
+ *
+ * Deletes @events, in chunks per calendar. See gcal_manager_create_events().
+ */
+void
+gcal_manager_remove_events (GcalManager             *self,
+                            GPtrArray               *events,
+                            GcalRecurrenceModType    mod,
+                            GCancellable            *cancellable,
+                            GcalManagerProgressFunc  progress_func,
+                            gpointer                 progress_data,
+                            GAsyncReadyCallback      callback,
+                            gpointer                 user_data)
+{
+  BatchData *data;
+
+  GCAL_ENTRY;
+
+  g_return_if_fail (GCAL_IS_MANAGER (self));
+  g_return_if_fail (events != NULL);
+
+  data = g_new0 (BatchData, 1);
+  data->operation = BATCH_REMOVE;
+  data->mod = mod;
+
+  run_batch (self, data, events, cancellable, progress_func, progress_data,
+             gcal_manager_remove_events, callback, user_data);
+
+  GCAL_EXIT;
+}
+
+/**
+ * gcal_manager_remove_events_finish:
+ * @self: a #GcalManager
+ * @result: a #GAsyncResult
+ * @error: (nullable): return location for a #GError
+ *
+ * Finishes an operation started by gcal_manager_remove_events().
+ *
+ * Returns: %TRUE if all events were removed
+ */
+gboolean
+gcal_manager_remove_events_finish (GcalManager   *self,
+                                   GAsyncResult  *result,
+                                   GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, self), FALSE);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == gcal_manager_remove_events, FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * gcal_manager_move_events_to_source:
+ * @self: a #GcalManager
+ * @events: (element-type GcalEvent): the events to move
+ * @dest: the destination calendar
+ * @cancellable: (nullable): a #GCancellable
+ * @progress_func: (nullable): function called as events are moved
+ * @progress_data: data for @progress_func
+ * @callback: callback to call when the events are moved
+ * @user_data: data for @callback
+ *
+ * Moves @events to the @dest calendar. Like gcal_manager_move_event_to_source(),
+ * each chunk of events is only removed from its calendar once it was
+ * created in @dest, so no data is lost if moving fails. Events that
+ * already are in @dest are left untouched.
+ */
+void
+gcal_manager_move_events_to_source (GcalManager             *self,
+                                    GPtrArray               *events,
+                                    ESource                 *dest,
+                                    GCancellable            *cancellable,
+                                    GcalManagerProgressFunc  progress_func,
+                                    gpointer                 progress_data,
+                                    GAsyncReadyCallback      callback,
+                                    gpointer                 user_data)
+{
+  GcalCalendar *destination;
+  BatchData *data;
+
+  GCAL_ENTRY;
+
+  g_return_if_fail (GCAL_IS_MANAGER (self));
+  g_return_if_fail (events != NULL);
+  g_return_if_fail (E_IS_SOURCE (dest));
+
+  destination = g_hash_table_lookup (self->clients, dest);
+
+  if (!destination)
+    {
+      g_task_report_new_error (self, callback, user_data, gcal_manager_move_events_to_source,
+                               G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                               "Calendar %s is not loaded", e_source_get_uid (dest));
+      GCAL_RETURN ();
+    }
 
-  for (l = sources; l != NULL; l = l->next)
-    load_source (self, l->data);
+  data = g_new0 (BatchData, 1);
+  data->operation = BATCH_MOVE;
+  data->mod = GCAL_RECURRENCE_MOD_THIS_ONLY;
+  data->destination = g_object_ref (destination);
 
-  g_list_free (sources);
+  run_batch (self, data, events, cancellable, progress_func, progress_data,
+             gcal_manager_move_events_to_source, callback, user_data);
 
   GCAL_EXIT;
 }
+
+/**
+ * gcal_manager_move_events_to_source_finish:
+ * @self: a #GcalManager
+ * @result: a #GAsyncResult
+ * @error: (nullable): return location for a #GError
+ *
+ * Finishes an operation started by gcal_manager_move_events_to_source().
+ *
+ * Returns: %TRUE if all events were moved
+ */
+gboolean
+gcal_manager_move_events_to_source_finish (GcalManager   *self,
+                                           GAsyncResult  *result,
+                                           GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, self), FALSE);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == gcal_manager_move_events_to_source, FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
@@ -30,6 +30,10 @@ G_BEGIN_DECLS
 #define GCAL_TYPE_MANAGER (gcal_manager_get_type ())
 G_DECLARE_FINAL_TYPE (GcalManager, gcal_manager, GCAL, MANAGER, GObject)
 
+typedef void (*GcalManagerProgressFunc) (guint    n_completed,
+                                         guint    n_total,
+                                         gpointer user_data);
+
 GcalManager*         gcal_manager_new                            (void);
 
 ESource*             gcal_manager_get_source                     (GcalManager        *self,
@@ -63,6 +67,57 @@ void                 gcal_manager_move_event_to_source           (GcalManager
                                                                   GcalEvent          *event,
                                                                   ESource            *dest);
 
+void                 gcal_manager_create_events                  (GcalManager             *self,
+                                                                  GPtrArray               *events,
+                                                                  GCancellable            *cancellable,
+                                                                  GcalManagerProgressFunc  progress_func,
+                                                                  gpointer                 progress_data,
+                                                                  GAsyncReadyCallback      callback,
+                                                                  gpointer                 user_data);
+
+gboolean             gcal_manager_create_events_finish           (GcalManager        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
+void                 gcal_manager_update_events                  (GcalManager             *self,
+                                                                  GPtrArray               *events,
+                                                                  GcalRecurrenceModType    mod,
+                                                                  GCancellable            *cancellable,
+                                                                  GcalManagerProgressFunc  progress_func,
+                                                                  gpointer                 progress_data,
+                                                                  GAsyncReadyCallback      callback,
+                                                                  gpointer                 user_data);
+
+gboolean             gcal_manager_update_events_finish           (GcalManager        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
+void                 gcal_manager_remove_events                  (GcalManager             *self,
+                                                                  GPtrArray               *events,
+                                                                  GcalRecurrenceModType    mod,
+                                                                  GCancellable            *cancellable,
+                                                                  GcalManagerProgressFunc  progress_func,
+                                                                  gpointer                 progress_data,
+                                                                  GAsyncReadyCallback      callback,
+                                                                  gpointer                 user_data);
+
+gboolean             gcal_manager_remove_events_finish           (GcalManager        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
+void                 gcal_manager_move_events_to_source          (GcalManager             *self,
+                                                                  GPtrArray               *events,
+                                                                  ESource                 *dest,
+                                                                  GCancellable            *cancellable,
+                                                                  GcalManagerProgressFunc  progress_func,
+                                                                  gpointer                 progress_data,
+                                                                  GAsyncReadyCallback      callback,
+                                                                  gpointer                 user_data);
+
+gboolean             gcal_manager_move_events_to_source_finish   (GcalManager        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
 gchar*               gcal_manager_add_source                     (GcalManager        *self,
                                                                   const gchar        *name,
                                                                   const gchar        *backend,
@@ -73,8 +128,20 @@ void                 gcal_manager_save_source                    (GcalManager
 
 gboolean             gcal_manager_get_synchronizing              (GcalManager        *self);
 
+guint                gcal_manager_get_max_concurrent_refreshes   (GcalManager        *self);
+
+void                 gcal_manager_set_max_concurrent_refreshes   (GcalManager        *self,
+                                                                  guint               max_concurrent_refreshes);
+
+gboolean             gcal_manager_get_refresh_info               (GcalManager        *self,
+                                                                  GcalCalendar       *calendar,
+                                                                  gint64             *out_latency,
+                                                                  guint              *out_n_failures);
+
 void                 gcal_manager_startup                        (GcalManager        *self);
 
+void                 gcal_manager_save_snapshot                  (GcalManager        *self);
+
 G_END_DECLS
 
 #endif /* __GCAL_MANAGER_H__ */
@@ -28,20 +28,16 @@ struct _GcalRange
 
   GDateTime          *range_start;
   GDateTime          *range_end;
-  GcalRangeType       range_type;
 
-  int64_t             start_unix_timestamp;
-  int64_t             start_date_timestamp;
-  int64_t             end_unix_timestamp;
-  int64_t             end_date_timestamp;
+  GcalRangeValue      value;
 };
 
 G_DEFINE_BOXED_TYPE (GcalRange, gcal_range, gcal_range_ref, gcal_range_unref)
 
-static inline int64_t
+static inline gint32
 date_time_to_date_timestamp (GDateTime *datetime)
 {
-  int64_t date_timestamp = 0;
+  gint32 date_timestamp = 0;
 
   date_timestamp += g_date_time_get_day_of_month (datetime);
   date_timestamp += (g_date_time_get_month (datetime) * 100);
@@ -50,42 +46,31 @@ date_time_to_date_timestamp (GDateTime *datetime)
   return date_timestamp;
 }
 
-static inline void
-get_start_and_end_timestamps (GcalRange *a,
-                              GcalRange *b,
-                              int64_t   *out_start_timestamp_a,
-                              int64_t   *out_end_timestamp_a,
-                              int64_t   *out_start_timestamp_b,
-                              int64_t   *out_end_timestamp_b)
+/**
+ * gcal_range_value_init:
+ * @self: a #GcalRangeValue
+ * @range_start: a #GDateTime
+ * @range_end: a #GDateTime
+ * @range_type: the #GcalRangeType
+ *
+ * Initializes @self with the range between @range_start
+ * and @range_end.
+ */
+void
+gcal_range_value_init (GcalRangeValue *self,
+                       GDateTime      *range_start,
+                       GDateTime      *range_end,
+                       GcalRangeType   range_type)
 {
-  int64_t start_timestamp_a;
-  int64_t start_timestamp_b;
-  int64_t end_timestamp_a;
-  int64_t end_timestamp_b;
-
-  if (a->range_type == GCAL_RANGE_DATE_ONLY || b->range_type == GCAL_RANGE_DATE_ONLY)
-    {
-      start_timestamp_a = a->start_date_timestamp;
-      start_timestamp_b = b->start_date_timestamp;
-      end_timestamp_a = a->end_date_timestamp;
-      end_timestamp_b = b->end_date_timestamp;
-    }
-  else
-    {
-      start_timestamp_a = a->start_unix_timestamp;
-      start_timestamp_b = b->start_unix_timestamp;
-      end_timestamp_a = a->end_unix_timestamp;
-      end_timestamp_b = b->end_unix_timestamp;
-    }
-
-  if (out_start_timestamp_a)
-    *out_start_timestamp_a = start_timestamp_a;
-  if (out_start_timestamp_b)
-    *out_start_timestamp_b = start_timestamp_b;
-  if (out_end_timestamp_a)
-    *out_end_timestamp_a = end_timestamp_a;
-  if (out_end_timestamp_b)
-    *out_end_timestamp_b = end_timestamp_b;
+  g_return_if_fail (self != NULL);
+  g_return_if_fail (range_start != NULL);
+  g_return_if_fail (range_end != NULL);
+
+  self->start_unix = g_date_time_to_unix (range_start);
+  self->start_date = date_time_to_date_timestamp (range_start);
+  self->end_unix = g_date_time_to_unix (range_end);
+  self->end_date = date_time_to_date_timestamp (range_end);
+  self->range_type = range_type;
 }
 
 /**
@@ -105,7 +90,7 @@ gcal_range_copy (GcalRange *self)
   g_return_val_if_fail (self, NULL);
   g_return_val_if_fail (!g_atomic_ref_count_compare (&self->ref_count, 0), NULL);
 
-  copy = gcal_range_new (self->range_start, self->range_end, self->range_type);
+  copy = gcal_range_new (self->range_start, self->range_end, self->value.range_type);
 
   return copy;
 }
@@ -205,12 +190,8 @@ gcal_range_new_take (GDateTime     *range_start,
 
   self->range_start = range_start;
   self->range_end = range_end;
-  self->range_type = range_type;
 
-  self->start_unix_timestamp = g_date_time_to_unix (range_start);
-  self->start_date_timestamp = date_time_to_date_timestamp (range_start);
-  self->end_unix_timestamp = g_date_time_to_unix (range_end);
-  self->end_date_timestamp = date_time_to_date_timestamp (range_end);
+  gcal_range_value_init (&self->value, range_start, range_end, range_type);
 
   return self;
 }
@@ -263,13 +244,30 @@ gcal_range_get_range_type (GcalRange *self)
   g_return_val_if_fail (self, GCAL_RANGE_DEFAULT);
   g_return_val_if_fail (!g_atomic_ref_count_compare (&self->ref_count, 0), GCAL_RANGE_DEFAULT);
 
-  return self->range_type;
+  return self->value.range_type;
 }
 
 /**
- * gcal_range_calculate_overlap:
- * @a: a #GcalRange
- * @b: a #GcalRange
+ * gcal_range_get_value:
+ * @self: a #GcalRange
+ *
+ * Retrieves the plain value of @self, which can be used with the
+ * allocation-free gcal_range_value_*() helpers.
+ *
+ * Returns: (transfer none): a #GcalRangeValue
+ */
+const GcalRangeValue*
+gcal_range_get_value (GcalRange *self)
+{
+  g_return_val_if_fail (self, NULL);
+
+  return &self->value;
+}
+
+/**
+ * gcal_range_value_calculate_overlap:
+ * @a: a #GcalRangeValue
+ * @b: a #GcalRangeValue
  * @out_position: (direction out)(nullable): return location for a #GcalRangePosition
  *
  * Calculates how @a and @b overlap.
@@ -285,18 +283,18 @@ gcal_range_get_range_type (GcalRange *self)
  * Returns: the overlap result between @a and @b
  */
 GcalRangeOverlap
-gcal_range_calculate_overlap (GcalRange         *a,
-                              GcalRange         *b,
-                              GcalRangePosition *out_position)
+gcal_range_value_calculate_overlap (const GcalRangeValue *a,
+                                    const GcalRangeValue *b,
+                                    GcalRangePosition    *out_position)
 {
   GcalRangePosition position;
   GcalRangeOverlap overlap;
   int64_t a_start_b_start_diff;
   int64_t a_end_b_end_diff;
-  int64_t start_timestamp_a;
-  int64_t start_timestamp_b;
-  int64_t end_timestamp_a;
-  int64_t end_timestamp_b;
+  gint64 start_timestamp_a;
+  gint64 start_timestamp_b;
+  gint64 end_timestamp_a;
+  gint64 end_timestamp_b;
 
   g_return_val_if_fail (a && b, GCAL_RANGE_NO_OVERLAP);
 
@@ -358,9 +356,9 @@ gcal_range_calculate_overlap (GcalRange         *a,
    *
    */
 
-  get_start_and_end_timestamps (a, b,
-                                &start_timestamp_a, &end_timestamp_a,
-                                &start_timestamp_b, &end_timestamp_b);
+  gcal_range_value_get_timestamps (a, b,
+                                   &start_timestamp_a, &end_timestamp_a,
+                                   &start_timestamp_b, &end_timestamp_b);
 
   a_start_b_start_diff = start_timestamp_a - start_timestamp_b;
   a_end_b_end_diff = end_timestamp_a - end_timestamp_b;
@@ -481,31 +479,51 @@ gcal_range_calculate_overlap (GcalRange         *a,
 }
 
 /**
- * gcal_range_compare:
+ * gcal_range_calculate_overlap:
  * @a: a #GcalRange
  * @b: a #GcalRange
+ * @out_position: (direction out)(nullable): return location for a #GcalRangePosition
+ *
+ * Calculates how @a and @b overlap. See gcal_range_value_calculate_overlap().
  *
- * Compares @a and @b. See gcal_range_calculate_overlap() for the
- * rules of when a range comes before or after.
+ * Returns: the overlap result between @a and @b
+ */
+GcalRangeOverlap
+gcal_range_calculate_overlap (GcalRange         *a,
+                              GcalRange         *b,
+                              GcalRangePosition *out_position)
+{
+  g_return_val_if_fail (a && b, GCAL_RANGE_NO_OVERLAP);
+
+  return gcal_range_value_calculate_overlap (&a->value, &b->value, out_position);
+}
+
+/**
+ * gcal_range_value_compare:
+ * @a: a #GcalRangeValue
+ * @b: a #GcalRangeValue
+ *
+ * Compares @a and @b. See gcal_range_value_calculate_overlap() for
+ * the rules of when a range comes before or after.
  *
  * Returns: -1 is @a comes before @b, 0 if they're equal, or 1 if
  * @a comes after @b.
  */
 gint
-gcal_range_compare (GcalRange *a,
-                    GcalRange *b)
+gcal_range_value_compare (const GcalRangeValue *a,
+                          const GcalRangeValue *b)
 {
-  int64_t start_timestamp_a;
-  int64_t start_timestamp_b;
-  int64_t end_timestamp_a;
-  int64_t end_timestamp_b;
+  gint64 start_timestamp_a;
+  gint64 start_timestamp_b;
+  gint64 end_timestamp_a;
+  gint64 end_timestamp_b;
   int64_t result;
 
   g_return_val_if_fail (a && b, 0);
 
-  get_start_and_end_timestamps (a, b,
-                                &start_timestamp_a, &end_timestamp_a,
-                                &start_timestamp_b, &end_timestamp_b);
+  gcal_range_value_get_timestamps (a, b,
+                                   &start_timestamp_a, &end_timestamp_a,
+                                   &start_timestamp_b, &end_timestamp_b);
 
   result = start_timestamp_a - start_timestamp_b;
 
@@ -520,6 +538,25 @@ gcal_range_compare (GcalRange *a,
     return GCAL_RANGE_MATCH;
 }
 
+/**
+ * gcal_range_compare:
+ * @a: a #GcalRange
+ * @b: a #GcalRange
+ *
+ * Compares @a and @b. See gcal_range_value_compare().
+ *
+ * Returns: -1 is @a comes before @b, 0 if they're equal, or 1 if
+ * @a comes after @b.
+ */
+gint
+gcal_range_compare (GcalRange *a,
+                    GcalRange *b)
+{
+  g_return_val_if_fail (a && b, 0);
+
+  return gcal_range_value_compare (&a->value, &b->value);
+}
+
 /**
  * gcal_range_union:
  * @a: a #GcalRange
@@ -536,17 +573,17 @@ gcal_range_union (GcalRange *a,
   GcalRangeType range_type;
   GDateTime *start;
   GDateTime *end;
-  int64_t start_timestamp_a;
-  int64_t start_timestamp_b;
-  int64_t end_timestamp_a;
-  int64_t end_timestamp_b;
+  gint64 start_timestamp_a;
+  gint64 start_timestamp_b;
+  gint64 end_timestamp_a;
+  gint64 end_timestamp_b;
 
   g_return_val_if_fail (a != NULL, NULL);
   g_return_val_if_fail (b != NULL, NULL);
 
-  get_start_and_end_timestamps (a, b,
-                                &start_timestamp_a, &end_timestamp_a,
-                                &start_timestamp_b, &end_timestamp_b);
+  gcal_range_value_get_timestamps (&a->value, &b->value,
+                                   &start_timestamp_a, &end_timestamp_a,
+                                   &start_timestamp_b, &end_timestamp_b);
 
   if (start_timestamp_a < start_timestamp_b)
     start = a->range_start;
@@ -558,7 +595,7 @@ gcal_range_union (GcalRange *a,
   else
     end = b->range_end;
 
-  if (a->range_type == GCAL_RANGE_DATE_ONLY || b->range_type == GCAL_RANGE_DATE_ONLY)
+  if (a->value.range_type == GCAL_RANGE_DATE_ONLY || b->value.range_type == GCAL_RANGE_DATE_ONLY)
     range_type = GCAL_RANGE_DATE_ONLY;
   else
     range_type = GCAL_RANGE_DEFAULT;
@@ -608,15 +645,15 @@ gcal_range_contains_datetime (GcalRange *self,
   g_return_val_if_fail (self, FALSE);
   g_return_val_if_fail (datetime, FALSE);
 
-  switch (self->range_type)
+  switch (self->value.range_type)
     {
     case GCAL_RANGE_DEFAULT:
       timestamp = g_date_time_to_unix (datetime);
-      return timestamp >= self->start_unix_timestamp && timestamp < self->end_unix_timestamp;
+      return timestamp >= self->value.start_unix && timestamp < self->value.end_unix;
 
     case GCAL_RANGE_DATE_ONLY:
       timestamp = date_time_to_date_timestamp (datetime);
-      return timestamp >= self->start_date_timestamp && timestamp <= self->end_date_timestamp;
+      return timestamp >= self->value.start_date && timestamp <= self->value.end_date;
 
     default:
       g_assert_not_reached ();
@@ -78,6 +78,116 @@ typedef enum
   GCAL_RANGE_DATE_ONLY,
 } GcalRangeType;
 
+/**
+ * GcalRangeValue:
+ * @start_unix: UNIX timestamp of the start of the range
+ * @end_unix: UNIX timestamp of the end of the range
+ * @start_date: date of the start of the range, encoded as YYYYMMDD
+ * @end_date: date of the end of the range, encoded as YYYYMMDD
+ * @range_type: the #GcalRangeType
+ *
+ * A plain representation of a range. It holds no references and
+ * can be allocated on the stack and copied around, which makes it
+ * suitable for layout code that deals with many ranges at once.
+ *
+ * #GcalRange is a reference counted wrapper around it.
+ */
+typedef struct
+{
+  gint64              start_unix;
+  gint64              end_unix;
+  gint32              start_date;
+  gint32              end_date;
+  GcalRangeType       range_type;
+} GcalRangeValue;
+
+static inline void
+gcal_range_value_get_timestamps (const GcalRangeValue *a,
+                                 const GcalRangeValue *b,
+                                 gint64               *out_start_a,
+                                 gint64               *out_end_a,
+                                 gint64               *out_start_b,
+                                 gint64               *out_end_b)
+{
+  if (a->range_type == GCAL_RANGE_DATE_ONLY || b->range_type == GCAL_RANGE_DATE_ONLY)
+    {
+      *out_start_a = a->start_date;
+      *out_end_a = a->end_date;
+      *out_start_b = b->start_date;
+      *out_end_b = b->end_date;
+    }
+  else
+    {
+      *out_start_a = a->start_unix;
+      *out_end_a = a->end_unix;
+      *out_start_b = b->start_unix;
+      *out_end_b = b->end_unix;
+    }
+}
+
+/*
+ * Equivalent to gcal_range_value_calculate_overlap() returning anything
+ * but %GCAL_RANGE_NO_OVERLAP. Ranges starting at the same moment always
+ * overlap, even when either of them is empty.
+ */
+static inline gboolean
+gcal_range_value_overlaps (const GcalRangeValue *a,
+                           const GcalRangeValue *b)
+{
+  gint64 start_a, end_a, start_b, end_b;
+
+  gcal_range_value_get_timestamps (a, b, &start_a, &end_a, &start_b, &end_b);
+
+  return start_a == start_b || (start_a < end_b && start_b < end_a);
+}
+
+/* Whether @other is entirely within @self */
+static inline gboolean
+gcal_range_value_contains (const GcalRangeValue *self,
+                           const GcalRangeValue *other)
+{
+  gint64 start_a, end_a, start_b, end_b;
+
+  gcal_range_value_get_timestamps (self, other, &start_a, &end_a, &start_b, &end_b);
+
+  return start_a <= start_b && end_b <= end_a;
+}
+
+static inline void
+gcal_range_value_union (const GcalRangeValue *a,
+                        const GcalRangeValue *b,
+                        GcalRangeValue       *out_union)
+{
+  gint64 start_a, end_a, start_b, end_b;
+  GcalRangeValue result;
+
+  gcal_range_value_get_timestamps (a, b, &start_a, &end_a, &start_b, &end_b);
+
+  result.start_unix = start_a < start_b ? a->start_unix : b->start_unix;
+  result.start_date = start_a < start_b ? a->start_date : b->start_date;
+  result.end_unix = end_a > end_b ? a->end_unix : b->end_unix;
+  result.end_date = end_a > end_b ? a->end_date : b->end_date;
+
+  if (a->range_type == GCAL_RANGE_DATE_ONLY || b->range_type == GCAL_RANGE_DATE_ONLY)
+    result.range_type = GCAL_RANGE_DATE_ONLY;
+  else
+    result.range_type = GCAL_RANGE_DEFAULT;
+
+  *out_union = result;
+}
+
+void                 gcal_range_value_init                       (GcalRangeValue       *self,
+                                                                  GDateTime            *range_start,
+                                                                  GDateTime            *range_end,
+                                                                  GcalRangeType         range_type);
+
+GcalRangeOverlap     gcal_range_value_calculate_overlap          (const GcalRangeValue *a,
+                                                                  const GcalRangeValue *b,
+                                                                  GcalRangePosition    *out_position);
+
+gint                 gcal_range_value_compare                    (const GcalRangeValue *a,
+                                                                  const GcalRangeValue *b);
+
 GType                gcal_range_get_type                         (void) G_GNUC_CONST;
 
 GcalRange*           gcal_range_new                              (GDateTime          *range_start,
@@ -93,6 +203,7 @@ void                 gcal_range_unref                            (GcalRange
 GDateTime*           gcal_range_get_start                        (GcalRange          *self);
 GDateTime*           gcal_range_get_end                          (GcalRange          *self);
 GcalRangeType        gcal_range_get_range_type                   (GcalRange          *self);
+const GcalRangeValue* gcal_range_get_value                       (GcalRange          *self);
 
 GcalRangeOverlap     gcal_range_calculate_overlap                (GcalRange          *a,
                                                                   GcalRange          *b,
@@ -0,0 +1,155 @@
+/* gcal-startup-profile.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GcalStartupProfile"
+
+#include "gcal-core-macros.h"
+#include "gcal-startup-profile.h"
+
+/*
+ * Records when each startup stage was reached, relative to the moment
+ * the profile was initialized, which happens while handling the local
+ * command line options. Stages are only recorded once, so marking a
+ * stage again is harmless.
+ *
+ * Timings are always logged as debug messages. When the profile was
+ * initialized with printing enabled (the --startup-profile command
+ * line option), they are also printed to stdout once every stage has
+ * been reached, or at shutdown, whichever happens first.
+ *
+ * This must only be used from the main thread.
+ */
+
+static const gchar * const stage_names[] = {
+  [GCAL_STARTUP_STAGE_APPLICATION_STARTUP] = "application-startup",
+  [GCAL_STARTUP_STAGE_WINDOW_CREATED] = "window-created",
+  [GCAL_STARTUP_STAGE_FIRST_FRAME] = "first-frame",
+  [GCAL_STARTUP_STAGE_REGISTRY_CONNECTED] = "registry-connected",
+  [GCAL_STARTUP_STAGE_VISIBLE_CALENDARS_LOADED] = "visible-calendars-loaded",
+  [GCAL_STARTUP_STAGE_ALL_CALENDARS_LOADED] = "all-calendars-loaded",
+};
+
+G_STATIC_ASSERT (G_N_ELEMENTS (stage_names) == GCAL_N_STARTUP_STAGES);
+
+static gint64 origin = 0;
+static gint64 stages[GCAL_N_STARTUP_STAGES] = { 0, };
+static gboolean print_enabled = FALSE;
+static gboolean printed = FALSE;
+
+
+/*
+ * Auxiliary methods
+ */
+
+static inline void
+ensure_origin (void)
+{
+  if (origin == 0)
+    origin = g_get_monotonic_time ();
+}
+
+static gboolean
+all_stages_marked (void)
+{
+  for (gsize i = 0; i < GCAL_N_STARTUP_STAGES; i++)
+    {
+      if (stages[i] == 0)
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+
+/*
+ * Public API
+ */
+
+/**
+ * gcal_startup_profile_init:
+ * @print: whether to print the timings to stdout
+ *
+ * Starts the startup profile. All stages are timed relative to
+ * the moment this function is first called.
+ */
+void
+gcal_startup_profile_init (gboolean print)
+{
+  g_assert (GCAL_IS_MAIN_THREAD ());
+
+  ensure_origin ();
+  print_enabled = print;
+}
+
+/**
+ * gcal_startup_profile_mark:
+ * @stage: a #GcalStartupStage
+ *
+ * Marks @stage as reached. Only the first call for each stage
+ * is taken into account.
+ */
+void
+gcal_startup_profile_mark (GcalStartupStage stage)
+{
+  g_return_if_fail (stage < GCAL_N_STARTUP_STAGES);
+  g_assert (GCAL_IS_MAIN_THREAD ());
+
+  ensure_origin ();
+
+  if (stages[stage] != 0)
+    return;
+
+  stages[stage] = g_get_monotonic_time ();
+
+  g_debug ("Startup stage '%s' reached after %.3lf ms",
+           stage_names[stage],
+           (stages[stage] - origin) / 1000.0);
+
+  if (all_stages_marked ())
+    gcal_startup_profile_print ();
+}
+
+/**
+ * gcal_startup_profile_print:
+ *
+ * Prints the timings of all stages to stdout, if printing was enabled
+ * by gcal_startup_profile_init(). Timings are only printed once.
+ */
+void
+gcal_startup_profile_print (void)
+{
+  if (!print_enabled || printed)
+    return;
+
+  printed = TRUE;
+
+  g_print ("Startup profile:\n");
+
+  for (gsize i = 0; i < GCAL_N_STARTUP_STAGES; i++)
+    {
+      if (stages[i] == 0)
+        {
+          g_print ("  %-26s  not reached\n", stage_names[i]);
+          continue;
+        }
+
+      g_print ("  %-26s %10.3lf ms\n", stage_names[i], (stages[i] - origin) / 1000.0);
+    }
+}
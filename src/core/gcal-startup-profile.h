@@ -0,0 +1,56 @@
+/* gcal-startup-profile.h
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GcalStartupStage:
+ * @GCAL_STARTUP_STAGE_APPLICATION_STARTUP: GApplication::startup was reached
+ * @GCAL_STARTUP_STAGE_WINDOW_CREATED: the main window was created
+ * @GCAL_STARTUP_STAGE_FIRST_FRAME: the main window painted its first frame
+ * @GCAL_STARTUP_STAGE_REGISTRY_CONNECTED: the source registry is available
+ * @GCAL_STARTUP_STAGE_VISIBLE_CALENDARS_LOADED: all visible calendars are open
+ * @GCAL_STARTUP_STAGE_ALL_CALENDARS_LOADED: all enabled calendars are open
+ *
+ * The stages of the application startup, roughly in the order they
+ * are expected to be reached.
+ */
+typedef enum
+{
+  GCAL_STARTUP_STAGE_APPLICATION_STARTUP,
+  GCAL_STARTUP_STAGE_WINDOW_CREATED,
+  GCAL_STARTUP_STAGE_FIRST_FRAME,
+  GCAL_STARTUP_STAGE_REGISTRY_CONNECTED,
+  GCAL_STARTUP_STAGE_VISIBLE_CALENDARS_LOADED,
+  GCAL_STARTUP_STAGE_ALL_CALENDARS_LOADED,
+  GCAL_N_STARTUP_STAGES,
+} GcalStartupStage;
+
+void                 gcal_startup_profile_init                   (gboolean            print);
+
+void                 gcal_startup_profile_mark                   (GcalStartupStage    stage);
+
+void                 gcal_startup_profile_print                  (void);
+
+G_END_DECLS
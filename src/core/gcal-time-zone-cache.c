@@ -0,0 +1,422 @@
+/* gcal-time-zone-cache.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GcalTimeZoneCache"
+
+#include "gcal-debug.h"
+#include "gcal-time-zone-cache.h"
+#include "gcal-utils.h"
+
+/*
+ * Process-wide cache of time zone resolutions. Building events resolves
+ * the same handful of TZIDs over and over, and every resolution either
+ * parses a tzdata file, or - for calendar-defined zones - performs a
+ * synchronous D-Bus roundtrip to the calendar backend.
+ *
+ * Unknown identifiers and TZIDs are cached as well, so they are only
+ * looked up once. Errors talking to the calendar backend, e.g. when it
+ * is not connected yet, are not cached, so the next lookup tries again.
+ * The zones of a calendar are dropped when the calendar is removed or
+ * refreshed; other entries are never evicted, since the set of time
+ * zones in use is naturally small.
+ *
+ * All functions are safe to call from any thread. The lock is never
+ * held while resolving a miss, so concurrent misses may resolve the
+ * same key twice, in which case the first inserted value wins.
+ */
+
+typedef struct
+{
+  GMutex              mutex;
+
+  /* gchar* identifier → GTimeZone* (NULL for invalid identifiers) */
+  GHashTable         *identifiers;
+
+  /* GINT_TO_POINTER (offset) → GTimeZone* */
+  GHashTable         *offsets;
+
+  /* gchar* calendar id → GHashTable (gchar* tzid → ICalTimezone*, or NULL) */
+  GHashTable         *calendar_zones;
+
+  /* gchar* identifier → ICalTimezone* (owned by libical) */
+  GHashTable         *builtin_zones;
+
+  guint64             hits;
+  guint64             misses;
+} GcalTimeZoneCache;
+
+
+/*
+ * Auxiliary methods
+ */
+
+static void
+time_zone_unref0 (gpointer data)
+{
+  if (data)
+    g_time_zone_unref (data);
+}
+
+static void
+object_unref0 (gpointer data)
+{
+  if (data)
+    g_object_unref (data);
+}
+
+static GcalTimeZoneCache*
+get_cache (void)
+{
+  static GcalTimeZoneCache *cache = NULL;
+
+  if (g_once_init_enter_pointer (&cache))
+    {
+      GcalTimeZoneCache *new_cache = g_new0 (GcalTimeZoneCache, 1);
+
+      g_mutex_init (&new_cache->mutex);
+      new_cache->identifiers = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, time_zone_unref0);
+      new_cache->offsets = g_hash_table_new_full (NULL, NULL, NULL, time_zone_unref0);
+      new_cache->calendar_zones = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_destroy);
+      new_cache->builtin_zones = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+      g_once_init_leave_pointer (&cache, new_cache);
+    }
+
+  return cache;
+}
+
+/*
+ * Looks up @key in @table, and returns whether it was found. The caller
+ * must hold the cache lock.
+ */
+static inline gboolean
+lookup_locked (GcalTimeZoneCache *cache,
+               GHashTable        *table,
+               gconstpointer      key,
+               gpointer          *out_value)
+{
+  if (g_hash_table_lookup_extended (table, key, NULL, out_value))
+    {
+      cache->hits++;
+      return TRUE;
+    }
+
+  cache->misses++;
+  return FALSE;
+}
+
+
+/*
+ * Public API
+ */
+
+/**
+ * gcal_time_zone_cache_lookup_identifier:
+ * @identifier: a time zone identifier
+ *
+ * Cached equivalent of g_time_zone_new_identifier().
+ *
+ * Returns: (transfer full)(nullable): a #GTimeZone, or %NULL if
+ * @identifier is not a valid time zone identifier.
+ */
+GTimeZone*
+gcal_time_zone_cache_lookup_identifier (const gchar *identifier)
+{
+  GcalTimeZoneCache *cache;
+  GTimeZone *existing;
+  GTimeZone *tz;
+
+  g_return_val_if_fail (identifier != NULL, NULL);
+
+  cache = get_cache ();
+
+  g_mutex_lock (&cache->mutex);
+  if (lookup_locked (cache, cache->identifiers, identifier, (gpointer *) &tz))
+    {
+      tz = tz ? g_time_zone_ref (tz) : NULL;
+      g_mutex_unlock (&cache->mutex);
+      return tz;
+    }
+  g_mutex_unlock (&cache->mutex);
+
+  tz = g_time_zone_new_identifier (identifier);
+
+  g_mutex_lock (&cache->mutex);
+  if (g_hash_table_lookup_extended (cache->identifiers, identifier, NULL, (gpointer *) &existing))
+    {
+      g_clear_pointer (&tz, g_time_zone_unref);
+      tz = existing ? g_time_zone_ref (existing) : NULL;
+    }
+  else
+    {
+      g_hash_table_insert (cache->identifiers, g_strdup (identifier), tz ? g_time_zone_ref (tz) : NULL);
+    }
+  g_mutex_unlock (&cache->mutex);
+
+  return tz;
+}
+
+/**
+ * gcal_time_zone_cache_lookup_offset:
+ * @offset: an UTC offset, in seconds
+ *
+ * Retrieves a fixed-offset #GTimeZone for @offset. The
+ * identifier of the time zone is formatted with
+ * format_utc_offset().
+ *
+ * Returns: (transfer full)(nullable): a #GTimeZone
+ */
+GTimeZone*
+gcal_time_zone_cache_lookup_offset (gint offset)
+{
+  g_autofree gchar *identifier = NULL;
+  GcalTimeZoneCache *cache;
+  GTimeZone *existing;
+  GTimeZone *tz;
+
+  cache = get_cache ();
+
+  g_mutex_lock (&cache->mutex);
+  if (lookup_locked (cache, cache->offsets, GINT_TO_POINTER (offset), (gpointer *) &tz))
+    {
+      tz = g_time_zone_ref (tz);
+      g_mutex_unlock (&cache->mutex);
+      return tz;
+    }
+  g_mutex_unlock (&cache->mutex);
+
+  identifier = format_utc_offset (offset);
+  tz = g_time_zone_new_identifier (identifier);
+
+  if (!tz)
+    return NULL;
+
+  g_mutex_lock (&cache->mutex);
+  existing = g_hash_table_lookup (cache->offsets, GINT_TO_POINTER (offset));
+  if (existing)
+    {
+      g_time_zone_unref (tz);
+      tz = g_time_zone_ref (existing);
+    }
+  else
+    {
+      g_hash_table_insert (cache->offsets, GINT_TO_POINTER (offset), g_time_zone_ref (tz));
+    }
+  g_mutex_unlock (&cache->mutex);
+
+  return tz;
+}
+
+/**
+ * gcal_time_zone_cache_lookup_calendar_zone:
+ * @calendar: a #GcalCalendar
+ * @tzid: the TZID, as it appears in the component
+ *
+ * Resolves @tzid against the time zones defined by @calendar's
+ * backend. Only the first lookup of each (@calendar, @tzid) pair
+ * reaches the backend; the resolved zone is copied, so that it
+ * outlives the calendar client.
+ *
+ * Returns: (transfer full)(nullable): an #ICalTimezone, or %NULL
+ * if @calendar does not define @tzid, or could not be queried.
+ */
+ICalTimezone*
+gcal_time_zone_cache_lookup_calendar_zone (GcalCalendar *calendar,
+                                           const gchar  *tzid)
+{
+  g_autoptr (ICalTimezone) zone = NULL;
+  g_autoptr (GError) error = NULL;
+  GcalTimeZoneCache *cache;
+  ICalTimezone *tzone = NULL;
+  ICalTimezone *cached;
+  ECalClient *client;
+  GHashTable *zones;
+  const gchar *calendar_id;
+
+  g_return_val_if_fail (GCAL_IS_CALENDAR (calendar), NULL);
+  g_return_val_if_fail (tzid != NULL, NULL);
+
+  cache = get_cache ();
+  calendar_id = gcal_calendar_get_id (calendar);
+
+  g_mutex_lock (&cache->mutex);
+  zones = g_hash_table_lookup (cache->calendar_zones, calendar_id);
+  if (zones && lookup_locked (cache, zones, tzid, (gpointer *) &cached))
+    {
+      cached = cached ? g_object_ref (cached) : NULL;
+      g_mutex_unlock (&cache->mutex);
+      return cached;
+    }
+  else if (!zones)
+    {
+      cache->misses++;
+    }
+  g_mutex_unlock (&cache->mutex);
+
+  client = gcal_calendar_get_client (calendar);
+
+  if (!client)
+    return NULL;
+
+  if (e_cal_client_get_timezone_sync (client, tzid, &tzone, NULL, &error) && tzone)
+    zone = i_cal_timezone_copy (tzone);
+
+  /* Only a definitive answer from the backend is cached */
+  if (error && !g_error_matches (error, E_CAL_CLIENT_ERROR, E_CAL_CLIENT_ERROR_OBJECT_NOT_FOUND))
+    {
+      GCAL_TRACE_MSG ("Error resolving %s in calendar %s: %s", tzid, calendar_id, error->message);
+      return NULL;
+    }
+
+  g_mutex_lock (&cache->mutex);
+
+  zones = g_hash_table_lookup (cache->calendar_zones, calendar_id);
+  if (!zones)
+    {
+      zones = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, object_unref0);
+      g_hash_table_insert (cache->calendar_zones, g_strdup (calendar_id), zones);
+    }
+
+  if (g_hash_table_lookup_extended (zones, tzid, NULL, (gpointer *) &cached))
+    g_set_object (&zone, cached);
+  else
+    g_hash_table_insert (zones, g_strdup (tzid), zone ? g_object_ref (zone) : NULL);
+
+  g_mutex_unlock (&cache->mutex);
+
+  GCAL_TRACE_MSG ("Resolved %s in calendar %s: %p", tzid, calendar_id, zone);
+
+  return g_steal_pointer (&zone);
+}
+
+/**
+ * gcal_time_zone_cache_remove_calendar:
+ * @calendar: a #GcalCalendar
+ *
+ * Drops the time zones resolved against @calendar, so that the next
+ * lookups reach its backend again. This must be called when @calendar
+ * is removed, or when its contents are reloaded.
+ */
+void
+gcal_time_zone_cache_remove_calendar (GcalCalendar *calendar)
+{
+  GcalTimeZoneCache *cache;
+
+  g_return_if_fail (GCAL_IS_CALENDAR (calendar));
+
+  cache = get_cache ();
+
+  g_mutex_lock (&cache->mutex);
+  g_hash_table_remove (cache->calendar_zones, gcal_calendar_get_id (calendar));
+  g_mutex_unlock (&cache->mutex);
+}
+
+/**
+ * gcal_time_zone_cache_lookup_builtin_zone:
+ * @tz: a #GTimeZone
+ *
+ * Retrieves the libical builtin time zone matching the identifier
+ * of @tz, falling back to UTC when there is none.
+ *
+ * Returns: (transfer none): an #ICalTimezone
+ */
+ICalTimezone*
+gcal_time_zone_cache_lookup_builtin_zone (GTimeZone *tz)
+{
+  GcalTimeZoneCache *cache;
+  ICalTimezone *zone;
+  const gchar *identifier;
+
+  g_return_val_if_fail (tz != NULL, NULL);
+
+  cache = get_cache ();
+  identifier = g_time_zone_get_identifier (tz);
+
+  g_mutex_lock (&cache->mutex);
+  if (lookup_locked (cache, cache->builtin_zones, identifier, (gpointer *) &zone))
+    {
+      g_mutex_unlock (&cache->mutex);
+      return zone;
+    }
+  g_mutex_unlock (&cache->mutex);
+
+  /* Builtin zones are owned by libical, and live until the process exits */
+  zone = i_cal_timezone_get_builtin_timezone (identifier);
+
+  if (!zone)
+    zone = i_cal_timezone_get_utc_timezone ();
+
+  g_mutex_lock (&cache->mutex);
+  g_hash_table_replace (cache->builtin_zones, g_strdup (identifier), zone);
+  g_mutex_unlock (&cache->mutex);
+
+  return zone;
+}
+
+/**
+ * gcal_time_zone_cache_get_stats:
+ * @out_hits: (out)(optional): return location for the number of hits
+ * @out_misses: (out)(optional): return location for the number of misses
+ *
+ * Retrieves the number of lookups that were served from the cache,
+ * and the number of lookups that had to resolve the time zone.
+ */
+void
+gcal_time_zone_cache_get_stats (guint64 *out_hits,
+                                guint64 *out_misses)
+{
+  GcalTimeZoneCache *cache;
+
+  cache = get_cache ();
+
+  g_mutex_lock (&cache->mutex);
+
+  if (out_hits)
+    *out_hits = cache->hits;
+
+  if (out_misses)
+    *out_misses = cache->misses;
+
+  g_mutex_unlock (&cache->mutex);
+}
+
+/**
+ * gcal_time_zone_cache_clear:
+ *
+ * Drops all cached time zones, and resets the statistics.
+ */
+void
+gcal_time_zone_cache_clear (void)
+{
+  GcalTimeZoneCache *cache;
+
+  cache = get_cache ();
+
+  g_mutex_lock (&cache->mutex);
+
+  g_hash_table_remove_all (cache->identifiers);
+  g_hash_table_remove_all (cache->offsets);
+  g_hash_table_remove_all (cache->calendar_zones);
+  g_hash_table_remove_all (cache->builtin_zones);
+  cache->hits = 0;
+  cache->misses = 0;
+
+  g_mutex_unlock (&cache->mutex);
+}
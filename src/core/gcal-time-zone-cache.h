@@ -0,0 +1,45 @@
+/* gcal-time-zone-cache.h
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <libecal/libecal.h>
+
+#include "gcal-calendar.h"
+
+G_BEGIN_DECLS
+
+GTimeZone*           gcal_time_zone_cache_lookup_identifier      (const gchar        *identifier);
+
+GTimeZone*           gcal_time_zone_cache_lookup_offset          (gint                offset);
+
+ICalTimezone*        gcal_time_zone_cache_lookup_calendar_zone   (GcalCalendar       *calendar,
+                                                                  const gchar        *tzid);
+
+void                 gcal_time_zone_cache_remove_calendar        (GcalCalendar       *calendar);
+
+ICalTimezone*        gcal_time_zone_cache_lookup_builtin_zone    (GTimeZone          *tz);
+
+void                 gcal_time_zone_cache_get_stats              (guint64            *out_hits,
+                                                                  guint64            *out_misses);
+
+void                 gcal_time_zone_cache_clear                  (void);
+
+G_END_DECLS
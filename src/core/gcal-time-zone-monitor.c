@@ -45,6 +45,9 @@ enum
 
 static GParamSpec *properties [N_PROPS];
 
+/* Incremented every time the system time zone changes */
+static guint timezone_serial = 1;
+
 
 /*
  * Callbacks
@@ -57,6 +60,7 @@ on_timedate1_proxy_properties_changed_cb (GcalTimeZoneMonitor *self,
                                           GDBusProxy          *proxy)
 {
   g_autoptr (GVariant) timezone_variant = NULL;
+  g_autoptr (GTimeZone) old_timezone = NULL;
   const gchar *timezone_identifier = NULL;
 
   g_assert (GCAL_IS_TIME_ZONE_MONITOR (self));
@@ -71,11 +75,14 @@ on_timedate1_proxy_properties_changed_cb (GcalTimeZoneMonitor *self,
   if (timezone_variant)
     timezone_identifier = g_variant_get_string (timezone_variant, NULL);
 
-  g_clear_pointer (&self->timezone, g_time_zone_unref);
+  old_timezone = g_steal_pointer (&self->timezone);
   self->timezone = g_time_zone_new_identifier (timezone_identifier);
 
   g_debug ("System timezone is %s", g_time_zone_get_identifier (self->timezone));
 
+  if (g_strcmp0 (g_time_zone_get_identifier (old_timezone), g_time_zone_get_identifier (self->timezone)) != 0)
+    g_atomic_int_inc (&timezone_serial);
+
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_TIMEZONE]);
 }
 
@@ -186,3 +193,18 @@ gcal_time_zone_monitor_get_timezone (GcalTimeZoneMonitor *self)
 
   return self->timezone;
 }
+
+/**
+ * gcal_time_zone_monitor_get_serial:
+ *
+ * Retrieves a process-wide serial that changes every time
+ * the system time zone changes. It can be used to invalidate
+ * cached local dates without listening to any monitor.
+ *
+ * Returns: the time zone serial
+ */
+guint
+gcal_time_zone_monitor_get_serial (void)
+{
+  return (guint) g_atomic_int_get (&timezone_serial);
+}
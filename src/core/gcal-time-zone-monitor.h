@@ -32,4 +32,6 @@ GcalTimeZoneMonitor* gcal_time_zone_monitor_new                  (void);
 
 GTimeZone*           gcal_time_zone_monitor_get_timezone         (GcalTimeZoneMonitor *self);
 
+guint                gcal_time_zone_monitor_get_serial           (void);
+
 G_END_DECLS
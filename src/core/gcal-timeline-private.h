@@ -0,0 +1,33 @@
+/* gcal-timeline-private.h
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "gcal-timeline.h"
+
+G_BEGIN_DECLS
+
+void                 gcal_timeline_add_calendar_events           (GcalTimeline       *self,
+                                                                  GcalCalendar       *calendar,
+                                                                  GListModel         *events);
+
+GListModel*          gcal_timeline_get_events_model              (GcalTimeline       *self);
+
+G_END_DECLS
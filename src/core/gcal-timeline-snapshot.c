@@ -0,0 +1,583 @@
+/* gcal-timeline-snapshot.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GcalTimelineSnapshot"
+
+#include <string.h>
+
+#include "gcal-debug.h"
+#include "gcal-event.h"
+#include "gcal-timeline-snapshot.h"
+
+/*
+ * A compact on-disk copy of the events of the last viewed range, used
+ * to populate the views while the calendars are still being loaded.
+ *
+ * The file is meant to be mapped in memory and used in place. It is
+ * made of a header, a table of calendars, a table of events, and a
+ * pool of NUL-terminated strings, in this order:
+ *
+ *   SnapshotHeader
+ *   SnapshotCalendar[n_calendars]
+ *   SnapshotEvent[n_events]
+ *   gchar strings[strings_size]
+ *
+ * Strings are referenced by their offset in the pool. The first byte
+ * of the pool is always NUL, so offset 0 is the empty string. Every
+ * record is a multiple of 8 bytes, so all tables are naturally aligned
+ * in the mapping.
+ *
+ * Each calendar is stored with its revision, and events of a calendar
+ * are only used if the revision still matches the live calendar. The
+ * file uses the host byte order; a file written with a different byte
+ * order fails the magic check and is ignored, like any other invalid
+ * or outdated file.
+ */
+
+#define SNAPSHOT_MAGIC   0x50534347 /* "GCSP" */
+#define SNAPSHOT_VERSION 1
+
+#define SNAPSHOT_EVENT_ALL_DAY (1 << 0)
+
+typedef struct
+{
+  guint32             magic;
+  guint32             version;
+  gint64              range_start;
+  gint64              range_end;
+  guint32             n_calendars;
+  guint32             n_events;
+  guint32             strings_size;
+  guint32             padding;
+} SnapshotHeader;
+
+typedef struct
+{
+  guint32             id;
+  guint32             revision;
+} SnapshotCalendar;
+
+typedef struct
+{
+  gint64              start;
+  gint64              end;
+  guint32             calendar;
+  guint32             flags;
+  guint32             uid;
+  guint32             rid;
+  guint32             summary;
+  guint32             padding;
+} SnapshotEvent;
+
+G_STATIC_ASSERT (sizeof (SnapshotHeader) % 8 == 0);
+G_STATIC_ASSERT (sizeof (SnapshotCalendar) % 8 == 0);
+G_STATIC_ASSERT (sizeof (SnapshotEvent) % 8 == 0);
+
+struct _GcalTimelineSnapshot
+{
+  GMappedFile        *mapped_file;
+
+  const SnapshotHeader *header;
+  const SnapshotCalendar *calendars;
+  const SnapshotEvent *events;
+  const gchar        *strings;
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static inline const gchar*
+get_string (GcalTimelineSnapshot *self,
+            guint32               offset)
+{
+  return self->strings + offset;
+}
+
+static gboolean
+validate (GcalTimelineSnapshot  *self,
+          gsize                  length,
+          GError               **error)
+{
+  const SnapshotHeader *header;
+  guint32 strings_size;
+  guint64 expected_length;
+
+  if (length < sizeof (SnapshotHeader))
+    goto invalid;
+
+  header = self->header;
+
+  if (header->magic != SNAPSHOT_MAGIC)
+    goto invalid;
+
+  if (header->version != SNAPSHOT_VERSION)
+    {
+      g_set_error (error,
+                   G_IO_ERROR,
+                   G_IO_ERROR_NOT_SUPPORTED,
+                   "Unsupported snapshot version %u",
+                   header->version);
+      return FALSE;
+    }
+
+  strings_size = header->strings_size;
+  expected_length = sizeof (SnapshotHeader) +
+                    (guint64) header->n_calendars * sizeof (SnapshotCalendar) +
+                    (guint64) header->n_events * sizeof (SnapshotEvent) +
+                    strings_size;
+
+  if (expected_length != length || strings_size == 0 || header->range_end < header->range_start)
+    goto invalid;
+
+  self->calendars = (const SnapshotCalendar *) (header + 1);
+  self->events = (const SnapshotEvent *) (self->calendars + header->n_calendars);
+  self->strings = (const gchar *) (self->events + header->n_events);
+
+  if (self->strings[0] != '\0' || self->strings[strings_size - 1] != '\0')
+    goto invalid;
+
+  for (guint32 i = 0; i < header->n_calendars; i++)
+    {
+      if (self->calendars[i].id >= strings_size || self->calendars[i].revision >= strings_size)
+        goto invalid;
+    }
+
+  for (guint32 i = 0; i < header->n_events; i++)
+    {
+      const SnapshotEvent *event = &self->events[i];
+
+      if (event->calendar >= header->n_calendars ||
+          event->uid >= strings_size ||
+          event->rid >= strings_size ||
+          event->summary >= strings_size ||
+          event->end < event->start)
+        {
+          goto invalid;
+        }
+    }
+
+  return TRUE;
+
+invalid:
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Invalid snapshot file");
+  return FALSE;
+}
+
+static ECalComponentDateTime*
+create_component_date_time (gint64   unix_time,
+                            gboolean all_day)
+{
+  ICalTime *itt;
+
+  itt = i_cal_time_new_from_timet_with_zone (unix_time, all_day, i_cal_timezone_get_utc_timezone ());
+
+  return e_cal_component_datetime_new_take (itt, all_day ? NULL : g_strdup ("UTC"));
+}
+
+static ECalComponent*
+create_component (GcalTimelineSnapshot *self,
+                  const SnapshotEvent  *event)
+{
+  ECalComponentDateTime *dt;
+  ECalComponentText *summary;
+  ECalComponent *component;
+  const gchar *rid;
+  gboolean all_day;
+
+  all_day = (event->flags & SNAPSHOT_EVENT_ALL_DAY) != 0;
+
+  component = e_cal_component_new ();
+  e_cal_component_set_new_vtype (component, E_CAL_COMPONENT_EVENT);
+  e_cal_component_set_uid (component, get_string (self, event->uid));
+
+  dt = create_component_date_time (event->start, all_day);
+  e_cal_component_set_dtstart (component, dt);
+  e_cal_component_datetime_free (dt);
+
+  dt = create_component_date_time (event->end, all_day);
+  e_cal_component_set_dtend (component, dt);
+  e_cal_component_datetime_free (dt);
+
+  rid = get_string (self, event->rid);
+  if (*rid != '\0')
+    {
+      ECalComponentRange *recur_id;
+
+      recur_id = e_cal_component_range_new_take (E_CAL_COMPONENT_RANGE_SINGLE,
+                                                 e_cal_component_datetime_new_take (i_cal_time_new_from_string (rid), NULL));
+      e_cal_component_set_recurid (component, recur_id);
+      e_cal_component_range_free (recur_id);
+    }
+
+  summary = e_cal_component_text_new (get_string (self, event->summary), NULL);
+  e_cal_component_set_summary (component, summary);
+  e_cal_component_text_free (summary);
+
+  return component;
+}
+
+static guint32
+add_string (GString     *strings,
+            GHashTable  *offsets,
+            const gchar *string)
+{
+  gpointer offset;
+
+  if (!string || *string == '\0')
+    return 0;
+
+  if (g_hash_table_lookup_extended (offsets, string, NULL, &offset))
+    return GPOINTER_TO_UINT (offset);
+
+  offset = GUINT_TO_POINTER (strings->len);
+  g_string_append_len (strings, string, strlen (string) + 1);
+  g_hash_table_insert (offsets, g_strdup (string), offset);
+
+  return GPOINTER_TO_UINT (offset);
+}
+
+static gint64
+get_event_time (GDateTime *date_time,
+                gboolean   all_day)
+{
+  g_autoptr (GDateTime) utc_date = NULL;
+
+  if (!all_day)
+    return g_date_time_to_unix (date_time);
+
+  /* All day events are stored as the UTC midnight of the same date */
+  utc_date = g_date_time_new_utc (g_date_time_get_year (date_time),
+                                  g_date_time_get_month (date_time),
+                                  g_date_time_get_day_of_month (date_time),
+                                  0, 0, 0);
+
+  return g_date_time_to_unix (utc_date);
+}
+
+
+/*
+ * Public API
+ */
+
+/**
+ * gcal_timeline_snapshot_load:
+ * @path: the path of the snapshot file
+ * @error: (nullable): return location for a #GError
+ *
+ * Maps the snapshot at @path in memory, and validates it.
+ *
+ * Returns: (transfer full)(nullable): a #GcalTimelineSnapshot
+ */
+GcalTimelineSnapshot*
+gcal_timeline_snapshot_load (const gchar  *path,
+                             GError      **error)
+{
+  g_autoptr (GcalTimelineSnapshot) self = NULL;
+  g_autoptr (GMappedFile) mapped_file = NULL;
+  const gchar *contents;
+  gsize length;
+
+  GCAL_ENTRY;
+
+  g_return_val_if_fail (path != NULL, NULL);
+
+  mapped_file = g_mapped_file_new (path, FALSE, error);
+
+  if (!mapped_file)
+    GCAL_RETURN (NULL);
+
+  contents = g_mapped_file_get_contents (mapped_file);
+  length = g_mapped_file_get_length (mapped_file);
+
+  self = g_new0 (GcalTimelineSnapshot, 1);
+  self->mapped_file = g_steal_pointer (&mapped_file);
+  self->header = (const SnapshotHeader *) contents;
+
+  if (!validate (self, length, error))
+    GCAL_RETURN (NULL);
+
+  GCAL_TRACE_MSG ("Loaded snapshot with %u calendars and %u events",
+                  self->header->n_calendars,
+                  self->header->n_events);
+
+  GCAL_RETURN (g_steal_pointer (&self));
+}
+
+/**
+ * gcal_timeline_snapshot_free:
+ * @self: a #GcalTimelineSnapshot
+ *
+ * Unmaps and frees @self. Events created from @self remain valid.
+ */
+void
+gcal_timeline_snapshot_free (GcalTimelineSnapshot *self)
+{
+  g_return_if_fail (self != NULL);
+
+  g_clear_pointer (&self->mapped_file, g_mapped_file_unref);
+  g_free (self);
+}
+
+/**
+ * gcal_timeline_snapshot_get_range:
+ * @self: a #GcalTimelineSnapshot
+ *
+ * Retrieves the range that was visible when @self was saved.
+ *
+ * Returns: (transfer full): a #GcalRange
+ */
+GcalRange*
+gcal_timeline_snapshot_get_range (GcalTimelineSnapshot *self)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+
+  return gcal_range_new_take (g_date_time_new_from_unix_utc (self->header->range_start),
+                              g_date_time_new_from_unix_utc (self->header->range_end),
+                              GCAL_RANGE_DEFAULT);
+}
+
+/**
+ * gcal_timeline_snapshot_get_n_events:
+ * @self: a #GcalTimelineSnapshot
+ *
+ * Retrieves the number of events stored in @self, for all calendars.
+ *
+ * Returns: the number of events
+ */
+guint
+gcal_timeline_snapshot_get_n_events (GcalTimelineSnapshot *self)
+{
+  g_return_val_if_fail (self != NULL, 0);
+
+  return self->header->n_events;
+}
+
+/**
+ * gcal_timeline_snapshot_create_events:
+ * @self: a #GcalTimelineSnapshot
+ * @calendar: a #GcalCalendar
+ * @revision: the current revision of @calendar
+ *
+ * Creates placeholder events for the events of @calendar stored in
+ * @self. If @calendar is not in @self, or if it was stored with a
+ * different revision, %NULL is returned.
+ *
+ * Returns: (transfer full)(nullable): a #GPtrArray of placeholder #GcalEvent
+ */
+GPtrArray*
+gcal_timeline_snapshot_create_events (GcalTimelineSnapshot *self,
+                                      GcalCalendar         *calendar,
+                                      const gchar          *revision)
+{
+  g_autoptr (GPtrArray) events = NULL;
+  const gchar *calendar_id;
+  guint32 calendar_index;
+  gboolean found;
+
+  GCAL_ENTRY;
+
+  g_return_val_if_fail (self != NULL, NULL);
+  g_return_val_if_fail (GCAL_IS_CALENDAR (calendar), NULL);
+
+  if (!revision || *revision == '\0')
+    GCAL_RETURN (NULL);
+
+  calendar_id = gcal_calendar_get_id (calendar);
+  calendar_index = 0;
+  found = FALSE;
+
+  for (guint32 i = 0; i < self->header->n_calendars; i++)
+    {
+      if (g_strcmp0 (get_string (self, self->calendars[i].id), calendar_id) != 0)
+        continue;
+
+      if (g_strcmp0 (get_string (self, self->calendars[i].revision), revision) != 0)
+        {
+          GCAL_TRACE_MSG ("Snapshot of calendar %s is outdated", calendar_id);
+          GCAL_RETURN (NULL);
+        }
+
+      calendar_index = i;
+      found = TRUE;
+      break;
+    }
+
+  if (!found)
+    GCAL_RETURN (NULL);
+
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (guint32 i = 0; i < self->header->n_events; i++)
+    {
+      g_autoptr (GError) error = NULL;
+      ECalComponent *component;
+      GcalEvent *event;
+
+      if (self->events[i].calendar != calendar_index)
+        continue;
+
+      component = create_component (self, &self->events[i]);
+      event = gcal_event_new_take (calendar, component, &error);
+
+      if (error)
+        {
+          g_warning ("Error creating placeholder event: %s", error->message);
+          continue;
+        }
+
+      gcal_event_set_placeholder (event, TRUE);
+      g_ptr_array_add (events, event);
+    }
+
+  GCAL_TRACE_MSG ("Created %u placeholder events for calendar %s", events->len, calendar_id);
+
+  GCAL_RETURN (g_steal_pointer (&events));
+}
+
+/**
+ * gcal_timeline_snapshot_save:
+ * @path: the path of the snapshot file
+ * @range: the visible range
+ * @revisions: (element-type utf8 utf8): calendar id → revision
+ * @events: (element-type GcalEvent): events in @range
+ * @error: (nullable): return location for a #GError
+ *
+ * Writes a snapshot of @events to @path. Only the calendars listed
+ * in @revisions are stored; events of other calendars are skipped.
+ *
+ * Returns: whether the snapshot was written
+ */
+gboolean
+gcal_timeline_snapshot_save (const gchar  *path,
+                             GcalRange    *range,
+                             GHashTable   *revisions,
+                             GPtrArray    *events,
+                             GError      **error)
+{
+  g_autoptr (GHashTable) calendar_indexes = NULL;
+  g_autoptr (GHashTable) string_offsets = NULL;
+  g_autoptr (GDateTime) range_start = NULL;
+  g_autoptr (GDateTime) range_end = NULL;
+  g_autoptr (GByteArray) contents = NULL;
+  g_autoptr (GArray) calendars = NULL;
+  g_autoptr (GArray) snapshot_events = NULL;
+  g_autoptr (GString) strings = NULL;
+  SnapshotHeader header = { 0, };
+  GHashTableIter iter;
+  const gchar *calendar_id;
+  const gchar *revision;
+
+  GCAL_ENTRY;
+
+  g_return_val_if_fail (path != NULL, FALSE);
+  g_return_val_if_fail (range != NULL, FALSE);
+  g_return_val_if_fail (revisions != NULL, FALSE);
+  g_return_val_if_fail (events != NULL, FALSE);
+
+  calendar_indexes = g_hash_table_new (g_str_hash, g_str_equal);
+  string_offsets = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  calendars = g_array_new (FALSE, TRUE, sizeof (SnapshotCalendar));
+  snapshot_events = g_array_sized_new (FALSE, TRUE, sizeof (SnapshotEvent), events->len);
+  strings = g_string_new_len ("", 1);
+
+  g_hash_table_iter_init (&iter, revisions);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &calendar_id, (gpointer *) &revision))
+    {
+      SnapshotCalendar calendar;
+
+      /* Calendars without revisions can't be validated */
+      if (!revision || *revision == '\0')
+        continue;
+
+      calendar.id = add_string (strings, string_offsets, calendar_id);
+      calendar.revision = add_string (strings, string_offsets, revision);
+
+      g_hash_table_insert (calendar_indexes, (gpointer) calendar_id, GUINT_TO_POINTER (calendars->len));
+      g_array_append_val (calendars, calendar);
+    }
+
+  for (guint i = 0; i < events->len; i++)
+    {
+      SnapshotEvent snapshot_event = { 0, };
+      ECalComponentId *id;
+      GcalCalendar *calendar;
+      GcalEvent *event;
+      gpointer calendar_index;
+      gboolean all_day;
+
+      event = g_ptr_array_index (events, i);
+      calendar = gcal_event_get_calendar (event);
+
+      if (gcal_event_is_placeholder (event) || !calendar ||
+          !g_hash_table_lookup_extended (calendar_indexes, gcal_calendar_get_id (calendar), NULL, &calendar_index))
+        {
+          continue;
+        }
+
+      all_day = gcal_event_get_all_day (event);
+      id = e_cal_component_get_id (gcal_event_get_component (event));
+
+      snapshot_event.start = get_event_time (gcal_event_get_date_start (event), all_day);
+      snapshot_event.end = get_event_time (gcal_event_get_date_end (event), all_day);
+      snapshot_event.calendar = GPOINTER_TO_UINT (calendar_index);
+      snapshot_event.flags = all_day ? SNAPSHOT_EVENT_ALL_DAY : 0;
+      snapshot_event.uid = add_string (strings, string_offsets, e_cal_component_id_get_uid (id));
+      snapshot_event.rid = add_string (strings, string_offsets, e_cal_component_id_get_rid (id));
+      snapshot_event.summary = add_string (strings, string_offsets, gcal_event_get_summary (event));
+
+      e_cal_component_id_free (id);
+
+      g_array_append_val (snapshot_events, snapshot_event);
+    }
+
+  /* Keep the total size a multiple of 8 */
+  while (strings->len % 8 != 0)
+    g_string_append_c (strings, '\0');
+
+  range_start = gcal_range_get_start (range);
+  range_end = gcal_range_get_end (range);
+
+  header.magic = SNAPSHOT_MAGIC;
+  header.version = SNAPSHOT_VERSION;
+  header.range_start = g_date_time_to_unix (range_start);
+  header.range_end = g_date_time_to_unix (range_end);
+  header.n_calendars = calendars->len;
+  header.n_events = snapshot_events->len;
+  header.strings_size = strings->len;
+
+  contents = g_byte_array_sized_new (sizeof (SnapshotHeader) +
+                                     calendars->len * sizeof (SnapshotCalendar) +
+                                     snapshot_events->len * sizeof (SnapshotEvent) +
+                                     strings->len);
+
+  g_byte_array_append (contents, (const guint8 *) &header, sizeof (SnapshotHeader));
+  g_byte_array_append (contents, (const guint8 *) calendars->data, calendars->len * sizeof (SnapshotCalendar));
+  g_byte_array_append (contents, (const guint8 *) snapshot_events->data, snapshot_events->len * sizeof (SnapshotEvent));
+  g_byte_array_append (contents, (const guint8 *) strings->str, strings->len);
+
+  GCAL_TRACE_MSG ("Saving snapshot with %u calendars and %u events (%u bytes)",
+                  calendars->len,
+                  snapshot_events->len,
+                  contents->len);
+
+  GCAL_RETURN (g_file_set_contents (path, (const gchar *) contents->data, contents->len, error));
+}
@@ -0,0 +1,51 @@
+/* gcal-timeline-snapshot.h
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "gcal-calendar.h"
+#include "gcal-range.h"
+
+G_BEGIN_DECLS
+
+typedef struct _GcalTimelineSnapshot GcalTimelineSnapshot;
+
+GcalTimelineSnapshot* gcal_timeline_snapshot_load                (const gchar        *path,
+                                                                  GError            **error);
+
+void                 gcal_timeline_snapshot_free                 (GcalTimelineSnapshot *self);
+
+GcalRange*           gcal_timeline_snapshot_get_range            (GcalTimelineSnapshot *self);
+
+guint                gcal_timeline_snapshot_get_n_events         (GcalTimelineSnapshot *self);
+
+GPtrArray*           gcal_timeline_snapshot_create_events        (GcalTimelineSnapshot *self,
+                                                                  GcalCalendar         *calendar,
+                                                                  const gchar          *revision);
+
+gboolean             gcal_timeline_snapshot_save                 (const gchar        *path,
+                                                                  GcalRange          *range,
+                                                                  GHashTable         *revisions,
+                                                                  GPtrArray          *events,
+                                                                  GError            **error);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GcalTimelineSnapshot, gcal_timeline_snapshot_free)
+
+G_END_DECLS
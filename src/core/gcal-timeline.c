@@ -27,11 +27,26 @@
 #include "gcal-event.h"
 #include "gcal-range-tree.h"
 #include "gcal-timeline.h"
+#include "gcal-timeline-private.h"
 #include "gcal-timeline-subscriber.h"
 #include "gcal-utils.h"
 
 #include <libedataserver/libedataserver.h>
 
+#define PENDING_CHANGE_TIMEOUT_SECONDS 10
+
+typedef struct
+{
+  GcalTimeline       *timeline;
+  guint               id;
+  GcalCalendar       *calendar;
+  gchar              *event_id;
+  GcalEvent          *event;
+  GcalEvent          *original;
+  gboolean            applied;
+  guint               timeout_id;
+} PendingChange;
+
 struct _GcalTimeline
 {
   GObject             parent_instance;
@@ -45,16 +60,47 @@ struct _GcalTimeline
   gchar              *filter;
 
   GHashTable         *calendars; /* GcalCalendar* -> GcalCalendarMonitor* */
+  GHashTable         *calendar_events; /* GcalCalendar* -> CalendarEvents* */
   gboolean            complete;
 
+  /* Filtered calendar events, the placeholder stores, and the pending events */
   GListStore         *calendar_monitors;
   GListModel         *events_model;
 
+  /* Optimistic changes, waiting to be confirmed by the calendar monitors */
+  GHashTable         *pending_changes; /* event id -> PendingChange* */
+  GListStore         *pending_events;
+  guint               last_change_id;
+
+  GcalTimelineSnapshot *snapshot;
+  GHashTable         *placeholders; /* GcalCalendar* -> GListStore* */
+
   GHashTable         *subscribers; /* GcalTimelineSubscriber* -> SubscriberData* */
 
   GCancellable       *cancellable;
 };
 
+/*
+ * The events of each calendar are wrapped in their own filter model,
+ * which hides the events with pending changes. Changing pending changes
+ * only refilters the events of one calendar, and only emits the changes
+ * of the hidden or shown events.
+ */
+typedef struct
+{
+  GcalTimeline       *timeline;
+  GcalCalendar       *calendar;
+  GListModel         *events;
+  GtkFilter          *filter;
+  GListModel         *filtered_events;
+} CalendarEvents;
+
+static void          on_calendar_events_items_changed_cb         (GListModel          *model,
+                                                                  guint                position,
+                                                                  guint                removed,
+                                                                  guint                added,
+                                                                  CalendarEvents      *calendar_events);
+
 G_DEFINE_TYPE (GcalTimeline, gcal_timeline, G_TYPE_OBJECT)
 
 enum
@@ -77,6 +123,7 @@ typedef struct
   GcalRange *range;
   GtkFilterListModel *events;
   GtkSortListModel *sorted_events;
+  gboolean paused;
 } SubscriberData;
 
 static void
@@ -164,15 +211,200 @@ subscriber_data_new (GcalTimeline           *self,
   filter = gtk_custom_filter_new (event_in_subscriber_range_func, data, NULL);
   data->events = gtk_filter_list_model_new (g_object_ref (self->events_model), GTK_FILTER (g_steal_pointer (&filter)));
   data->sorted_events = gtk_sort_list_model_new (G_LIST_MODEL (g_object_ref (data->events)),
-                                                 GTK_SORTER (gtk_custom_sorter_new (compare_events_cb, NULL, NULL)));
+                                                 gcal_timeline_new_event_sorter ());
 
   return g_steal_pointer (&data);
 }
 
+/*
+ * PendingChange
+ */
+
+static void
+pending_change_free (PendingChange *change)
+{
+  g_clear_handle_id (&change->timeout_id, g_source_remove);
+  g_clear_object (&change->calendar);
+  g_clear_pointer (&change->event_id, g_free);
+  g_clear_object (&change->event);
+  g_clear_object (&change->original);
+  g_free (change);
+}
+
+/*
+ * The events of the calendar monitors are hidden while there is a
+ * pending change for them. The pending event, if any, is shown in
+ * their place from the unfiltered pending events store.
+ */
+static gboolean
+filter_pending_changes_func (gpointer item,
+                             gpointer user_data)
+{
+  GcalTimeline *self = user_data;
+
+  if (g_hash_table_size (self->pending_changes) == 0)
+    return TRUE;
+
+  return !g_hash_table_contains (self->pending_changes, gcal_event_get_uid (item));
+}
+
+
+/*
+ * CalendarEvents
+ */
+
+static CalendarEvents*
+calendar_events_new (GcalTimeline *self,
+                     GcalCalendar *calendar,
+                     GListModel   *events)
+{
+  CalendarEvents *calendar_events;
+
+  calendar_events = g_new0 (CalendarEvents, 1);
+  calendar_events->timeline = self;
+  calendar_events->calendar = calendar;
+  calendar_events->events = g_object_ref (events);
+  calendar_events->filter = GTK_FILTER (gtk_custom_filter_new (filter_pending_changes_func, self, NULL));
+  calendar_events->filtered_events = G_LIST_MODEL (gtk_filter_list_model_new (g_object_ref (events),
+                                                                              g_object_ref (calendar_events->filter)));
+
+  return calendar_events;
+}
+
+static void
+calendar_events_free (CalendarEvents *calendar_events)
+{
+  g_signal_handlers_disconnect_by_data (calendar_events->events, calendar_events);
+
+  g_clear_object (&calendar_events->filtered_events);
+  g_clear_object (&calendar_events->filter);
+  g_clear_object (&calendar_events->events);
+  g_free (calendar_events);
+}
+
+
 /*
  * Auxiliary methods
  */
 
+static void
+refilter_calendar_events (GcalTimeline     *self,
+                          GcalCalendar     *calendar,
+                          GtkFilterChange   change)
+{
+  CalendarEvents *calendar_events = g_hash_table_lookup (self->calendar_events, calendar);
+
+  if (calendar_events)
+    gtk_filter_changed (calendar_events->filter, change);
+}
+
+/*
+ * Retrieves the event of @calendar with @event_id. Calendar monitors
+ * cache their events; other models are only used by tests, and are
+ * searched.
+ */
+static GcalEvent*
+lookup_calendar_event (CalendarEvents *calendar_events,
+                       const gchar    *event_id)
+{
+  guint n_events;
+
+  if (GCAL_IS_CALENDAR_MONITOR (calendar_events->events))
+    return gcal_calendar_monitor_get_cached_event (GCAL_CALENDAR_MONITOR (calendar_events->events), event_id);
+
+  n_events = g_list_model_get_n_items (calendar_events->events);
+
+  for (guint i = 0; i < n_events; i++)
+    {
+      g_autoptr (GcalEvent) event = g_list_model_get_item (calendar_events->events, i);
+
+      if (g_strcmp0 (gcal_event_get_uid (event), event_id) == 0)
+        return g_steal_pointer (&event);
+    }
+
+  return NULL;
+}
+
+static void
+remove_pending_event (GcalTimeline  *self,
+                      PendingChange *change)
+{
+  guint position;
+
+  if (change->event && g_list_store_find (self->pending_events, change->event, &position))
+    g_list_store_remove (self->pending_events, position);
+}
+
+static void
+drop_pending_change (GcalTimeline  *self,
+                     PendingChange *change)
+{
+  g_autoptr (GcalCalendar) calendar = g_object_ref (change->calendar);
+
+  GCAL_TRACE_MSG ("Dropping pending change %u of event %s", change->id, change->event_id);
+
+  remove_pending_event (self, change);
+  g_hash_table_remove (self->pending_changes, change->event_id);
+
+  refilter_calendar_events (self, calendar, GTK_FILTER_CHANGE_LESS_STRICT);
+}
+
+static gboolean
+is_pending_change_reconciled (GcalTimeline  *self,
+                              PendingChange *change)
+{
+  g_autoptr (GcalEvent) event = NULL;
+  CalendarEvents *calendar_events;
+
+  calendar_events = g_hash_table_lookup (self->calendar_events, change->calendar);
+
+  if (!calendar_events)
+    return TRUE;
+
+  /*
+   * The monitor creates new events when it receives the modified
+   * components, so the change arrived once its event is not the
+   * one that was replaced anymore.
+   */
+  event = lookup_calendar_event (calendar_events, change->event_id);
+
+  return event != change->original;
+}
+
+static void
+reconcile_pending_changes (GcalTimeline *self,
+                           GcalCalendar *calendar)
+{
+  PendingChange *change;
+  GHashTableIter iter;
+  gboolean changed;
+
+  GCAL_ENTRY;
+
+  changed = FALSE;
+
+  g_hash_table_iter_init (&iter, self->pending_changes);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &change))
+    {
+      if (!change->applied || change->calendar != calendar)
+        continue;
+
+      if (!is_pending_change_reconciled (self, change))
+        continue;
+
+      GCAL_TRACE_MSG ("Pending change %u of event %s reconciled", change->id, change->event_id);
+
+      remove_pending_event (self, change);
+      g_hash_table_iter_remove (&iter);
+      changed = TRUE;
+    }
+
+  if (changed)
+    refilter_calendar_events (self, calendar, GTK_FILTER_CHANGE_LESS_STRICT);
+
+  GCAL_EXIT;
+}
+
 static void
 update_completed_calendars (GcalTimeline *self)
 {
@@ -268,6 +500,7 @@ static void
 update_range (GcalTimeline *self)
 {
   GcalTimelineSubscriber *subscriber;
+  SubscriberData *subscriber_data;
   GHashTableIter iter;
   gboolean has_subscribers;
   gboolean range_changed;
@@ -275,18 +508,26 @@ update_range (GcalTimeline *self)
   GCAL_ENTRY;
 
   range_changed = FALSE;
-  has_subscribers = g_hash_table_size (self->subscribers) > 0;
+  has_subscribers = FALSE;
+
+  g_hash_table_iter_init (&iter, self->subscribers);
+  while (!has_subscribers && g_hash_table_iter_next (&iter, NULL, (gpointer*) &subscriber_data))
+    has_subscribers = !subscriber_data->paused;
 
   if (has_subscribers)
     {
       g_autoptr (GcalRange) new_range = NULL;
 
       g_hash_table_iter_init (&iter, self->subscribers);
-      while (g_hash_table_iter_next (&iter, (gpointer*) &subscriber, NULL))
+      while (g_hash_table_iter_next (&iter, (gpointer*) &subscriber, (gpointer*) &subscriber_data))
         {
           g_autoptr (GcalRange) subscriber_range = NULL;
           g_autoptr (GcalRange) union_range = NULL;
 
+          /* Paused subscribers don't keep their range loaded */
+          if (subscriber_data->paused)
+            continue;
+
           subscriber_range = gcal_timeline_subscriber_get_range (subscriber);
 
           if (new_range)
@@ -337,7 +578,7 @@ update_range (GcalTimeline *self)
         }
 
     }
-  else if (self->range)
+  else if (self->range && g_hash_table_size (self->subscribers) == 0)
     {
       g_clear_pointer (&self->range, gcal_range_unref);
       g_clear_pointer (&self->augmented_range, gcal_range_unref);
@@ -419,6 +660,139 @@ update_calendar_monitor_filters (GcalTimeline *self)
     gcal_calendar_monitor_set_filter (monitor, self->filter);
 }
 
+static gchar*
+dup_calendar_revision (GcalCalendar *calendar)
+{
+  g_autofree gchar *revision = NULL;
+  ECalClient *client;
+
+  client = gcal_calendar_get_client (calendar);
+
+  if (!client)
+    return NULL;
+
+  /* The revision is a cached property of the client proxy, so this doesn't block */
+  if (!e_client_get_backend_property_sync (E_CLIENT (client), CLIENT_BACKEND_PROPERTY_REVISION, &revision, NULL, NULL))
+    return NULL;
+
+  return g_steal_pointer (&revision);
+}
+
+static void
+add_placeholders (GcalTimeline        *self,
+                  GcalCalendar        *calendar,
+                  GcalCalendarMonitor *monitor)
+{
+  g_autoptr (GListStore) placeholders = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  g_autofree gchar *revision = NULL;
+
+  GCAL_ENTRY;
+
+  if (!self->snapshot || self->filter || gcal_calendar_monitor_is_complete (monitor))
+    GCAL_RETURN ();
+
+  revision = dup_calendar_revision (calendar);
+  events = gcal_timeline_snapshot_create_events (self->snapshot, calendar, revision);
+
+  if (!events || events->len == 0)
+    GCAL_RETURN ();
+
+  GCAL_TRACE_MSG ("Adding %u placeholders for calendar '%s'", events->len, gcal_calendar_get_name (calendar));
+
+  placeholders = g_list_store_new (GCAL_TYPE_EVENT);
+  g_list_store_splice (placeholders, 0, 0, events->pdata, events->len);
+
+  g_hash_table_insert (self->placeholders, calendar, g_object_ref (placeholders));
+  g_list_store_append (self->calendar_monitors, placeholders);
+
+  GCAL_EXIT;
+}
+
+static void
+remove_placeholders (GcalTimeline *self,
+                     GcalCalendar *calendar)
+{
+  g_autoptr (GListStore) placeholders = NULL;
+  guint position;
+
+  if (!g_hash_table_steal_extended (self->placeholders, calendar, NULL, (gpointer *) &placeholders))
+    return;
+
+  GCAL_TRACE_MSG ("Removing placeholders of calendar '%s'", gcal_calendar_get_name (calendar));
+
+  if (g_list_store_find (self->calendar_monitors, placeholders, &position))
+    g_list_store_remove (self->calendar_monitors, position);
+}
+
+static void
+remove_replaced_placeholders (GcalTimeline *self,
+                              GcalCalendar *calendar,
+                              GListModel   *events,
+                              guint         position,
+                              guint         n_events)
+{
+  g_autoptr (GHashTable) uids = NULL;
+  GListStore *placeholders;
+  guint n_placeholders;
+
+  placeholders = g_hash_table_lookup (self->placeholders, calendar);
+
+  if (!placeholders || n_events == 0)
+    return;
+
+  /* uid -> GcalEvent*, the event keeps the uid string alive */
+  uids = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, g_object_unref);
+
+  for (guint i = position; i < position + n_events; i++)
+    {
+      GcalEvent *event = g_list_model_get_item (events, i);
+
+      /* The uid includes the recurrence id, so instances are matched too */
+      g_hash_table_insert (uids, (gpointer) gcal_event_get_uid (event), event);
+    }
+
+  /* Iterate backwards so positions stay valid while removing */
+  n_placeholders = g_list_model_get_n_items (G_LIST_MODEL (placeholders));
+
+  for (guint i = n_placeholders; i > 0; i--)
+    {
+      g_autoptr (GcalEvent) placeholder = g_list_model_get_item (G_LIST_MODEL (placeholders), i - 1);
+
+      if (g_hash_table_contains (uids, gcal_event_get_uid (placeholder)))
+        g_list_store_remove (placeholders, i - 1);
+    }
+}
+
+static void
+remove_all_placeholders (GcalTimeline *self)
+{
+  g_autoptr (GList) calendars = NULL;
+
+  calendars = g_hash_table_get_keys (self->placeholders);
+
+  for (GList *l = calendars; l; l = l->next)
+    remove_placeholders (self, l->data);
+}
+
+static void
+remove_calendar_events (GcalTimeline *self,
+                        GcalCalendar *calendar)
+{
+  CalendarEvents *calendar_events;
+  guint position;
+
+  calendar_events = g_hash_table_lookup (self->calendar_events, calendar);
+
+  if (!calendar_events)
+    return;
+
+  if (g_list_store_find (self->calendar_monitors, calendar_events->filtered_events, &position))
+    g_list_store_remove (self->calendar_monitors, position);
+
+  g_hash_table_remove (self->calendar_events, calendar);
+}
+
 
 /*
  * Callbacks
@@ -431,11 +805,65 @@ on_calendar_monitor_completed_cb (GcalCalendarMonitor *monitor,
 {
   GCAL_ENTRY;
 
+  /* Sweep up placeholders that no live event replaced, e.g. deleted events */
+  if (gcal_calendar_monitor_is_complete (monitor))
+    {
+      GcalCalendarMonitor *calendar_monitor;
+      GcalCalendar *calendar;
+      GHashTableIter iter;
+
+      g_hash_table_iter_init (&iter, self->calendars);
+      while (g_hash_table_iter_next (&iter, (gpointer*) &calendar, (gpointer*) &calendar_monitor))
+        {
+          if (calendar_monitor == monitor)
+            {
+              remove_placeholders (self, calendar);
+              break;
+            }
+        }
+    }
+
   update_completed_calendars (self);
 
   GCAL_EXIT;
 }
 
+/*
+ * This runs after the filter model of @calendar_events handled the
+ * change, so the flattened events model is up to date, and can be
+ * changed again.
+ */
+static void
+on_calendar_events_items_changed_cb (GListModel     *model,
+                                     guint           position,
+                                     guint           removed,
+                                     guint           added,
+                                     CalendarEvents *calendar_events)
+{
+  GcalTimeline *self = calendar_events->timeline;
+
+  if (g_hash_table_size (self->pending_changes) == 0 && g_hash_table_size (self->placeholders) == 0)
+    return;
+
+  /* Live events replace their placeholders as soon as they arrive */
+  remove_replaced_placeholders (self, calendar_events->calendar, model, position, added);
+  reconcile_pending_changes (self, calendar_events->calendar);
+}
+
+static gboolean
+pending_change_timeout_cb (gpointer user_data)
+{
+  PendingChange *change = user_data;
+
+  GCAL_ENTRY;
+
+  /* The monitor didn't pick the change up, e.g. it's outside its range */
+  change->timeout_id = 0;
+  drop_pending_change (change->timeline, change);
+
+  GCAL_RETURN (G_SOURCE_REMOVE);
+}
+
 static gboolean
 update_timeline_range_in_idle_cb (gpointer user_data)
 {
@@ -452,16 +880,29 @@ update_timeline_range_in_idle_cb (gpointer user_data)
   GCAL_RETURN (G_SOURCE_REMOVE);
 }
 
+static void
+schedule_update_range (GcalTimeline *self)
+{
+  if (self->update_range_idle_id)
+    return;
+
+  self->update_range_idle_id = g_idle_add (update_timeline_range_in_idle_cb, self);
+}
+
 static void
 on_subscriber_range_changed_cb (GcalTimelineSubscriber *subscriber,
                                 GcalTimeline           *self)
 {
-  update_subscriber_range (self, subscriber);
+  SubscriberData *subscriber_data;
 
-  if (self->update_range_idle_id)
+  subscriber_data = g_hash_table_lookup (self->subscribers, subscriber);
+
+  /* The new range is picked up when the subscriber is resumed */
+  if (subscriber_data->paused)
     return;
 
-  self->update_range_idle_id = g_idle_add (update_timeline_range_in_idle_cb, self);
+  update_subscriber_range (self, subscriber);
+  schedule_update_range (self);
 }
 
 
@@ -479,8 +920,13 @@ gcal_timeline_finalize (GObject *object)
 
   g_clear_handle_id (&self->update_range_idle_id, g_source_remove);
 
+  g_clear_pointer (&self->calendar_events, g_hash_table_destroy);
   g_clear_pointer (&self->calendars, g_hash_table_destroy);
   g_clear_pointer (&self->subscribers, g_hash_table_destroy);
+  g_clear_pointer (&self->placeholders, g_hash_table_destroy);
+  g_clear_pointer (&self->pending_changes, g_hash_table_destroy);
+  g_clear_object (&self->pending_events);
+  g_clear_pointer (&self->snapshot, gcal_timeline_snapshot_free);
 
   g_clear_pointer (&self->augmented_range, gcal_range_unref);
   g_clear_pointer (&self->range, gcal_range_unref);
@@ -571,9 +1017,16 @@ gcal_timeline_init (GcalTimeline *self)
 
   self->cancellable = g_cancellable_new ();
   self->calendars = g_hash_table_new_full (NULL, NULL, NULL, g_object_unref);
+  self->calendar_events = g_hash_table_new_full (NULL, NULL, NULL, (GDestroyNotify) calendar_events_free);
   self->subscribers = g_hash_table_new_full (NULL, NULL, g_object_unref, (GDestroyNotify) subscriber_data_free);
+  self->placeholders = g_hash_table_new_full (NULL, NULL, NULL, g_object_unref);
+
+  self->pending_changes = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) pending_change_free);
+  self->pending_events = g_list_store_new (GCAL_TYPE_EVENT);
+
+  self->calendar_monitors = g_list_store_new (G_TYPE_LIST_MODEL);
+  g_list_store_append (self->calendar_monitors, self->pending_events);
 
-  self->calendar_monitors = g_list_store_new (GCAL_TYPE_CALENDAR_MONITOR);
   self->events_model = G_LIST_MODEL (gtk_flatten_list_model_new (g_object_ref (G_LIST_MODEL (self->calendar_monitors))));
 }
 
@@ -638,11 +1091,12 @@ gcal_timeline_add_calendar (GcalTimeline *self,
   monitor = gcal_calendar_monitor_new (calendar);
   g_signal_connect (monitor, "notify::complete", G_CALLBACK (on_calendar_monitor_completed_cb), self);
   g_hash_table_insert (self->calendars, calendar, g_object_ref (monitor));
-  g_list_store_append (self->calendar_monitors, monitor);
+  gcal_timeline_add_calendar_events (self, calendar, G_LIST_MODEL (monitor));
 
   if (self->augmented_range)
     gcal_calendar_monitor_set_range (monitor, self->augmented_range);
 
+  add_placeholders (self, calendar, monitor);
   update_completed_calendars (self);
 
   GCAL_EXIT;
@@ -663,12 +1117,13 @@ gcal_timeline_remove_calendar (GcalTimeline *self,
 
   if (g_hash_table_steal_extended (self->calendars, calendar, NULL, (gpointer *) &calendar_monitor))
     {
-      guint position = 0;
-
       GCAL_TRACE_MSG ("Removing calendar '%s' from timeline %p", gcal_calendar_get_name (calendar), self);
 
-      if (g_list_store_find (self->calendar_monitors, calendar_monitor, &position))
-        g_list_store_remove (self->calendar_monitors, position);
+      remove_placeholders (self, calendar);
+      remove_calendar_events (self, calendar);
+      reconcile_pending_changes (self, calendar);
+
+      g_signal_handlers_disconnect_by_data (calendar_monitor, self);
 
       update_completed_calendars (self);
     }
@@ -732,6 +1187,56 @@ gcal_timeline_remove_subscriber (GcalTimeline           *self,
   GCAL_EXIT;
 }
 
+/**
+ * gcal_timeline_set_subscriber_paused:
+ * @self: a #GcalTimeline
+ * @subscriber: a #GcalTimelineSubscriber
+ * @paused: whether @subscriber is paused
+ *
+ * Pauses or resumes @subscriber. Paused subscribers don't receive
+ * any events, and their range is not loaded by @self. When resumed,
+ * the subscriber range is read again and its events model is refilled.
+ *
+ * This is meant for subscribers that are temporarily hidden.
+ */
+void
+gcal_timeline_set_subscriber_paused (GcalTimeline           *self,
+                                     GcalTimelineSubscriber *subscriber,
+                                     gboolean                paused)
+{
+  SubscriberData *subscriber_data;
+
+  g_return_if_fail (GCAL_IS_TIMELINE (self));
+  g_return_if_fail (GCAL_IS_TIMELINE_SUBSCRIBER (subscriber));
+
+  GCAL_ENTRY;
+
+  subscriber_data = g_hash_table_lookup (self->subscribers, subscriber);
+
+  if (!subscriber_data || subscriber_data->paused == !!paused)
+    GCAL_RETURN ();
+
+  GCAL_TRACE_MSG ("%s subscriber %s", paused ? "Pausing" : "Resuming", G_OBJECT_TYPE_NAME (subscriber));
+
+  subscriber_data->paused = !!paused;
+
+  if (paused)
+    {
+      gtk_filter_list_model_set_model (subscriber_data->events, NULL);
+    }
+  else
+    {
+      g_clear_pointer (&subscriber_data->range, gcal_range_unref);
+      subscriber_data->range = gcal_timeline_subscriber_get_range (subscriber);
+
+      gtk_filter_list_model_set_model (subscriber_data->events, self->events_model);
+    }
+
+  schedule_update_range (self);
+
+  GCAL_EXIT;
+}
+
 const gchar*
 gcal_timeline_get_filter (GcalTimeline *self)
 {
@@ -756,6 +1261,8 @@ gcal_timeline_set_filter (GcalTimeline *self,
   g_clear_pointer (&self->filter, g_free);
   self->filter = g_strdup (filter);
 
+  /* Placeholders don't know about filters */
+  remove_all_placeholders (self);
   update_calendar_monitor_filters (self);
 
   GCAL_EXIT;
@@ -768,3 +1275,344 @@ gcal_timeline_is_complete (GcalTimeline *self)
 
   return self->complete;
 }
+
+/**
+ * gcal_timeline_new_event_sorter:
+ *
+ * Creates the sorter used to sort the events of each subscriber:
+ * multiday events first, then by start date, longer events first,
+ * and most recently modified events first.
+ *
+ * Returns: (transfer full): a #GtkSorter
+ */
+GtkSorter*
+gcal_timeline_new_event_sorter (void)
+{
+  return GTK_SORTER (gtk_custom_sorter_new (compare_events_cb, NULL, NULL));
+}
+
+/**
+ * gcal_timeline_set_snapshot:
+ * @self: a #GcalTimeline
+ * @snapshot: (transfer full)(nullable): a #GcalTimelineSnapshot
+ *
+ * Sets the snapshot that @self uses to show placeholder events for
+ * calendars that are added while their events are still loading.
+ * Placeholders of a calendar are removed once its events are loaded.
+ *
+ * Setting a %NULL snapshot releases the current one, but doesn't
+ * remove placeholders already in @self.
+ */
+void
+gcal_timeline_set_snapshot (GcalTimeline         *self,
+                            GcalTimelineSnapshot *snapshot)
+{
+  g_return_if_fail (GCAL_IS_TIMELINE (self));
+
+  GCAL_ENTRY;
+
+  g_clear_pointer (&self->snapshot, gcal_timeline_snapshot_free);
+  self->snapshot = snapshot;
+
+  GCAL_EXIT;
+}
+
+/**
+ * gcal_timeline_save_snapshot:
+ * @self: a #GcalTimeline
+ * @path: the path of the snapshot file
+ * @error: (nullable): return location for a #GError
+ *
+ * Saves the events of the visible calendars in the current range
+ * of @self to @path. Calendars that are not completely loaded are
+ * not saved.
+ *
+ * Returns: whether the snapshot was saved
+ */
+gboolean
+gcal_timeline_save_snapshot (GcalTimeline  *self,
+                             const gchar   *path,
+                             GError       **error)
+{
+  g_autoptr (GHashTable) revisions = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  GcalCalendarMonitor *monitor;
+  GcalCalendar *calendar;
+  GHashTableIter iter;
+
+  g_return_val_if_fail (GCAL_IS_TIMELINE (self), FALSE);
+  g_return_val_if_fail (path != NULL, FALSE);
+
+  GCAL_ENTRY;
+
+  if (!self->range)
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_INITIALIZED, "Timeline has no range");
+      GCAL_RETURN (FALSE);
+    }
+
+  /* Filtered monitors don't have all events */
+  if (self->filter)
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Timeline is filtered");
+      GCAL_RETURN (FALSE);
+    }
+
+  revisions = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, g_free);
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+
+  g_hash_table_iter_init (&iter, self->calendars);
+  while (g_hash_table_iter_next (&iter, (gpointer*) &calendar, (gpointer*) &monitor))
+    {
+      guint n_events;
+
+      if (!gcal_calendar_get_visible (calendar) || !gcal_calendar_monitor_is_complete (monitor))
+        continue;
+
+      g_hash_table_insert (revisions,
+                           (gpointer) gcal_calendar_get_id (calendar),
+                           dup_calendar_revision (calendar));
+
+      n_events = g_list_model_get_n_items (G_LIST_MODEL (monitor));
+
+      for (guint i = 0; i < n_events; i++)
+        {
+          g_autoptr (GcalEvent) event = g_list_model_get_item (G_LIST_MODEL (monitor), i);
+
+          if (gcal_event_overlaps (event, self->range))
+            g_ptr_array_add (events, g_steal_pointer (&event));
+        }
+    }
+
+  GCAL_RETURN (gcal_timeline_snapshot_save (path, self->range, revisions, events, error));
+}
+
+/**
+ * gcal_timeline_add_pending_change:
+ * @self: a #GcalTimeline
+ * @calendar: the #GcalCalendar of the event
+ * @event_id: the id of the changed event
+ * @event: (nullable): the new version of the event, or %NULL if it was removed
+ *
+ * Shows a change to an event before it is saved. Until the change is
+ * resolved, the events of @calendar with @event_id are hidden from the
+ * subscribers, and @event, if any, is shown in their place.
+ *
+ * A newer change to the same event replaces the previous one.
+ *
+ * Returns: an identifier of the change, to be passed to
+ *   gcal_timeline_resolve_pending_change()
+ */
+guint
+gcal_timeline_add_pending_change (GcalTimeline *self,
+                                  GcalCalendar *calendar,
+                                  const gchar  *event_id,
+                                  GcalEvent    *event)
+{
+  CalendarEvents *calendar_events;
+  PendingChange *change;
+
+  g_return_val_if_fail (GCAL_IS_TIMELINE (self), 0);
+  g_return_val_if_fail (GCAL_IS_CALENDAR (calendar), 0);
+  g_return_val_if_fail (event_id != NULL, 0);
+  g_return_val_if_fail (!event || GCAL_IS_EVENT (event), 0);
+
+  GCAL_ENTRY;
+
+  change = g_hash_table_lookup (self->pending_changes, event_id);
+
+  if (change)
+    {
+      g_autoptr (GcalCalendar) previous_calendar = g_object_ref (change->calendar);
+
+      remove_pending_event (self, change);
+      g_hash_table_remove (self->pending_changes, event_id);
+
+      if (previous_calendar != calendar)
+        refilter_calendar_events (self, previous_calendar, GTK_FILTER_CHANGE_LESS_STRICT);
+    }
+
+  calendar_events = g_hash_table_lookup (self->calendar_events, calendar);
+
+  change = g_new0 (PendingChange, 1);
+  change->timeline = self;
+  change->id = ++self->last_change_id;
+  change->calendar = g_object_ref (calendar);
+  change->event_id = g_strdup (event_id);
+  change->event = event ? g_object_ref (event) : NULL;
+  change->original = calendar_events ? lookup_calendar_event (calendar_events, event_id) : NULL;
+
+  GCAL_TRACE_MSG ("Adding pending change %u of event %s", change->id, event_id);
+
+  g_hash_table_insert (self->pending_changes, change->event_id, change);
+
+  if (event)
+    g_list_store_append (self->pending_events, event);
+
+  refilter_calendar_events (self, calendar, GTK_FILTER_CHANGE_MORE_STRICT);
+
+  GCAL_RETURN (change->id);
+}
+
+/**
+ * gcal_timeline_set_pending_change_event_id:
+ * @self: a #GcalTimeline
+ * @change_id: the identifier of the change
+ * @event_id: the new id of the changed event
+ *
+ * Changes the event id of the pending change identified by
+ * @change_id, e.g. when the calendar backend assigned a different
+ * uid to a created event. The events with @event_id are hidden
+ * instead of the ones with the previous id.
+ *
+ * Doesn't do anything if the change was replaced by a newer one.
+ */
+void
+gcal_timeline_set_pending_change_event_id (GcalTimeline *self,
+                                           guint         change_id,
+                                           const gchar  *event_id)
+{
+  CalendarEvents *calendar_events;
+  PendingChange *change = NULL;
+  GHashTableIter iter;
+
+  g_return_if_fail (GCAL_IS_TIMELINE (self));
+  g_return_if_fail (event_id != NULL);
+
+  GCAL_ENTRY;
+
+  g_hash_table_iter_init (&iter, self->pending_changes);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &change))
+    {
+      if (change->id == change_id)
+        break;
+
+      change = NULL;
+    }
+
+  if (!change || g_strcmp0 (change->event_id, event_id) == 0)
+    GCAL_RETURN ();
+
+  /* Another change to the new id already hides these events */
+  if (g_hash_table_contains (self->pending_changes, event_id))
+    {
+      drop_pending_change (self, change);
+      GCAL_RETURN ();
+    }
+
+  GCAL_TRACE_MSG ("Pending change %u of event %s is now for event %s", change->id, change->event_id, event_id);
+
+  g_hash_table_steal (self->pending_changes, change->event_id);
+
+  g_clear_pointer (&change->event_id, g_free);
+  change->event_id = g_strdup (event_id);
+
+  calendar_events = g_hash_table_lookup (self->calendar_events, change->calendar);
+  g_clear_object (&change->original);
+  change->original = calendar_events ? lookup_calendar_event (calendar_events, event_id) : NULL;
+
+  g_hash_table_insert (self->pending_changes, change->event_id, change);
+
+  refilter_calendar_events (self, change->calendar, GTK_FILTER_CHANGE_DIFFERENT);
+
+  GCAL_EXIT;
+}
+
+/*
+ * gcal_timeline_add_calendar_events:
+ * @self: a #GcalTimeline
+ * @calendar: a #GcalCalendar
+ * @events: (element-type GcalEvent): the events of @calendar
+ *
+ * Adds @events to the events of @self, hiding the events with pending
+ * changes. This is where the calendar monitors are added; tests use
+ * it to add plain stores.
+ */
+void
+gcal_timeline_add_calendar_events (GcalTimeline *self,
+                                   GcalCalendar *calendar,
+                                   GListModel   *events)
+{
+  CalendarEvents *calendar_events;
+
+  g_return_if_fail (GCAL_IS_TIMELINE (self));
+  g_return_if_fail (GCAL_IS_CALENDAR (calendar));
+  g_return_if_fail (G_IS_LIST_MODEL (events));
+  g_return_if_fail (!g_hash_table_contains (self->calendar_events, calendar));
+
+  calendar_events = calendar_events_new (self, calendar, events);
+  g_hash_table_insert (self->calendar_events, calendar, calendar_events);
+  g_list_store_append (self->calendar_monitors, calendar_events->filtered_events);
+
+  /*
+   * Handlers of the timeline change the flattened events model, so they
+   * must only run once it picked this change up through the filter model.
+   */
+  g_signal_connect_after (events, "items-changed", G_CALLBACK (on_calendar_events_items_changed_cb), calendar_events);
+}
+
+/*
+ * gcal_timeline_get_events_model:
+ * @self: a #GcalTimeline
+ *
+ * Retrieves the events of all calendars of @self, the placeholders,
+ * and the pending events, before they are filtered by subscribers.
+ *
+ * Returns: (transfer none): a #GListModel
+ */
+GListModel*
+gcal_timeline_get_events_model (GcalTimeline *self)
+{
+  g_return_val_if_fail (GCAL_IS_TIMELINE (self), NULL);
+
+  return self->events_model;
+}
+
+/**
+ * gcal_timeline_resolve_pending_change:
+ * @self: a #GcalTimeline
+ * @change_id: the identifier of the change
+ * @applied: whether the change was saved
+ *
+ * Resolves the pending change identified by @change_id. If it wasn't
+ * @applied, it is dropped right away and the previous version of the
+ * event is shown again. Otherwise, it is dropped once the calendar
+ * monitor picks the saved event up.
+ *
+ * Resolving a change that was replaced by a newer one does nothing.
+ */
+void
+gcal_timeline_resolve_pending_change (GcalTimeline *self,
+                                      guint         change_id,
+                                      gboolean      applied)
+{
+  PendingChange *change = NULL;
+  GHashTableIter iter;
+
+  g_return_if_fail (GCAL_IS_TIMELINE (self));
+
+  GCAL_ENTRY;
+
+  g_hash_table_iter_init (&iter, self->pending_changes);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &change))
+    {
+      if (change->id == change_id)
+        break;
+
+      change = NULL;
+    }
+
+  if (!change)
+    GCAL_RETURN ();
+
+  if (!applied || is_pending_change_reconciled (self, change))
+    {
+      drop_pending_change (self, change);
+      GCAL_RETURN ();
+    }
+
+  change->applied = TRUE;
+  change->timeout_id = g_timeout_add_seconds (PENDING_CHANGE_TIMEOUT_SECONDS, pending_change_timeout_cb, change);
+
+  GCAL_EXIT;
+}
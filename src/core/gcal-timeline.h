@@ -20,9 +20,10 @@
 
 #pragma once
 
+#include "gcal-timeline-snapshot.h"
 #include "gcal-types.h"
 
-#include <glib-object.h>
+#include <gtk/gtk.h>
 
 G_BEGIN_DECLS
 
@@ -45,6 +46,10 @@ void                 gcal_timeline_add_subscriber                (GcalTimeline
 void                 gcal_timeline_remove_subscriber             (GcalTimeline           *self,
                                                                   GcalTimelineSubscriber *subscriber);
 
+void                 gcal_timeline_set_subscriber_paused         (GcalTimeline           *self,
+                                                                  GcalTimelineSubscriber *subscriber,
+                                                                  gboolean                paused);
+
 GPtrArray*           gcal_timeline_get_events_at_range           (GcalTimeline       *self,
                                                                   GDateTime          *range_start,
                                                                   GDateTime          *range_end);
@@ -56,4 +61,26 @@ void                 gcal_timeline_set_filter                    (GcalTimeline
 
 gboolean             gcal_timeline_is_complete                   (GcalTimeline       *self);
 
+GtkSorter*           gcal_timeline_new_event_sorter              (void);
+
+void                 gcal_timeline_set_snapshot                  (GcalTimeline         *self,
+                                                                  GcalTimelineSnapshot *snapshot);
+
+gboolean             gcal_timeline_save_snapshot                 (GcalTimeline       *self,
+                                                                  const gchar        *path,
+                                                                  GError            **error);
+
+guint                gcal_timeline_add_pending_change            (GcalTimeline       *self,
+                                                                  GcalCalendar       *calendar,
+                                                                  const gchar        *event_id,
+                                                                  GcalEvent          *event);
+
+void                 gcal_timeline_set_pending_change_event_id   (GcalTimeline       *self,
+                                                                  guint               change_id,
+                                                                  const gchar        *event_id);
+
+void                 gcal_timeline_resolve_pending_change        (GcalTimeline       *self,
+                                                                  guint               change_id,
+                                                                  gboolean            applied);
+
 G_END_DECLS
@@ -695,6 +695,7 @@ gcal_event_editor_dialog_present_event (GcalEventEditorDialog *self,
                                         gboolean               new_event)
 {
   g_return_if_fail (GCAL_IS_EVENT_EDITOR_DIALOG (self));
+  g_return_if_fail (!gcal_event_is_placeholder (event));
 
   set_event (self, event, new_event);
 
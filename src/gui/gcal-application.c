@@ -26,6 +26,7 @@
 #include "gcal-debug.h"
 #include "gcal-log.h"
 #include "gcal-shell-search-provider.h"
+#include "gcal-startup-profile.h"
 #include "gcal-window.h"
 
 #include <glib.h>
@@ -77,6 +78,11 @@ static GOptionEntry gcal_application_goptions[] = {
     G_OPTION_ARG_STRING, NULL,
     N_("Open calendar showing the passed event"), NULL
   },
+  {
+    "startup-profile", 0, 0,
+    G_OPTION_ARG_NONE, NULL,
+    N_("Print how long each startup stage took"), NULL
+  },
   { NULL }
 };
 
@@ -94,6 +100,15 @@ static GParamSpec* properties[N_PROPS] = { NULL, };
  * Callbacks
  */
 
+static void
+on_window_after_paint_cb (GdkFrameClock   *frame_clock,
+                          GcalApplication *self)
+{
+  gcal_startup_profile_mark (GCAL_STARTUP_STAGE_FIRST_FRAME);
+
+  g_signal_handlers_disconnect_by_func (frame_clock, on_window_after_paint_cb, self);
+}
+
 static void
 gcal_application_open_event (GSimpleAction *sync,
                              GVariant      *parameter,
@@ -321,6 +336,8 @@ gcal_application_activate (GApplication *application)
 
   if (!self->window)
     {
+      GdkFrameClock *frame_clock;
+
       if (!self->initial_date)
         self->initial_date = g_date_time_new_now (gcal_context_get_timezone (self->context));
 
@@ -329,8 +346,15 @@ gcal_application_activate (GApplication *application)
                                     "active-date", self->initial_date,
                                     NULL);
 
+      gcal_startup_profile_mark (GCAL_STARTUP_STAGE_WINDOW_CREATED);
+
       g_object_add_weak_pointer (G_OBJECT (self->window), (gpointer*) &self->window);
       gtk_widget_set_visible (self->window, TRUE);
+
+      frame_clock = gtk_widget_get_frame_clock (self->window);
+
+      if (frame_clock)
+        g_signal_connect_object (frame_clock, "after-paint", G_CALLBACK (on_window_after_paint_cb), self, 0);
     }
 
   gtk_window_present (GTK_WINDOW (self->window));
@@ -364,6 +388,8 @@ gcal_application_startup (GApplication *app)
 
   GCAL_ENTRY;
 
+  gcal_startup_profile_mark (GCAL_STARTUP_STAGE_APPLICATION_STARTUP);
+
   self = GCAL_APPLICATION (app);
 
   gtk_window_set_default_icon_name (APPLICATION_ID);
@@ -383,7 +409,11 @@ gcal_application_startup (GApplication *app)
       g_application_set_inactivity_timeout (app, 3 * 60 * 1000);
     }
 
-  /* Startup the manager */
+  /*
+   * Startup the manager. This only starts connecting to the calendar
+   * registry, so that the window can be shown before any calendar is
+   * loaded.
+   */
   gcal_context_startup (self->context);
 
   GCAL_EXIT;
@@ -402,6 +432,9 @@ gcal_application_shutdown (GApplication *app)
   weather_service = gcal_context_get_weather_service (self->context);
   gcal_weather_service_stop (weather_service);
 
+  /* Print whatever was reached, if the profile wasn't printed yet */
+  gcal_startup_profile_print ();
+
   G_APPLICATION_CLASS (gcal_application_parent_class)->shutdown (app);
 
   GCAL_EXIT;
@@ -510,6 +543,8 @@ gcal_application_handle_local_options (GApplication *app,
   if (g_variant_dict_contains (options, "debug"))
     gcal_log_init ();
 
+  gcal_startup_profile_init (g_variant_dict_contains (options, "startup-profile"));
+
   if (show_version)
     {
       g_print ("gnome-calendar: Version %s\n", PACKAGE_VERSION);
@@ -21,6 +21,7 @@
 #define G_LOG_DOMAIN "GcalEventPopover"
 
 #include "gcal-calendar.h"
+#include "gcal-date-format-cache.h"
 #include "gcal-debug.h"
 #include "gcal-event-popover.h"
 #include "gcal-meeting-row.h"
@@ -94,28 +95,11 @@ get_number_of_days_from_today (GDateTime *now,
   return g_date_days_between (&today, &event_day);
 }
 
-static gchar*
+static const gchar*
 format_time (GcalEventPopover *self,
              GDateTime        *date)
 {
-  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
-  GcalTimeFormat time_format;
-
-  time_format = gcal_context_get_time_format (context);
-
-  switch (time_format)
-    {
-    case GCAL_TIME_FORMAT_12H:
-      return g_date_time_format (date, "%I:%M %P");
-
-    case GCAL_TIME_FORMAT_24H:
-      return g_date_time_format (date, "%R");
-
-    default:
-      g_assert_not_reached ();
-    }
-
-  return NULL;
+  return gcal_date_format_cache_format_time (date, gcal_date_format_cache_get_hour_format ());
 }
 
 static const gchar*
@@ -146,15 +130,16 @@ format_multiday_date (GcalEventPopover *self,
                       gboolean          force_show_year,
                       gboolean          show_time)
 {
-  g_autoptr (GDateTime) now = NULL;
+  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  GDateTime *now;
   gint n_days_from_dt;
 
-  now = g_date_time_new_now_local ();
+  now = gcal_clock_get_now (gcal_context_get_clock (context));
   n_days_from_dt = get_number_of_days_from_today (now, dt);
 
   if (show_time)
     {
-      g_autofree gchar *hours = format_time (self, dt);
+      const gchar *hours = format_time (self, dt);
 
       if (n_days_from_dt == 0)
         {
@@ -244,16 +229,17 @@ format_single_day (GcalEventPopover *self,
                    GDateTime        *end_dt,
                    gboolean          show_time)
 {
-  g_autoptr (GDateTime) now = NULL;
+  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  GDateTime *now;
   gint n_days_from_dt;
 
-  now = g_date_time_new_now_local ();
+  now = gcal_clock_get_now (gcal_context_get_clock (context));
   n_days_from_dt = get_number_of_days_from_today (now, start_dt);
 
   if (show_time)
     {
-      g_autofree gchar *start_hours = format_time (self, start_dt);
-      g_autofree gchar *end_hours = format_time (self, end_dt);
+      const gchar *start_hours = format_time (self, start_dt);
+      const gchar *end_hours = format_time (self, end_dt);
 
       if (n_days_from_dt == 0)
         {
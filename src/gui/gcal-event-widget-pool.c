@@ -27,6 +27,7 @@
 #include "gcal-event-widget-pool.h"
 
 #define N_PREALLOCATED_EVENT_WIDGETS 600
+#define N_EVENT_WIDGETS_PER_IDLE 25
 
 #define GDK_ARRAY_TYPE_NAME GcalEventWidgets
 #define GDK_ARRAY_NAME gcal_event_widgets
@@ -46,9 +47,11 @@ G_STATIC_ASSERT (N_PREALLOCATED_EVENT_WIDGETS > 0);
  * case, we instantiate hundreds of GcalEventWidgets often. This takes
  * a considerable time and affects the performance of the application.
  *
- * When GcalEventWidgetPool is created, it pre-allocates a number of
- * GcalEventWidgets. Consumers can then take event widgets from the
- * pool, and then return these event widgets back when they're unused.
+ * When GcalEventWidgetPool is created, it starts pre-allocating a number
+ * of GcalEventWidgets in small, low priority idle batches, so that the
+ * pre-allocation does not delay the first frames of the window. Consumers
+ * can then take event widgets from the pool, and then return these event
+ * widgets back when they're unused.
  */
 
 struct _GcalEventWidgetPool
@@ -56,11 +59,52 @@ struct _GcalEventWidgetPool
   GObject parent_instance;
 
   GcalEventWidgets event_widgets;
+
+  guint n_preallocated;
+  guint preallocate_id;
+  gdouble preallocate_time;
 };
 
 G_DEFINE_FINAL_TYPE (GcalEventWidgetPool, gcal_event_widget_pool, G_TYPE_OBJECT)
 
 
+/*
+ * Callbacks
+ */
+
+static gboolean
+preallocate_event_widgets_cb (gpointer user_data)
+{
+  GcalEventWidgetPool *self = GCAL_EVENT_WIDGET_POOL (user_data);
+  g_autoptr (GTimer) timer = g_timer_new ();
+
+  g_timer_start (timer);
+  for (size_t i = 0; i < N_EVENT_WIDGETS_PER_IDLE && self->n_preallocated < N_PREALLOCATED_EVENT_WIDGETS; i++)
+    {
+      g_autoptr (GcalEventWidget) event_widget = NULL;
+
+      event_widget = g_object_new (GCAL_TYPE_EVENT_WIDGET, NULL);
+      g_object_ref_sink (event_widget);
+
+      gcal_event_widgets_append (&self->event_widgets, g_steal_pointer (&event_widget));
+      self->n_preallocated++;
+    }
+  g_timer_stop (timer);
+
+  self->preallocate_time += g_timer_elapsed (timer, NULL);
+
+  if (self->n_preallocated < N_PREALLOCATED_EVENT_WIDGETS)
+    return G_SOURCE_CONTINUE;
+
+  g_debug ("Initialized %u event widgets in %lf seconds",
+           N_PREALLOCATED_EVENT_WIDGETS,
+           self->preallocate_time);
+
+  self->preallocate_id = 0;
+  return G_SOURCE_REMOVE;
+}
+
+
 /*
  * GObject overrides
  */
@@ -70,6 +114,7 @@ gcal_event_widget_pool_finalize (GObject *object)
 {
   GcalEventWidgetPool *self = GCAL_EVENT_WIDGET_POOL (object);
 
+  g_clear_handle_id (&self->preallocate_id, g_source_remove);
   gcal_event_widgets_clear (&self->event_widgets);
 
   G_OBJECT_CLASS (gcal_event_widget_pool_parent_class)->finalize (object);
@@ -86,23 +131,7 @@ gcal_event_widget_pool_class_init (GcalEventWidgetPoolClass *klass)
 static void
 gcal_event_widget_pool_init (GcalEventWidgetPool *self)
 {
-  g_autoptr (GTimer) timer = g_timer_new ();
-
-  g_timer_start (timer);
-  for (size_t i = 0; i < N_PREALLOCATED_EVENT_WIDGETS; i++)
-    {
-      g_autoptr (GcalEventWidget) event_widget = NULL;
-
-      event_widget = g_object_new (GCAL_TYPE_EVENT_WIDGET, NULL);
-      g_object_ref_sink (event_widget);
-
-      gcal_event_widgets_append (&self->event_widgets, g_steal_pointer (&event_widget));
-    }
-  g_timer_stop (timer);
-
-  g_debug ("Initialized %u event widgets in %lf seconds",
-           N_PREALLOCATED_EVENT_WIDGETS,
-           g_timer_elapsed (timer, NULL));
+  self->preallocate_id = g_idle_add_full (G_PRIORITY_LOW, preallocate_event_widgets_cb, self, NULL);
 }
 
 /**
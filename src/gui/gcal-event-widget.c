@@ -25,6 +25,7 @@
 #include "gcal-fading-label.h"
 #include "gcal-application.h"
 #include "gcal-clock.h"
+#include "gcal-date-format-cache.h"
 #include "gcal-debug.h"
 #include "gcal-event-popover.h"
 #include "gcal-event-widget.h"
@@ -63,7 +64,7 @@ struct _GcalEventWidget
   GtkWidget          *preview_popover;
 
   /* internal data */
-  gchar              *css_class;
+  const gchar        *css_class;
 
   GcalEvent          *event;
 
@@ -181,37 +182,44 @@ gcal_event_widget_update_style (GcalEventWidget *self)
 }
 
 static void
-update_color (GcalEventWidget *self)
+update_dimmed (GcalEventWidget *self)
 {
-  GdkRGBA *color;
-  GQuark color_id;
-  gchar *color_str;
-  gchar *css_class;
+  GcalContext *context;
   GDateTime *now;
-  gint date_compare;
 
-  color = gcal_event_get_color (self->event);
-  now = g_date_time_new_now_local ();
-  date_compare = g_date_time_compare (self->dt_end, now);
+  context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  now = gcal_clock_get_now (gcal_context_get_clock (context));
 
   /* Fades out an event that's earlier than the current date */
-  if (date_compare < 0)
+  if (g_date_time_compare (self->dt_end, now) < 0)
     gtk_widget_add_css_class (GTK_WIDGET (self), "dimmed");
   else
     gtk_widget_remove_css_class (GTK_WIDGET (self), "dimmed");
+}
 
-  /* Remove the old style class */
-  if (self->css_class)
+static void
+update_color (GcalEventWidget *self)
+{
+  GcalCalendar *calendar;
+  const gchar *css_class;
+  GdkRGBA *color;
+
+  calendar = gcal_event_get_calendar (self->event);
+  css_class = calendar ? gcal_calendar_get_color_css_class (calendar) : NULL;
+
+  /* The style class is interned and shared with the calendar */
+  if (self->css_class != css_class)
     {
-      gtk_widget_remove_css_class (GTK_WIDGET (self), self->css_class);
-      g_clear_pointer (&self->css_class, g_free);
-    }
+      if (self->css_class)
+        gtk_widget_remove_css_class (GTK_WIDGET (self), self->css_class);
 
-  color_str = gdk_rgba_to_string (color);
-  color_id = g_quark_from_string (color_str);
-  css_class = g_strdup_printf ("color-%d", color_id);
+      if (css_class)
+        gtk_widget_add_css_class (GTK_WIDGET (self), css_class);
 
-  gtk_widget_add_css_class (GTK_WIDGET (self), css_class);
+      self->css_class = css_class;
+    }
+
+  color = gcal_event_get_color (self->event);
 
   if (INTENSITY (color) > 0.5)
     {
@@ -223,12 +231,6 @@ update_color (GcalEventWidget *self)
       gtk_widget_remove_css_class (GTK_WIDGET (self), "color-light");
       gtk_widget_add_css_class (GTK_WIDGET (self), "color-dark");
     }
-
-  /* Keep the current style around, so we can remove it later */
-  self->css_class = css_class;
-
-  g_clear_pointer (&now, g_date_time_unref);
-  g_free (color_str);
 }
 
 static void
@@ -244,7 +246,6 @@ gcal_event_widget_set_event_tooltip (GcalEventWidget *self,
   GString *tooltip_mesg;
   gboolean allday, multiday, is_ltr;
   guint description_len;
-  GcalContext *context;
 
   tooltip_mesg = g_string_new (NULL);
   escaped_summary = g_markup_escape_text (gcal_event_get_summary (event), -1);
@@ -263,82 +264,58 @@ gcal_event_widget_set_event_tooltip (GcalEventWidget *self,
 
       if (multiday)
         {
-          start = g_date_time_format (tooltip_start, "%x");
-          end = g_date_time_format (tooltip_end, "%x");
+          start = g_strdup (gcal_date_format_cache_format_date (tooltip_start, "%x"));
+          end = g_strdup (gcal_date_format_cache_format_date (tooltip_end, "%x"));
         }
       else
         {
-          start = g_date_time_format (tooltip_start, "%x");
+          start = g_strdup (gcal_date_format_cache_format_date (tooltip_start, "%x"));
           end = NULL;
         }
     }
   else
     {
-      context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+      const gchar *start_date;
+      const gchar *start_time;
+      const gchar *end_time;
+      const gchar *hour_format;
+
       tooltip_start = g_date_time_to_local (gcal_event_get_date_start (event));
       tooltip_end = g_date_time_to_local (gcal_event_get_date_end (event));
 
+      hour_format = gcal_date_format_cache_get_hour_format ();
+
+      /* Right-to-left layouts mirror the 12h clock format */
+      if (!is_ltr && gcal_date_format_cache_get_time_format () == GCAL_TIME_FORMAT_12H)
+        hour_format = "%P %M:%I";
+
+      start_date = gcal_date_format_cache_format_date (tooltip_start, "%x");
+      start_time = gcal_date_format_cache_format_time (tooltip_start, hour_format);
+      end_time = gcal_date_format_cache_format_time (tooltip_end, hour_format);
+
       if (multiday)
         {
-          switch (gcal_context_get_time_format (context))
-            {
-            case GCAL_TIME_FORMAT_24H:
-              if (is_ltr)
-                {
-                  start = g_date_time_format (tooltip_start, "%x %R");
-                  end = g_date_time_format (tooltip_end, "%x %R");
-                }
-              else
-                {
-                  start = g_date_time_format (tooltip_start, "%R %x");
-                  end = g_date_time_format (tooltip_end, "%R %x");
-                }
-              break;
+          const gchar *end_date = gcal_date_format_cache_format_date (tooltip_end, "%x");
 
-            case GCAL_TIME_FORMAT_12H:
-              if (is_ltr)
-                {
-                  start = g_date_time_format (tooltip_start, "%x %I:%M %P");
-                  end = g_date_time_format (tooltip_end, "%x %I:%M %P");
-                }
-              else
-                {
-                  start = g_date_time_format (tooltip_start, "%P %M:%I %x");
-                  end = g_date_time_format (tooltip_end, "%P %M:%I %x");
-                }
-              break;
+          if (is_ltr)
+            {
+              start = g_strdup_printf ("%s %s", start_date, start_time);
+              end = g_strdup_printf ("%s %s", end_date, end_time);
+            }
+          else
+            {
+              start = g_strdup_printf ("%s %s", start_time, start_date);
+              end = g_strdup_printf ("%s %s", end_time, end_date);
             }
         }
       else
         {
-          switch (gcal_context_get_time_format (context))
-            {
-            case GCAL_TIME_FORMAT_24H:
-              if (is_ltr)
-                {
-                  start = g_date_time_format (tooltip_start, "%x, %R");
-                  end = g_date_time_format (tooltip_end, "%R");
-                }
-              else
-                {
-                  start = g_date_time_format (tooltip_start, "%R ,%x");
-                  end = g_date_time_format (tooltip_end, "%R");
-                }
-              break;
+          if (is_ltr)
+            start = g_strdup_printf ("%s, %s", start_date, start_time);
+          else
+            start = g_strdup_printf ("%s ,%s", start_time, start_date);
 
-            case GCAL_TIME_FORMAT_12H:
-              if (is_ltr)
-                {
-                  start = g_date_time_format (tooltip_start, "%x, %I:%M %P");
-                  end = g_date_time_format (tooltip_end, "%I:%M %P");
-                }
-              else
-                {
-                  start = g_date_time_format (tooltip_start, "%P %M:%I ,%x");
-                  end = g_date_time_format (tooltip_end, "%P %M:%I");
-                }
-              break;
-            }
+          end = g_strdup (end_time);
         }
     }
 
@@ -442,12 +419,10 @@ gcal_event_widget_set_event_tooltip (GcalEventWidget *self,
 static void
 gcal_event_widget_update_timestamp (GcalEventWidget *self)
 {
-  g_autofree gchar *timestamp_str = NULL;
-  GcalContext *context;
+  const gchar *timestamp_str = NULL;
 
   if (self->event && self->timestamp_policy != GCAL_TIMESTAMP_POLICY_NONE)
     {
-      context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
       g_autoptr (GDateTime) time = NULL;
 
       if (self->timestamp_policy == GCAL_TIMESTAMP_POLICY_START)
@@ -462,11 +437,9 @@ gcal_event_widget_update_timestamp (GcalEventWidget *self)
          * More formats can be found on the doc:
          * https://docs.gtk.org/glib/method.DateTime.format.html
          */
-        timestamp_str = g_date_time_format (time, _("%a %B %d"));
-      else if (gcal_context_get_time_format (context) == GCAL_TIME_FORMAT_24H)
-        timestamp_str = g_date_time_format (time, "%R");
+        timestamp_str = gcal_date_format_cache_format_date (time, _("%a %B %d"));
       else
-        timestamp_str = g_date_time_format (time, "%I:%M %P");
+        timestamp_str = gcal_date_format_cache_format_time (time, gcal_date_format_cache_get_hour_format ());
     }
 
   gtk_widget_set_visible (self->timestamp_label, timestamp_str != NULL);
@@ -663,7 +636,6 @@ gcal_event_widget_finalize (GObject *object)
   self = GCAL_EVENT_WIDGET (object);
 
   /* releasing properties */
-  g_clear_pointer (&self->css_class, g_free);
   g_clear_object (&self->event);
 
   G_OBJECT_CLASS (gcal_event_widget_parent_class)->finalize (object);
@@ -757,7 +729,7 @@ gcal_event_widget_init (GcalEventWidget *self)
   self->clock_signal_group = g_signal_group_new (GCAL_TYPE_CLOCK);
   g_signal_group_connect_swapped (self->clock_signal_group,
                                   "minute-changed",
-                                  G_CALLBACK (update_color),
+                                  G_CALLBACK (update_dimmed),
                                   self);
 
   self->context_signal_group = g_signal_group_new (GCAL_TYPE_CONTEXT);
@@ -978,12 +950,19 @@ void
 gcal_event_widget_set_event (GcalEventWidget *self,
                              GcalEvent       *event)
 {
+  gboolean interactive;
+
   g_assert (GCAL_IS_EVENT_WIDGET (self));
   g_assert (event == NULL || GCAL_IS_EVENT (event));
 
   if (!g_set_object (&self->event, event))
     return;
 
+  /* Placeholders are read-only copies shown while calendars load */
+  interactive = !event || !gcal_event_is_placeholder (event);
+  gtk_widget_set_can_target (GTK_WIDGET (self), interactive);
+  gtk_widget_set_focusable (GTK_WIDGET (self), interactive);
+
   if (event)
     {
       GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
@@ -996,6 +975,7 @@ gcal_event_widget_set_event (GcalEventWidget *self,
       g_signal_group_set_target (self->event_signal_group, event);
 
       update_color (self);
+      update_dimmed (self);
       gcal_event_widget_set_event_tooltip (self, event);
       gcal_event_widget_update_style (self);
       gcal_event_widget_update_timestamp (self);
@@ -24,6 +24,8 @@
 #include "gcal-utils.h"
 #include "gcal-sync-indicator.h"
 
+#include <glib/gi18n.h>
+
 struct _GcalSyncIndicator
 {
   AdwBin              parent_instance;
@@ -92,6 +94,60 @@ icon_change_timeout_cb (gpointer data)
   return G_SOURCE_REMOVE;
 }
 
+static gboolean
+on_query_tooltip_cb (GtkWidget         *widget,
+                     gint               x,
+                     gint               y,
+                     gboolean           keyboard_mode,
+                     GtkTooltip        *tooltip,
+                     GcalSyncIndicator *self)
+{
+  g_autoptr (GString) text = NULL;
+  GcalContext *context;
+  GcalManager *manager;
+  GListModel *calendars;
+
+  context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  manager = gcal_context_get_manager (context);
+  calendars = gcal_manager_get_calendars_model (manager);
+  text = g_string_new (NULL);
+
+  if (gcal_manager_get_synchronizing (manager))
+    g_string_append (text, C_("tooltip", "Synchronizing Remote Calendars"));
+
+  for (guint i = 0; i < g_list_model_get_n_items (calendars); i++)
+    {
+      g_autoptr (GcalCalendar) calendar = g_list_model_get_item (calendars, i);
+      guint n_failures;
+      gint64 latency;
+
+      if (!gcal_manager_get_refresh_info (manager, calendar, &latency, &n_failures))
+        continue;
+
+      if (text->len > 0)
+        g_string_append_c (text, '\n');
+
+      if (n_failures > 0)
+        {
+          /* Translators: %s is the name of a calendar */
+          g_string_append_printf (text, _("%s: failed to synchronize"), gcal_calendar_get_name (calendar));
+        }
+      else
+        {
+          /* Translators: %1$s is the name of a calendar, %2$.1f the time it took to synchronize it */
+          g_string_append_printf (text, _("%1$s: synchronized in %2$.1f s"),
+                                  gcal_calendar_get_name (calendar),
+                                  latency / (gdouble) G_USEC_PER_SEC);
+        }
+    }
+
+  if (text->len == 0)
+    return FALSE;
+
+  gtk_tooltip_set_text (tooltip, text->str);
+  return TRUE;
+}
+
 static void
 on_manager_synchronizing_changed_cb (GcalManager       *manager,
                                      GParamSpec        *pspec,
@@ -141,6 +197,9 @@ gcal_sync_indicator_init (GcalSyncIndicator *self)
 
   gtk_widget_init_template (GTK_WIDGET (self));
 
+  gtk_widget_set_has_tooltip (GTK_WIDGET (self), TRUE);
+  g_signal_connect (self, "query-tooltip", G_CALLBACK (on_query_tooltip_cb), self);
+
   g_signal_connect_object (gcal_context_get_manager (context),
                            "notify::synchronizing",
                            G_CALLBACK (on_manager_synchronizing_changed_cb),
@@ -128,6 +128,7 @@ struct _GcalWindow
 
   /* day, week, month, year, list */
   GtkWidget          *views[N_WEEKDAYS - 1];
+  gboolean            date_pending[GCAL_WINDOW_VIEW_N_VIEWS];
   gboolean            subscribed;
 
   GcalWindowView      active_view;
@@ -156,6 +157,7 @@ struct _GcalWindow
 
   /* CSS */
   GtkCssProvider     *colors_provider;
+  GHashTable         *color_css_classes;
 
   /* Window states */
   gboolean            in_key_press;
@@ -306,6 +308,37 @@ maybe_add_subscribers_to_timeline (GcalWindow *self)
   self->subscribed = TRUE;
 }
 
+static void
+update_view_subscriptions (GcalWindow *self)
+{
+  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  GcalTimeline *timeline;
+  GcalWindowView i;
+
+  /* Hidden views don't need to keep their events around */
+  timeline = gcal_manager_get_timeline (gcal_context_get_manager (context));
+  for (i = 0; i < GCAL_WINDOW_VIEW_N_VIEWS; i++)
+    {
+      gcal_timeline_set_subscriber_paused (timeline,
+                                           GCAL_TIMELINE_SUBSCRIBER (self->views[i]),
+                                           i != self->active_view);
+    }
+}
+
+static void
+apply_pending_date (GcalWindow *self)
+{
+  GcalWindowView view = self->active_view;
+
+  if (!self->date_pending[view])
+    return;
+
+  GCAL_TRACE_MSG ("Applying pending date to view %d", view);
+
+  self->date_pending[view] = FALSE;
+  gcal_view_set_date (GCAL_VIEW (self->views[view]), self->active_date);
+}
+
 static void
 update_active_date (GcalWindow *window,
                     GDateTime  *date)
@@ -327,13 +360,17 @@ update_active_date (GcalWindow *window,
 
   gcal_set_date_time (&window->active_date, new_date);
 
+  /* Only the visible view is updated, the others catch up when shown */
   for (i = 0; i < GCAL_WINDOW_VIEW_N_VIEWS; i++)
-    gcal_view_set_date (GCAL_VIEW (window->views[i]), new_date);
+    window->date_pending[i] = TRUE;
+
+  apply_pending_date (window);
   gcal_view_set_date (GCAL_VIEW (window->date_chooser), new_date);
 
   update_today_action_enabled (window);
 
   maybe_add_subscribers_to_timeline (window);
+  update_view_subscriptions (window);
 
   GCAL_EXIT;
 }
@@ -342,30 +379,62 @@ static void
 recalculate_calendar_colors_css (GcalWindow *self)
 {
   GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  g_autoptr (GHashTable) css_classes = NULL;
   g_autoptr (GString) css_colors = NULL;
   g_autoptr (GList) calendars = NULL;
   GcalManager *manager;
+  GHashTableIter iter;
+  gpointer key;
+  gpointer value;
+  gboolean changed;
 
-  css_colors = g_string_new (NULL);
+  GCAL_ENTRY;
+
+  /* Style classes are interned, and calendars with the same color share them */
+  css_classes = g_hash_table_new (g_direct_hash, g_direct_equal);
   manager = gcal_context_get_manager (context);
   calendars = gcal_manager_get_calendars (manager);
   for (GList *l = calendars; l; l = l->next)
     {
-      g_autofree gchar* color_str = NULL;
-      const GdkRGBA *color;
-      GcalCalendar *calendar;
-      GQuark color_id;
+      GcalCalendar *calendar = GCAL_CALENDAR (l->data);
+
+      g_hash_table_insert (css_classes,
+                           (gpointer) gcal_calendar_get_color_css_class (calendar),
+                           (gpointer) gcal_calendar_get_color (calendar));
+    }
+
+  /* Only reparse the stylesheet when the set of colors actually changed */
+  changed = !self->color_css_classes ||
+            g_hash_table_size (css_classes) != g_hash_table_size (self->color_css_classes);
+
+  g_hash_table_iter_init (&iter, css_classes);
+  while (!changed && g_hash_table_iter_next (&iter, &key, NULL))
+    changed = !g_hash_table_contains (self->color_css_classes, key);
 
-      calendar = GCAL_CALENDAR (l->data);
+  if (!changed)
+    GCAL_RETURN ();
+
+  GCAL_TRACE_MSG ("Regenerating stylesheet for %u calendar colors", g_hash_table_size (css_classes));
 
-      color = gcal_calendar_get_color (calendar);
-      color_str = gdk_rgba_to_string (color);
-      color_id = g_quark_from_string (color_str);
+  css_colors = g_string_new (NULL);
 
-      g_string_append_printf (css_colors, ".color-%u { --event-bg-color: %s; }\n", color_id, color_str);
+  g_hash_table_iter_init (&iter, css_classes);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      g_autofree gchar *color_str = gdk_rgba_to_string (value);
+
+      g_string_append_printf (css_colors, ".%s { --event-bg-color: %s; }\n", (const gchar *) key, color_str);
+
+      /* The calendars may go away, but interned strings don't */
+      g_hash_table_iter_replace (&iter, NULL);
     }
 
   gtk_css_provider_load_from_string (self->colors_provider, css_colors->str);
+
+  g_clear_pointer (&self->color_css_classes, g_hash_table_unref);
+  self->color_css_classes = g_steal_pointer (&css_classes);
+
+  GCAL_EXIT;
 }
 
 static void
@@ -529,6 +598,8 @@ add_or_remove_agenda_view_to_timeline (GcalWindow *self)
     gcal_timeline_add_subscriber (timeline, GCAL_TIMELINE_SUBSCRIBER (self->agenda_view));
   else
     gcal_timeline_remove_subscriber (timeline, GCAL_TIMELINE_SUBSCRIBER (self->agenda_view));
+
+  update_view_subscriptions (self);
 }
 
 /*
@@ -787,6 +858,10 @@ view_changed (GObject    *object,
   g_type_class_unref (eklass);
 
   window->active_view = view_type;
+
+  apply_pending_date (window);
+  update_view_subscriptions (window);
+
   update_today_action_enabled (window);
   g_object_notify_by_pspec (G_OBJECT (user_data), properties[PROP_ACTIVE_VIEW]);
 }
@@ -928,6 +1003,10 @@ event_preview_cb (GcalEventWidget        *event_widget,
     {
     case GCAL_EVENT_PREVIEW_ACTION_EDIT:
       event = gcal_event_widget_get_event (event_widget);
+
+      if (gcal_event_is_placeholder (event))
+        break;
+
       gcal_event_editor_dialog_present_event (self->event_editor, GTK_WIDGET (self), event, FALSE);
       break;
 
@@ -963,11 +1042,33 @@ event_activated (GcalView        *view,
 {
   GcalWindow *self = GCAL_WINDOW (user_data);
 
+  if (gcal_event_is_placeholder (gcal_event_widget_get_event (event_widget)))
+    return;
+
   g_set_weak_pointer (&self->last_focused_widget, find_first_focusable_widget (GTK_WIDGET (event_widget)));
 
   gcal_event_widget_show_preview (event_widget, event_preview_cb, user_data);
 }
 
+static void
+on_manager_event_change_failed_cb (GcalManager  *manager,
+                                   GcalEvent    *event,
+                                   const GError *error,
+                                   GcalWindow   *self)
+{
+  g_autofree gchar *title = NULL;
+  const gchar *summary;
+
+  summary = gcal_event_get_summary (event);
+
+  if (summary && *summary)
+    title = g_strdup_printf (_("Could not save changes to “%s”"), summary);
+  else
+    title = g_strdup (_("Could not save changes to the event"));
+
+  adw_toast_overlay_add_toast (self->overlay, adw_toast_new (title));
+}
+
 static void
 on_toast_dismissed_cb (AdwToast   *toast,
                        GcalWindow *self)
@@ -1010,6 +1111,10 @@ on_event_editor_dialog_remove_event_cb (GcalEventEditorDialog *edit_dialog,
 
   GCAL_ENTRY;
 
+  /* Placeholders are stripped copies, never remove the real event through them */
+  if (gcal_event_is_placeholder (event))
+    GCAL_RETURN ();
+
   has_deleted_event = self->delete_event_toast != NULL;
   if (self->delete_event_toast)
     adw_toast_dismiss (self->delete_event_toast);
@@ -1182,6 +1287,7 @@ gcal_window_finalize (GObject *object)
   gcal_clear_date_time (&window->active_date);
 
   g_clear_object (&window->colors_provider);
+  g_clear_pointer (&window->color_css_classes, g_hash_table_unref);
 
   G_OBJECT_CLASS (gcal_window_parent_class)->finalize (object);
 
@@ -1197,6 +1303,9 @@ gcal_window_dispose (GObject *object)
 
   self = GCAL_WINDOW (object);
 
+  /* Keep the visible events around for the next cold start */
+  gcal_manager_save_snapshot (gcal_context_get_manager (context));
+
   timeline = gcal_manager_get_timeline (gcal_context_get_manager (context));
   gcal_timeline_remove_subscriber (timeline, GCAL_TIMELINE_SUBSCRIBER (self->week_view));
   gcal_timeline_remove_subscriber (timeline, GCAL_TIMELINE_SUBSCRIBER (self->month_view));
@@ -1251,6 +1360,12 @@ gcal_window_constructed (GObject *object)
                     NULL);
   recalculate_calendar_colors_css (self);
 
+  g_signal_connect_object (gcal_context_get_manager (context),
+                           "event-change-failed",
+                           G_CALLBACK (on_manager_event_change_failed_cb),
+                           self,
+                           0);
+
   GCAL_EXIT;
 }
 
@@ -26,18 +26,28 @@
 #include "gcal-calendar-combo-row.h"
 #include "gcal-debug.h"
 #include "gcal-import-file-row.h"
+#include "gcal-importer.h"
 #include "gcal-utils.h"
 
 #include <adwaita.h>
 #include <glib/gi18n.h>
 
+#define IMPORT_CHUNK_SIZE 100
+
 typedef struct
 {
   ECalClient         *client;
-  GSList             *components;
+  GPtrArray          *components;
   GSList             *zones;
 } ImportData;
 
+typedef struct
+{
+  GcalImportDialog   *dialog;
+  guint               n_imported;
+  guint               n_total;
+} ImportProgress;
+
 struct _GcalImportDialog
 {
   AdwDialog             parent;
@@ -49,6 +59,7 @@ struct _GcalImportDialog
   AdwHeaderBar         *headerbar;
   GtkWidget            *import_button;
   GtkWidget            *placeholder_spinner;
+  GtkProgressBar       *progress_bar;
   GtkSizeGroup         *title_sizegroup;
   AdwToastOverlay      *toast_overlay;
 
@@ -57,11 +68,12 @@ struct _GcalImportDialog
   GCancellable         *cancellable;
   gint                  n_events;
   gint                  n_files;
+  guint                 n_loading_files;
 };
 
 
 static void          on_import_row_file_loaded_cb                 (GcalImportFileRow *row,
-                                                                   GPtrArray         *events,
+                                                                   GListModel        *events,
                                                                    GcalImportDialog  *self);
 
 G_DEFINE_TYPE (GcalImportDialog, gcal_import_dialog, ADW_TYPE_DIALOG)
@@ -80,11 +92,53 @@ import_data_free (gpointer data)
     return;
 
   g_clear_object (&import_data->client);
-  g_slist_free_full (import_data->components, g_object_unref);
+  g_clear_pointer (&import_data->components, g_ptr_array_unref);
   g_slist_free_full (import_data->zones, g_object_unref);
   g_free (import_data);
 }
 
+static gboolean
+update_progress_cb (gpointer user_data)
+{
+  g_autofree gchar *text = NULL;
+  ImportProgress *progress;
+
+  progress = user_data;
+
+  /* Translators: the first %u is the number of imported events, the second the total */
+  text = g_strdup_printf (g_dngettext (GETTEXT_PACKAGE,
+                                       "Imported %u of %u event",
+                                       "Imported %u of %u events",
+                                       progress->n_total),
+                          progress->n_imported,
+                          progress->n_total);
+
+  gtk_progress_bar_set_fraction (progress->dialog->progress_bar,
+                                 (gdouble) progress->n_imported / progress->n_total);
+  gtk_progress_bar_set_text (progress->dialog->progress_bar, text);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+import_progress_free (gpointer data)
+{
+  ImportProgress *progress = data;
+
+  g_clear_object (&progress->dialog);
+  g_free (progress);
+}
+
+static void
+update_import_button (GcalImportDialog *self)
+{
+  /* Only import once every file is fully loaded, and never twice */
+  gtk_widget_set_sensitive (self->import_button,
+                            self->n_loading_files == 0 &&
+                            self->n_events > 0 &&
+                            !self->cancellable);
+}
+
 static void
 update_default_calendar (GcalImportDialog *self)
 {
@@ -142,6 +196,9 @@ add_file (GcalImportDialog *self,
 
   gtk_box_append (self->calendars_box, GTK_WIDGET (group));
   self->rows = g_list_prepend (self->rows, row);
+  self->n_loading_files++;
+
+  update_import_button (self);
 
   gtk_widget_set_visible (self->placeholder_spinner, FALSE);
 
@@ -202,6 +259,11 @@ on_events_created_cb (GObject      *source_object,
   self = GCAL_IMPORT_DIALOG (user_data);
 
   g_task_propagate_boolean (G_TASK (result), &error);
+
+  /* The dialog was closed while importing */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    GCAL_RETURN ();
+
   if (error)
     g_warning ("Error creating events: %s", error->message);
 
@@ -210,16 +272,101 @@ on_events_created_cb (GObject      *source_object,
   GCAL_EXIT;
 }
 
+static void
+post_progress (GTask *task,
+               guint  n_imported,
+               guint  n_total)
+{
+  ImportProgress *progress;
+
+  progress = g_new0 (ImportProgress, 1);
+  progress->dialog = g_object_ref (g_task_get_source_object (task));
+  progress->n_imported = n_imported;
+  progress->n_total = n_total;
+
+  g_main_context_invoke_full (g_task_get_context (task),
+                              G_PRIORITY_DEFAULT,
+                              update_progress_cb,
+                              progress,
+                              import_progress_free);
+}
+
+/*
+ * Submits the components in chunks, so that a large import neither
+ * builds one huge request to the backend nor leaves the user without
+ * feedback until it's done.
+ */
+static gboolean
+submit_components (GTask         *task,
+                   ECalClient    *client,
+                   GPtrArray     *components,
+                   gboolean       modify,
+                   ECalObjModType mod,
+                   guint         *n_imported,
+                   guint          n_total,
+                   GCancellable  *cancellable,
+                   GError       **error)
+{
+  guint i;
+
+  for (i = 0; i < components->len; i += IMPORT_CHUNK_SIZE)
+    {
+      GSList *chunk = NULL;
+      GSList *uids = NULL;
+      gboolean success;
+      guint j;
+
+      for (j = MIN (i + IMPORT_CHUNK_SIZE, components->len); j > i; j--)
+        chunk = g_slist_prepend (chunk, g_ptr_array_index (components, j - 1));
+
+      if (modify)
+        {
+          success = e_cal_client_modify_objects_sync (client,
+                                                      chunk,
+                                                      mod,
+                                                      E_CAL_OPERATION_FLAG_NONE,
+                                                      cancellable,
+                                                      error);
+        }
+      else
+        {
+          success = e_cal_client_create_objects_sync (client,
+                                                      chunk,
+                                                      E_CAL_OPERATION_FLAG_NONE,
+                                                      &uids,
+                                                      cancellable,
+                                                      error);
+        }
+
+      g_slist_free_full (uids, g_free);
+      g_slist_free (chunk);
+
+      if (!success)
+        return FALSE;
+
+      *n_imported += MIN (IMPORT_CHUNK_SIZE, components->len - i);
+      post_progress (task, *n_imported, n_total);
+    }
+
+  return TRUE;
+}
+
 static void
 import_data_thread (GTask        *task,
                     gpointer      source_object,
                     gpointer      task_data,
                     GCancellable *cancellable)
 {
+  g_autoptr (GcalImportIndex) index = NULL;
+  g_autoptr (GPtrArray) modified_instances = NULL;
+  g_autoptr (GPtrArray) modified = NULL;
+  g_autoptr (GPtrArray) created = NULL;
+  g_autoptr (GError) error = NULL;
   ImportData *id = task_data;
-  GError *error = NULL;
-  GSList *uids = NULL;
   GSList *l = NULL;
+  guint n_imported;
+  guint n_total;
+  guint i;
 
   for (l = id->zones; l && !g_cancellable_is_cancelled (cancellable); l = l->next)
     {
@@ -232,29 +379,76 @@ import_data_thread (GTask        *task,
         g_warning ("Import: Failed to add timezone: %s", local_error->message);
     }
 
-  e_cal_client_create_objects_sync (id->client,
-                                    id->components,
-                                    E_CAL_OPERATION_FLAG_NONE,
-                                    &uids,
-                                    cancellable,
-                                    &error);
+  /*
+   * Re-importing a newer export of the same calendar must not duplicate
+   * events, so only submit what is new or more recent than what the
+   * calendar already has.
+   */
+  index = gcal_importer_query_index (id->client, id->components, cancellable, &error);
 
-  g_slist_free_full (uids, g_free);
+  if (!index)
+    {
+      g_task_return_error (task, g_steal_pointer (&error));
+      return;
+    }
 
-  if (error)
-    g_task_return_error (task, error);
-  else
-    g_task_return_boolean (task, TRUE);
+  created = g_ptr_array_new ();
+  modified = g_ptr_array_new ();
+  modified_instances = g_ptr_array_new ();
+
+  for (i = 0; i < id->components->len; i++)
+    {
+      ICalComponent *component = g_ptr_array_index (id->components, i);
+      g_autoptr (ICalTime) recurrence_id = NULL;
+
+      switch (gcal_import_index_classify (index, component))
+        {
+        case GCAL_IMPORT_ACTION_CREATE:
+          g_ptr_array_add (created, component);
+          break;
+
+        case GCAL_IMPORT_ACTION_MODIFY:
+          recurrence_id = i_cal_component_get_recurrenceid (component);
+
+          if (recurrence_id && !i_cal_time_is_null_time (recurrence_id))
+            g_ptr_array_add (modified_instances, component);
+          else
+            g_ptr_array_add (modified, component);
+          break;
+
+        case GCAL_IMPORT_ACTION_SKIP:
+          break;
+        }
+    }
+
+  n_total = created->len + modified->len + modified_instances->len;
+  n_imported = 0;
+
+  g_debug ("Importing %u new and %u updated events, skipping %u up-to-date events",
+           created->len,
+           modified->len + modified_instances->len,
+           id->components->len - n_total);
+
+  if (!submit_components (task, id->client, created, FALSE, E_CAL_OBJ_MOD_ALL, &n_imported, n_total, cancellable, &error) ||
+      !submit_components (task, id->client, modified, TRUE, E_CAL_OBJ_MOD_ALL, &n_imported, n_total, cancellable, &error) ||
+      !submit_components (task, id->client, modified_instances, TRUE, E_CAL_OBJ_MOD_THIS, &n_imported, n_total, cancellable, &error))
+    {
+      g_task_return_error (task, g_steal_pointer (&error));
+      return;
+    }
+
+  g_task_return_boolean (task, TRUE);
 }
 
 static void
 on_import_button_clicked_cb (GtkButton        *button,
                              GcalImportDialog *self)
 {
+  g_autoptr (GHashTable) tzids = NULL;
+  g_autoptr (GPtrArray) components = NULL;
   g_autoptr (GTask) task = NULL;
   ImportData *import_data;
   ECalClient *client;
-  GSList *slist = NULL;
   GSList *zones = NULL;
   GList *l;
 
@@ -262,50 +456,64 @@ on_import_button_clicked_cb (GtkButton        *button,
 
   g_assert (gcal_calendar_combo_row_get_calendar (self->calendar_combo_row) != NULL);
 
-  slist = NULL;
+  if (self->n_loading_files > 0 || self->cancellable)
+    GCAL_RETURN ();
+
+  components = g_ptr_array_new_with_free_func (g_object_unref);
+  tzids = g_hash_table_new (g_str_hash, g_str_equal);
+
   for (l = self->rows; l; l = l->next)
     {
       GcalImportFileRow *row = GCAL_IMPORT_FILE_ROW (l->data);
-      GPtrArray *ical_components;
+      GListModel *ical_components;
       GPtrArray *ical_timezones;
       guint i;
 
       ical_components = gcal_import_file_row_get_ical_components (row);
-      if (!ical_components)
-        continue;
 
-      for (i = 0; i < ical_components->len; i++)
-        {
-          ICalComponent *comp = g_ptr_array_index (ical_components, i);
-          slist = g_slist_prepend (slist, g_object_ref (comp));
-        }
+      for (i = 0; i < g_list_model_get_n_items (ical_components); i++)
+        g_ptr_array_add (components, g_list_model_get_item (ical_components, i));
 
       ical_timezones = gcal_import_file_row_get_timezones (row);
       if (!ical_timezones)
         continue;
 
+      /* Files exported from the same place usually share their timezones */
       for (i = 0; i < ical_timezones->len; i++)
         {
           ICalTimezone *zone = g_ptr_array_index (ical_timezones, i);
+          const gchar *tzid = i_cal_timezone_get_tzid (zone);
+
+          if (!tzid || !g_hash_table_add (tzids, (gpointer) tzid))
+            continue;
+
           zones = g_slist_prepend (zones, g_object_ref (zone));
         }
     }
 
-  if (!slist)
-    GCAL_RETURN ();
+  if (components->len == 0)
+    {
+      g_slist_free_full (zones, g_object_unref);
+      GCAL_RETURN ();
+    }
 
   self->cancellable = g_cancellable_new ();
 
-  gtk_widget_set_sensitive (GTK_WIDGET (self), FALSE);
+  /* Keep the cancel button sensitive, so the import can be stopped */
+  gtk_widget_set_sensitive (GTK_WIDGET (self->calendars_box), FALSE);
+  update_import_button (self);
+
+  gtk_progress_bar_set_fraction (self->progress_bar, 0.0);
+  gtk_widget_set_visible (GTK_WIDGET (self->progress_bar), TRUE);
 
   client = gcal_calendar_get_client (gcal_calendar_combo_row_get_calendar (self->calendar_combo_row));
 
   import_data = g_new0 (ImportData, 1);
   import_data->client = g_object_ref (client);
-  import_data->components = g_slist_reverse (slist);
+  import_data->components = g_steal_pointer (&components);
   import_data->zones = g_slist_reverse (zones);
 
-  task = g_task_new (NULL, self->cancellable, on_events_created_cb, self);
+  task = g_task_new (self, self->cancellable, on_events_created_cb, self);
   g_task_set_task_data (task, import_data, import_data_free);
   g_task_set_source_tag (task, on_import_button_clicked_cb);
   g_task_run_in_thread (task, import_data_thread);
@@ -315,14 +523,17 @@ on_import_button_clicked_cb (GtkButton        *button,
 
 static void
 on_import_row_file_loaded_cb (GcalImportFileRow *row,
-                              GPtrArray         *events,
+                              GListModel        *events,
                               GcalImportDialog  *self)
 {
   g_autofree gchar *title = NULL;
 
   GCAL_ENTRY;
 
-  self->n_events += events ? events->len : 0;
+  g_assert (self->n_loading_files > 0);
+
+  self->n_loading_files--;
+  self->n_events += g_list_model_get_n_items (events);
 
   title = g_strdup_printf (g_dngettext (GETTEXT_PACKAGE,
                                         "Import %d event",
@@ -331,7 +542,7 @@ on_import_row_file_loaded_cb (GcalImportFileRow *row,
                            self->n_events);
   adw_dialog_set_title (ADW_DIALOG (self), title);
 
-  gtk_widget_set_visible (GTK_WIDGET (row), TRUE);
+  update_import_button (self);
 
   GCAL_EXIT;
 }
@@ -351,6 +562,18 @@ gcal_import_dialog_constructed (GObject *object)
   setup_calendars (self);
 }
 
+static void
+gcal_import_dialog_closed (AdwDialog *dialog)
+{
+  GcalImportDialog *self = (GcalImportDialog *)dialog;
+
+  /* Events that were already created are kept */
+  g_cancellable_cancel (self->cancellable);
+
+  if (ADW_DIALOG_CLASS (gcal_import_dialog_parent_class)->closed)
+    ADW_DIALOG_CLASS (gcal_import_dialog_parent_class)->closed (dialog);
+}
+
 static void
 gcal_import_dialog_finalize (GObject *object)
 {
@@ -369,12 +592,15 @@ gcal_import_dialog_class_init (GcalImportDialogClass *klass)
 {
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
+  AdwDialogClass *dialog_class = ADW_DIALOG_CLASS (klass);
 
   g_type_ensure (GCAL_TYPE_CALENDAR_COMBO_ROW);
 
   object_class->constructed = gcal_import_dialog_constructed;
   object_class->finalize = gcal_import_dialog_finalize;
 
+  dialog_class->closed = gcal_import_dialog_closed;
+
   gtk_widget_class_set_template_from_resource (widget_class, "/org/gnome/calendar/ui/gui/importer/gcal-import-dialog.ui");
 
   gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, calendar_combo_row);
@@ -383,6 +609,7 @@ gcal_import_dialog_class_init (GcalImportDialogClass *klass)
   gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, headerbar);
   gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, import_button);
   gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, placeholder_spinner);
+  gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, progress_bar);
   gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, calendars_box);
   gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, title_sizegroup);
   gtk_widget_class_bind_template_child (widget_class, GcalImportDialog, toast_overlay);
@@ -31,15 +31,30 @@ struct _GcalImportFileRow
 {
   AdwBin              parent;
 
-  GtkListBox         *events_listbox;
+  GtkListView        *events_listview;
+  GtkProgressBar     *progress_bar;
   GtkSizeGroup       *title_sizegroup;
 
   GCancellable       *cancellable;
   GFile              *file;
-  GPtrArray          *ical_components;
+  GListStore         *ical_components;
   GPtrArray          *ical_timezones;
 };
 
+enum
+{
+  ROW_TITLE,
+  ROW_LOCATION,
+  ROW_STARTS,
+  ROW_ENDS,
+  ROW_DESCRIPTION,
+  N_ROWS,
+};
+
+static void          on_components_parsed_cb                     (GPtrArray          *components,
+                                                                  gdouble             fraction,
+                                                                  gpointer            user_data);
+
 static void          read_calendar_finished_cb                   (GObject            *source_object,
                                                                   GAsyncResult       *res,
                                                                   gpointer            user_data);
@@ -71,17 +86,12 @@ static void
 add_grid_row (GcalImportFileRow *self,
               GtkGrid           *grid,
               gint               row,
-              const gchar       *title,
-              const gchar       *value)
+              const gchar       *title)
 {
   GtkWidget *title_label;
   GtkWidget *value_label;
 
-  if (!value || g_utf8_strlen (value, -1) == 0)
-    return;
-
   title_label = g_object_new (GTK_TYPE_LABEL,
-                              "visible", TRUE,
                               "label", title,
                               "xalign", 1.0f,
                               "yalign", 0.0f,
@@ -94,8 +104,6 @@ add_grid_row (GcalImportFileRow *self,
   gtk_size_group_add_widget (self->title_sizegroup, title_label);
 
   value_label = g_object_new (GTK_TYPE_LABEL,
-                              "visible", TRUE,
-                              "label", value,
                               "xalign", 0.0f,
                               "selectable", TRUE,
                               "ellipsize", PANGO_ELLIPSIZE_END,
@@ -105,9 +113,22 @@ add_grid_row (GcalImportFileRow *self,
 }
 
 static void
-fill_grid_with_event_data (GcalImportFileRow *self,
-                           GtkGrid           *grid,
-                           ICalComponent     *ical_component)
+set_grid_row_value (GtkGrid     *grid,
+                    gint         row,
+                    const gchar *value)
+{
+  gboolean visible;
+
+  visible = value && g_utf8_strlen (value, -1) > 0;
+
+  gtk_widget_set_visible (gtk_grid_get_child_at (grid, 0, row), visible);
+  gtk_widget_set_visible (gtk_grid_get_child_at (grid, 1, row), visible);
+  gtk_label_set_label (GTK_LABEL (gtk_grid_get_child_at (grid, 1, row)), visible ? value : NULL);
+}
+
+static void
+fill_grid_with_event_data (GtkGrid       *grid,
+                           ICalComponent *ical_component)
 {
   GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
   g_autofree gchar *start_string = NULL;
@@ -119,7 +140,6 @@ fill_grid_with_event_data (GcalImportFileRow *self,
   g_autoptr (GDateTime) end_local = NULL;
   ICalTime *ical_start;
   ICalTime *ical_end;
-  gint row = 0;
 
   ical_start = i_cal_component_get_dtstart (ical_component);
   start = gcal_date_time_from_icaltime (ical_start);
@@ -172,143 +192,119 @@ fill_grid_with_event_data (GcalImportFileRow *self,
 
   gcal_utils_extract_meeting_url (i_cal_component_get_description (ical_component), &description, NULL);
 
-  add_grid_row (self, grid, row++, _("Title"), i_cal_component_get_summary (ical_component));
-  add_grid_row (self, grid, row++, _("Location"), i_cal_component_get_location (ical_component));
-  add_grid_row (self, grid, row++, _("Starts"), start_string);
-  add_grid_row (self, grid, row++, _("Ends"), end_string);
-  add_grid_row (self, grid, row++, _("Description"), description);
+  set_grid_row_value (grid, ROW_TITLE, i_cal_component_get_summary (ical_component));
+  set_grid_row_value (grid, ROW_LOCATION, i_cal_component_get_location (ical_component));
+  set_grid_row_value (grid, ROW_STARTS, start_string);
+  set_grid_row_value (grid, ROW_ENDS, end_string);
+  set_grid_row_value (grid, ROW_DESCRIPTION, description);
 
   g_clear_object (&ical_start);
   g_clear_object (&ical_end);
 }
 
 static void
-add_events_to_listbox (GcalImportFileRow *self,
-                       GPtrArray         *events)
+setup_file (GcalImportFileRow *self)
 {
-  guint i;
-
-  for (i = 0; i < events->len; i++)
-    {
-      ICalComponent *ical_component;
-      GtkWidget *grid;
-      GtkWidget *row;
-
-      ical_component = g_ptr_array_index (events, i);
-
-      row = g_object_new (GTK_TYPE_LIST_BOX_ROW,
-                          "visible", TRUE,
-                          "activatable", FALSE,
-                          NULL);
-
-      grid = g_object_new (GTK_TYPE_GRID,
-                           "visible", TRUE,
-                           "row-spacing", 6,
-                           "column-spacing", 12,
-                           "margin-top", 18,
-                           "margin-bottom", 18,
-                           "margin-start", 24,
-                           "margin-end", 24,
-                           NULL);
-      fill_grid_with_event_data (self, GTK_GRID (grid), ical_component);
-      gtk_list_box_row_set_child (GTK_LIST_BOX_ROW (row), grid);
-
-      gtk_list_box_insert (self->events_listbox, row, -1);
-    }
+  gcal_importer_import_file (self->file,
+                             self->cancellable,
+                             on_components_parsed_cb,
+                             self,
+                             read_calendar_finished_cb,
+                             self);
 }
 
-static GPtrArray*
-filter_event_components (ICalComponent *component)
-{
-  g_autoptr (GPtrArray) event_components = NULL;
-  ICalComponent *aux;
-
-  if (!component)
-    return NULL;
 
-  event_components = g_ptr_array_new_full (20, g_object_unref);
-  aux = i_cal_component_get_first_real_component (component);
-  while (aux)
-    {
-      g_ptr_array_add (event_components, g_object_ref (aux));
-      aux = i_cal_component_get_next_component (component, I_CAL_VEVENT_COMPONENT);
-    }
-
-  return g_steal_pointer (&event_components);
-}
+/*
+ * Callbacks
+ */
 
-static GPtrArray*
-filter_timezones (ICalComponent *component)
+static void
+on_components_parsed_cb (GPtrArray *components,
+                         gdouble    fraction,
+                         gpointer   user_data)
 {
-  g_autoptr (GPtrArray) timezones = NULL;
-  ICalComponent *aux;
-
-  if (!component || i_cal_component_isa (component) != I_CAL_VCALENDAR_COMPONENT)
-    return NULL;
+  GcalImportFileRow *self = GCAL_IMPORT_FILE_ROW (user_data);
 
-  timezones = g_ptr_array_new_full (2, g_object_unref);
-  for (aux = i_cal_component_get_first_component (component, I_CAL_VTIMEZONE_COMPONENT);
-       aux;
-       aux = i_cal_component_get_next_component (component, I_CAL_VTIMEZONE_COMPONENT))
-    {
-      ICalTimezone *zone = i_cal_timezone_new ();
-      ICalComponent *clone = i_cal_component_clone (aux);
+  g_list_store_splice (self->ical_components,
+                       g_list_model_get_n_items (G_LIST_MODEL (self->ical_components)),
+                       0,
+                       components->pdata,
+                       components->len);
 
-      if (i_cal_timezone_set_component (zone, clone))
-         g_ptr_array_add (timezones, g_steal_pointer (&zone));
+  gtk_progress_bar_set_fraction (self->progress_bar, fraction);
+  gtk_widget_set_visible (GTK_WIDGET (self), TRUE);
+}
 
-      g_clear_object (&clone);
-      g_clear_object (&zone);
-      g_clear_object (&aux);
-    }
+static void
+on_factory_setup_cb (GtkSignalListItemFactory *factory,
+                     GtkListItem              *item,
+                     GcalImportFileRow        *self)
+{
+  GtkWidget *grid;
+
+  grid = g_object_new (GTK_TYPE_GRID,
+                       "row-spacing", 6,
+                       "column-spacing", 12,
+                       "margin-top", 18,
+                       "margin-bottom", 18,
+                       "margin-start", 24,
+                       "margin-end", 24,
+                       NULL);
 
-  if (!timezones->len)
-    return NULL;
+  add_grid_row (self, GTK_GRID (grid), ROW_TITLE, _("Title"));
+  add_grid_row (self, GTK_GRID (grid), ROW_LOCATION, _("Location"));
+  add_grid_row (self, GTK_GRID (grid), ROW_STARTS, _("Starts"));
+  add_grid_row (self, GTK_GRID (grid), ROW_ENDS, _("Ends"));
+  add_grid_row (self, GTK_GRID (grid), ROW_DESCRIPTION, _("Description"));
 
-  return g_steal_pointer (&timezones);
+  gtk_list_item_set_activatable (item, FALSE);
+  gtk_list_item_set_child (item, grid);
 }
 
 static void
-setup_file (GcalImportFileRow *self)
+on_factory_bind_cb (GtkSignalListItemFactory *factory,
+                    GtkListItem              *item,
+                    GcalImportFileRow        *self)
 {
-  gcal_importer_import_file (self->file,
-                             self->cancellable,
-                             read_calendar_finished_cb,
-                             self);
+  fill_grid_with_event_data (GTK_GRID (gtk_list_item_get_child (item)),
+                             gtk_list_item_get_item (item));
 }
 
-
-/*
- * Callbacks
- */
-
 static void
 read_calendar_finished_cb (GObject      *source_object,
                            GAsyncResult *res,
                            gpointer      user_data)
 {
-  g_autoptr (GPtrArray) event_components = NULL;
   g_autoptr (GPtrArray) timezones = NULL;
   g_autoptr (GError) error = NULL;
-  ICalComponent *component;
   GcalImportFileRow *self;
+  guint n_events;
+
+  timezones = gcal_importer_import_file_finish (res, &error);
+
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    return;
 
   self = GCAL_IMPORT_FILE_ROW (user_data);
-  component = gcal_importer_import_file_finish (res, &error);
-  event_components = filter_event_components (component);
-  timezones = filter_timezones (component);
 
-  gtk_widget_set_sensitive (GTK_WIDGET (self), !error && event_components && event_components->len > 0);
+  /* Never import the chunks of a file that failed partway through */
+  if (error)
+    {
+      g_warning ("Error loading file: %s", error->message);
+      g_list_store_remove_all (self->ical_components);
+    }
 
-  if (error || !event_components || event_components->len == 0)
-    return;
+  n_events = g_list_model_get_n_items (G_LIST_MODEL (self->ical_components));
 
-  add_events_to_listbox (self, event_components);
+  gtk_widget_set_visible (GTK_WIDGET (self->progress_bar), FALSE);
+  gtk_widget_set_visible (GTK_WIDGET (self), n_events > 0);
+  gtk_widget_set_sensitive (GTK_WIDGET (self), n_events > 0);
 
-  self->ical_components = g_ptr_array_ref (event_components);
-  self->ical_timezones = g_steal_pointer (&timezones);
+  if (!error && timezones && timezones->len > 0)
+    self->ical_timezones = g_steal_pointer (&timezones);
 
-  g_signal_emit (self, signals[FILE_LOADED], 0, event_components);
+  /* Also emitted for failed and empty files, so the dialog knows they're done */
+  g_signal_emit (self, signals[FILE_LOADED], 0, G_LIST_MODEL (self->ical_components));
 }
 
 
@@ -324,7 +320,7 @@ gcal_import_file_row_finalize (GObject *object)
   g_cancellable_cancel (self->cancellable);
   g_clear_object (&self->cancellable);
   g_clear_object (&self->file);
-  g_clear_pointer (&self->ical_components, g_ptr_array_unref);
+  g_clear_object (&self->ical_components);
   g_clear_pointer (&self->ical_timezones, g_ptr_array_unref);
 
   G_OBJECT_CLASS (gcal_import_file_row_parent_class)->finalize (object);
@@ -384,10 +380,10 @@ gcal_import_file_row_class_init (GcalImportFileRowClass *klass)
                                        GCAL_TYPE_IMPORT_FILE_ROW,
                                        G_SIGNAL_RUN_LAST,
                                        0, NULL, NULL,
-                                       g_cclosure_marshal_VOID__BOXED,
+                                       g_cclosure_marshal_VOID__OBJECT,
                                        G_TYPE_NONE,
                                        1,
-                                       G_TYPE_PTR_ARRAY);
+                                       G_TYPE_LIST_MODEL);
 
   properties[PROP_FILE] = g_param_spec_object ("file",
                                                "An ICS file",
@@ -399,15 +395,29 @@ gcal_import_file_row_class_init (GcalImportFileRowClass *klass)
 
   gtk_widget_class_set_template_from_resource (widget_class, "/org/gnome/calendar/ui/gui/importer/gcal-import-file-row.ui");
 
-  gtk_widget_class_bind_template_child (widget_class, GcalImportFileRow, events_listbox);
+  gtk_widget_class_bind_template_child (widget_class, GcalImportFileRow, events_listview);
+  gtk_widget_class_bind_template_child (widget_class, GcalImportFileRow, progress_bar);
 }
 
 static void
 gcal_import_file_row_init (GcalImportFileRow *self)
 {
+  g_autoptr (GtkListItemFactory) factory = NULL;
+  g_autoptr (GtkSelectionModel) selection = NULL;
+
   self->cancellable = g_cancellable_new ();
+  self->ical_components = g_list_store_new (I_CAL_TYPE_COMPONENT);
 
   gtk_widget_init_template (GTK_WIDGET (self));
+
+  factory = gtk_signal_list_item_factory_new ();
+  g_signal_connect (factory, "setup", G_CALLBACK (on_factory_setup_cb), self);
+  g_signal_connect (factory, "bind", G_CALLBACK (on_factory_bind_cb), self);
+
+  selection = GTK_SELECTION_MODEL (gtk_no_selection_new (g_object_ref (G_LIST_MODEL (self->ical_components))));
+
+  gtk_list_view_set_factory (self->events_listview, factory);
+  gtk_list_view_set_model (self->events_listview, selection);
 }
 
 GtkWidget*
@@ -424,12 +434,20 @@ gcal_import_file_row_new (GFile        *file,
   return (GtkWidget*) self;
 }
 
-GPtrArray*
+/**
+ * gcal_import_file_row_get_ical_components:
+ * @self: a #GcalImportFileRow
+ *
+ * Retrieves the events parsed from the file so far.
+ *
+ * Returns: (transfer none): a #GListModel of #ICalComponent
+ */
+GListModel*
 gcal_import_file_row_get_ical_components (GcalImportFileRow *self)
 {
   g_return_val_if_fail (GCAL_IS_IMPORT_FILE_ROW (self), NULL);
 
-  return self->ical_components;
+  return G_LIST_MODEL (self->ical_components);
 }
 
 GPtrArray*
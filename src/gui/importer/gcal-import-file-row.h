@@ -32,7 +32,7 @@ G_DECLARE_FINAL_TYPE (GcalImportFileRow, gcal_import_file_row, GCAL, IMPORT_FILE
 GtkWidget*           gcal_import_file_row_new                    (GFile              *file,
                                                                   GtkSizeGroup       *title_sizegroup);
 
-GPtrArray*           gcal_import_file_row_get_ical_components    (GcalImportFileRow  *self);
+GListModel*          gcal_import_file_row_get_ical_components    (GcalImportFileRow  *self);
 GPtrArray*           gcal_import_file_row_get_timezones          (GcalImportFileRow  *self);
 
 G_END_DECLS
@@ -22,6 +22,43 @@
 #include "gcal-debug.h"
 
 #include <glib/gi18n.h>
+#include <string.h>
+
+#define COMPONENTS_PER_CHUNK 200
+#define UIDS_PER_QUERY       100
+
+typedef struct
+{
+  GFile                      *file;
+  GcalImporterComponentsFunc components_func;
+  gpointer                    components_data;
+} ImportFileData;
+
+typedef struct
+{
+  GTask              *task;
+  GPtrArray          *components;
+  gdouble             fraction;
+} ComponentsChunk;
+
+static void          read_file_in_thread                         (GTask              *task,
+                                                                  gpointer            source_object,
+                                                                  gpointer            task_data,
+                                                                  GCancellable       *cancellable);
+
+struct _GcalImportIndex
+{
+  GHashTable         *entries;
+  GHashTable         *uids;
+};
+
+typedef struct
+{
+  gint                sequence;
+  gint64              last_modified;
+} IndexEntry;
+
+static GOnce pool_once = G_ONCE_INIT;
 
 G_DEFINE_QUARK (ICalErrorEnum, i_cal_error);
 
@@ -62,37 +99,204 @@ static const gchar*
 guess_file_encoding (const gchar *contents,
                      gsize        length)
 {
-  if (length > 4 && contents[0] == '\xFF' && contents[1] == '\xFE' && contents[2] == '\x00' && contents[3] == '\x00') /* UTF-32LE case */
+  if (length >= 4 && contents[0] == '\xFF' && contents[1] == '\xFE' && contents[2] == '\x00' && contents[3] == '\x00') /* UTF-32LE case */
     return "UTF-32LE";
-  else if (length > 4 && contents[0] == '\x00' && contents[1] == '\x00' && contents[2] == '\xFE' && contents[3] == '\xFF') /* UTF-32BE case */
+  else if (length >= 4 && contents[0] == '\x00' && contents[1] == '\x00' && contents[2] == '\xFE' && contents[3] == '\xFF') /* UTF-32BE case */
     return "UTF-32BE";
-  else if (length > 2 && contents[0] == '\xFF' && contents[1] == '\xFE') /* UTF-16LE case */
+  else if (length >= 2 && contents[0] == '\xFF' && contents[1] == '\xFE') /* UTF-16LE case */
     return "UTF-16LE";
-  else if (length > 2 && contents[0] == '\xFE' && contents[1] == '\xFF') /* UTF-16BE case */
+  else if (length >= 2 && contents[0] == '\xFE' && contents[1] == '\xFF') /* UTF-16BE case */
     return "UTF-16BE";
 
   return "UTF-8";
 }
 
+static void
+import_file_data_free (ImportFileData *data)
+{
+  g_clear_object (&data->file);
+  g_free (data);
+}
+
+static void
+components_chunk_free (ComponentsChunk *chunk)
+{
+  g_clear_object (&chunk->task);
+  g_clear_pointer (&chunk->components, g_ptr_array_unref);
+  g_free (chunk);
+}
+
+static gboolean
+deliver_components_cb (gpointer user_data)
+{
+  ComponentsChunk *chunk = user_data;
+  ImportFileData *data;
+
+  data = g_task_get_task_data (chunk->task);
+
+  if (!g_cancellable_is_cancelled (g_task_get_cancellable (chunk->task)))
+    data->components_func (chunk->components, chunk->fraction, data->components_data);
+
+  return G_SOURCE_REMOVE;
+}
+
+/*
+ * Hands the parsed components over to the thread that started the
+ * import. Chunks are delivered in order, and before the task returns.
+ */
+static void
+deliver_components (GTask            *task,
+                    GFileInputStream *file_stream,
+                    goffset           file_size,
+                    GPtrArray       **components)
+{
+  ComponentsChunk *chunk;
+
+  if ((*components)->len == 0)
+    return;
+
+  chunk = g_new0 (ComponentsChunk, 1);
+  chunk->task = g_object_ref (task);
+  chunk->components = g_steal_pointer (components);
+
+  if (file_size > 0)
+    chunk->fraction = CLAMP ((gdouble) g_seekable_tell (G_SEEKABLE (file_stream)) / file_size, 0.0, 1.0);
+
+  g_main_context_invoke_full (g_task_get_context (task),
+                              G_PRIORITY_DEFAULT,
+                              deliver_components_cb,
+                              chunk,
+                              (GDestroyNotify) components_chunk_free);
+
+  *components = g_ptr_array_new_full (COMPONENTS_PER_CHUNK, g_object_unref);
+}
+
+static GInputStream*
+create_utf8_stream (GFileInputStream  *file_stream,
+                    GCancellable      *cancellable,
+                    GError           **error)
+{
+  g_autoptr (GCharsetConverter) converter = NULL;
+  g_autoptr (GInputStream) buffered_stream = NULL;
+  const gchar *encoding;
+  const gchar *buffer;
+  gsize length;
+
+  buffered_stream = g_buffered_input_stream_new (G_INPUT_STREAM (file_stream));
+
+  if (g_buffered_input_stream_fill (G_BUFFERED_INPUT_STREAM (buffered_stream), 4, cancellable, error) < 0)
+    return NULL;
+
+  buffer = g_buffered_input_stream_peek_buffer (G_BUFFERED_INPUT_STREAM (buffered_stream), &length);
+  encoding = guess_file_encoding (buffer, length);
+
+  if (g_strcmp0 (encoding, "UTF-8") == 0)
+    return g_steal_pointer (&buffered_stream);
+
+  GCAL_TRACE_MSG ("Converting file from %s to UTF-8", encoding);
+
+  converter = g_charset_converter_new ("UTF-8", encoding, error);
+
+  if (!converter)
+    return NULL;
+
+  return g_converter_input_stream_new (buffered_stream, G_CONVERTER (converter));
+}
+
+static inline gboolean
+line_has_prefix (const gchar *line,
+                 const gchar *prefix)
+{
+  return g_ascii_strncasecmp (line, prefix, strlen (prefix)) == 0;
+}
+
+static gchar*
+get_index_key (ICalComponent *component)
+{
+  g_autoptr (ICalTime) recurrence_id = NULL;
+  g_autofree gchar *rid = NULL;
+
+  recurrence_id = i_cal_component_get_recurrenceid (component);
+
+  if (recurrence_id && !i_cal_time_is_null_time (recurrence_id))
+    rid = i_cal_time_as_ical_string (recurrence_id);
+
+  return g_strdup_printf ("%s\n%s", i_cal_component_get_uid (component), rid ? rid : "");
+}
+
+static gint64
+get_last_modified (ICalComponent *component)
+{
+  g_autoptr (ICalProperty) property = NULL;
+  g_autoptr (ICalTime) last_modified = NULL;
+
+  property = i_cal_component_get_first_property (component, I_CAL_LASTMODIFIED_PROPERTY);
+
+  if (!property)
+    return 0;
+
+  last_modified = i_cal_property_get_lastmodified (property);
+
+  return i_cal_time_as_timet (last_modified);
+}
+
+static gpointer
+create_thread_pool (gpointer data)
+{
+  g_autoptr (GError) error = NULL;
+  GThreadPool *pool;
+
+  pool = g_thread_pool_new ((GFunc) data,
+                            NULL,
+                            MAX (1, g_get_num_processors ()),
+                            FALSE,
+                            &error);
+
+  if (error)
+    g_error ("Failed to create the importer thread pool: %s", error->message);
+
+  return pool;
+}
+
+static void
+run_task_in_pool (gpointer data,
+                  gpointer user_data)
+{
+  g_autoptr (GTask) task = data;
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  read_file_in_thread (task,
+                       g_task_get_source_object (task),
+                       g_task_get_task_data (task),
+                       g_task_get_cancellable (task));
+}
+
 static void
 read_file_in_thread (GTask        *task,
                      gpointer      source_object,
                      gpointer      task_data,
                      GCancellable *cancellable)
 {
+  g_autoptr (GFileInputStream) file_stream = NULL;
+  g_autoptr (GDataInputStream) data_stream = NULL;
+  g_autoptr (GPtrArray) components = NULL;
+  g_autoptr (GPtrArray) timezones = NULL;
+  g_autoptr (GInputStream) stream = NULL;
   g_autoptr (GFileInfo) file_info = NULL;
+  g_autoptr (GString) block = NULL;
   g_autoptr (GError) error = NULL;
-  g_autofree gchar *contents = NULL;
-  g_autofree gchar *path = NULL;
-  const gchar *encoding = NULL;
-  ICalComponent *component;
-  ICalErrorEnum ical_error;
-  gsize length;
-  GFile *file;
-
-  file = task_data;
-  file_info = g_file_query_info (file,
-                                 G_FILE_ATTRIBUTE_STANDARD_CONTENT_TYPE,
+  ImportFileData *data;
+  gboolean first_line;
+  goffset file_size;
+  gchar *line;
+  guint n_components;
+  guint depth;
+
+  data = task_data;
+  file_info = g_file_query_info (data->file,
+                                 G_FILE_ATTRIBUTE_STANDARD_CONTENT_TYPE "," G_FILE_ATTRIBUTE_STANDARD_SIZE,
                                  G_FILE_QUERY_INFO_NONE,
                                  cancellable,
                                  &error);
@@ -113,53 +317,104 @@ read_file_in_thread (GTask        *task,
       return;
     }
 
-  path = g_file_get_path (file);
-  g_file_get_contents (path, &contents, &length, &error);
+  file_size = g_file_info_get_size (file_info);
+  file_stream = g_file_read (data->file, cancellable, &error);
 
-  if (error)
+  if (file_stream)
+    stream = create_utf8_stream (file_stream, cancellable, &error);
+
+  if (!stream)
     {
       g_task_return_error (task, g_steal_pointer (&error));
       return;
     }
 
-  encoding = guess_file_encoding (contents, length);
-
-  if (g_strcmp0 (encoding, "UTF-8") != 0)
+  data_stream = g_data_input_stream_new (stream);
+  g_data_input_stream_set_newline_type (data_stream, G_DATA_STREAM_NEWLINE_TYPE_ANY);
+
+  components = g_ptr_array_new_full (COMPONENTS_PER_CHUNK, g_object_unref);
+  timezones = g_ptr_array_new_with_free_func (g_object_unref);
+  block = g_string_new (NULL);
+  first_line = TRUE;
+  n_components = 0;
+  depth = 0;
+
+  /*
+   * Instead of parsing the whole calendar at once, each component
+   * inside the VCALENDAR is collected and parsed on its own, so only
+   * one of them is kept as text at any time.
+   */
+  while ((line = g_data_input_stream_read_line_utf8 (data_stream, NULL, cancellable, &error)) != NULL)
     {
-      g_autofree gchar *content_converted = NULL;
-      gsize new_length;
+      g_autofree gchar *owned_line = line;
+      g_autoptr (ICalComponent) component = NULL;
 
-      GCAL_TRACE_MSG ("Converting file from %s to UTF-8", encoding);
+      /* Byte order marks are converted too */
+      if (first_line && g_str_has_prefix (line, "\xEF\xBB\xBF"))
+        line += 3;
 
-      content_converted = g_convert (contents, length, "UTF-8", encoding, NULL, &new_length, &error);
+      first_line = FALSE;
 
-      if (error)
+      if (depth == 0)
         {
-          g_task_return_error (task, g_steal_pointer (&error));
-          return;
+          /* Skip the VCALENDAR wrapper, and its properties */
+          if (!line_has_prefix (line, "BEGIN:") || line_has_prefix (line, "BEGIN:VCALENDAR"))
+            continue;
+
+          g_string_truncate (block, 0);
         }
 
-      g_clear_pointer (&contents, g_free);
-      contents = g_steal_pointer (&content_converted);
-      length = new_length;
-    }
+      g_string_append (block, line);
+      g_string_append (block, "\r\n");
+
+      if (line_has_prefix (line, "BEGIN:"))
+        depth++;
+      else if (line_has_prefix (line, "END:"))
+        depth--;
+
+      if (depth > 0)
+        continue;
+
+      component = i_cal_component_new_from_string (block->str);
+
+      if (!component)
+        {
+          g_debug ("Ignoring malformed component in %s", g_file_peek_path (data->file));
+          continue;
+        }
+
+      n_components++;
+
+      switch (i_cal_component_isa (component))
+        {
+        case I_CAL_VEVENT_COMPONENT:
+          g_ptr_array_add (components, g_steal_pointer (&component));
+
+          if (components->len == COMPONENTS_PER_CHUNK)
+            deliver_components (task, file_stream, file_size, &components);
+          break;
+
+        case I_CAL_VTIMEZONE_COMPONENT:
+          {
+            g_autoptr (ICalTimezone) zone = i_cal_timezone_new ();
 
-  g_assert (g_utf8_validate (contents, length, NULL));
+            if (i_cal_timezone_set_component (zone, component))
+              g_ptr_array_add (timezones, g_steal_pointer (&zone));
+          }
+          break;
 
-  component = i_cal_parser_parse_string (contents);
-  ical_error = i_cal_errno_return ();
+        default:
+          break;
+        }
+    }
 
-  if (ical_error != I_CAL_NO_ERROR)
+  if (error)
     {
-      g_task_return_new_error (task,
-                               I_CAL_ERROR,
-                               ical_error,
-                               "%s",
-                               i_cal_error_enum_to_string (ical_error));
+      g_task_return_error (task, g_steal_pointer (&error));
       return;
     }
 
-  if (!component)
+  if (n_components == 0)
     {
       g_task_return_new_error (task,
                                I_CAL_ERROR,
@@ -169,47 +424,258 @@ read_file_in_thread (GTask        *task,
       return;
     }
 
-  g_task_return_pointer (task, g_object_ref (component), g_object_unref);
+  deliver_components (task, file_stream, file_size, &components);
+
+  g_task_return_pointer (task, g_steal_pointer (&timezones), (GDestroyNotify) g_ptr_array_unref);
 }
 
 /**
  * gcal_importer_import_file:
  * @file: a #GFile
  * @cancellable: (nullable): a #GCancellable
+ * @components_func: function called with the parsed events, and how
+ *   much of the file was read
+ * @components_data: closure data for @components_func
  * @callback: a #GAsyncReadyCallback to execute upon completion
  * @user_data: closure data for @callback
  *
- * Import an ICS file.
+ * Import an ICS file. The file is read and parsed incrementally in a
+ * worker thread, and @components_func is called in the thread-default main
+ * context with each chunk of parsed events, before @callback.
  */
 void
-gcal_importer_import_file (GFile               *file,
-                           GCancellable        *cancellable,
-                           GAsyncReadyCallback  callback,
-                           gpointer             user_data)
+gcal_importer_import_file (GFile                      *file,
+                           GCancellable               *cancellable,
+                           GcalImporterComponentsFunc  components_func,
+                           gpointer                    components_data,
+                           GAsyncReadyCallback         callback,
+                           gpointer                    user_data)
 {
-
   g_autoptr (GTask) task = NULL;
+  ImportFileData *data;
 
+  g_return_if_fail (G_IS_FILE (file));
   g_return_if_fail (!cancellable || G_IS_CANCELLABLE (cancellable));
+  g_return_if_fail (components_func != NULL);
+
+  data = g_new0 (ImportFileData, 1);
+  data->file = g_object_ref (file);
+  data->components_func = components_func;
+  data->components_data = components_data;
 
   task = g_task_new (NULL, cancellable, callback, user_data);
-  g_task_set_task_data (task, g_object_ref (file), g_object_unref);
+  g_task_set_task_data (task, data, (GDestroyNotify) import_file_data_free);
   g_task_set_source_tag (task, gcal_importer_import_file);
-  g_task_run_in_thread (task, read_file_in_thread);
+
+  /*
+   * Files are parsed in a dedicated pool with one thread per CPU, so
+   * that dropping lots of files at once neither starves the shared
+   * GTask pool nor runs more parsers than there are CPUs.
+   */
+  g_once (&pool_once, create_thread_pool, run_task_in_pool);
+  g_thread_pool_push (pool_once.retval, g_steal_pointer (&task), NULL);
 }
 
 /**
- * gcal_importer_do_something_finish:
+ * gcal_importer_import_file_finish:
  * @result: a #GAsyncResult provided to callback
  * @error: a location for a #GError, or %NULL
  *
- * Returns: (nullable): an #ICalComponent
+ * Returns: (transfer full)(element-type ICalTimezone)(nullable): the
+ *   timezones defined in the file
  */
-ICalComponent*
+GPtrArray*
 gcal_importer_import_file_finish (GAsyncResult  *result,
                                   GError       **error)
 {
-  g_return_val_if_fail (g_task_is_valid (result, NULL), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, NULL), NULL);
 
   return g_task_propagate_pointer (G_TASK (result), error);
 }
+
+/**
+ * gcal_import_index_new:
+ *
+ * Creates an empty index of calendar components, used to tell which
+ * of the imported components already exist in a calendar.
+ *
+ * Returns: (transfer full): a #GcalImportIndex
+ */
+GcalImportIndex*
+gcal_import_index_new (void)
+{
+  GcalImportIndex *self;
+
+  self = g_new0 (GcalImportIndex, 1);
+  self->entries = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  self->uids = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  return self;
+}
+
+/**
+ * gcal_import_index_free:
+ * @self: a #GcalImportIndex
+ *
+ * Frees @self.
+ */
+void
+gcal_import_index_free (GcalImportIndex *self)
+{
+  g_return_if_fail (self != NULL);
+
+  g_clear_pointer (&self->entries, g_hash_table_destroy);
+  g_clear_pointer (&self->uids, g_hash_table_destroy);
+  g_free (self);
+}
+
+/**
+ * gcal_import_index_add:
+ * @self: a #GcalImportIndex
+ * @component: an #ICalComponent existing in the calendar
+ *
+ * Adds the UID, SEQUENCE and LAST-MODIFIED of @component to @self.
+ */
+void
+gcal_import_index_add (GcalImportIndex *self,
+                       ICalComponent   *component)
+{
+  IndexEntry *entry;
+  const gchar *uid;
+
+  g_return_if_fail (self != NULL);
+  g_return_if_fail (I_CAL_IS_COMPONENT (component));
+
+  uid = i_cal_component_get_uid (component);
+
+  if (!uid)
+    return;
+
+  entry = g_new0 (IndexEntry, 1);
+  entry->sequence = i_cal_component_get_sequence (component);
+  entry->last_modified = get_last_modified (component);
+
+  g_hash_table_insert (self->entries, get_index_key (component), entry);
+  g_hash_table_add (self->uids, g_strdup (uid));
+}
+
+/**
+ * gcal_import_index_classify:
+ * @self: a #GcalImportIndex
+ * @component: an imported #ICalComponent
+ *
+ * Compares @component against the existing component with the same
+ * UID and RECURRENCE-ID, if any. A higher SEQUENCE, or the same
+ * SEQUENCE and a more recent LAST-MODIFIED, make it newer.
+ *
+ * Returns: whether @component must be created, used to modify the
+ *   existing component, or skipped
+ */
+GcalImportAction
+gcal_import_index_classify (GcalImportIndex *self,
+                            ICalComponent   *component)
+{
+  g_autofree gchar *key = NULL;
+  IndexEntry *entry;
+  const gchar *uid;
+  gint sequence;
+
+  g_return_val_if_fail (self != NULL, GCAL_IMPORT_ACTION_CREATE);
+  g_return_val_if_fail (I_CAL_IS_COMPONENT (component), GCAL_IMPORT_ACTION_CREATE);
+
+  uid = i_cal_component_get_uid (component);
+
+  if (!uid || !g_hash_table_contains (self->uids, uid))
+    return GCAL_IMPORT_ACTION_CREATE;
+
+  key = get_index_key (component);
+  entry = g_hash_table_lookup (self->entries, key);
+
+  /* A new detached instance of an existing event */
+  if (!entry)
+    return GCAL_IMPORT_ACTION_MODIFY;
+
+  sequence = i_cal_component_get_sequence (component);
+
+  if (sequence > entry->sequence)
+    return GCAL_IMPORT_ACTION_MODIFY;
+
+  if (sequence == entry->sequence && get_last_modified (component) > entry->last_modified)
+    return GCAL_IMPORT_ACTION_MODIFY;
+
+  return GCAL_IMPORT_ACTION_SKIP;
+}
+
+/**
+ * gcal_importer_query_index:
+ * @client: an #ECalClient
+ * @components: (element-type ICalComponent): the imported components
+ * @cancellable: (nullable): a #GCancellable
+ * @error: a location for a #GError, or %NULL
+ *
+ * Synchronously queries @client for the components that share their
+ * UID with any of @components, and indexes them. Only those objects
+ * are transferred from the backend, not the whole calendar.
+ *
+ * Returns: (transfer full)(nullable): a #GcalImportIndex
+ */
+GcalImportIndex*
+gcal_importer_query_index (ECalClient    *client,
+                           GPtrArray     *components,
+                           GCancellable  *cancellable,
+                           GError       **error)
+{
+  g_autoptr (GcalImportIndex) index = NULL;
+  g_autoptr (GHashTable) queried_uids = NULL;
+  g_autoptr (GString) sexp = NULL;
+  guint n_uids;
+  guint i;
+
+  g_return_val_if_fail (E_IS_CAL_CLIENT (client), NULL);
+  g_return_val_if_fail (components != NULL, NULL);
+
+  index = gcal_import_index_new ();
+  queried_uids = g_hash_table_new (g_str_hash, g_str_equal);
+  sexp = g_string_new (NULL);
+  n_uids = 0;
+
+  for (i = 0; i <= components->len; i++)
+    {
+      GSList *existing = NULL;
+      GSList *l;
+
+      if (i < components->len)
+        {
+          const gchar *uid = i_cal_component_get_uid (g_ptr_array_index (components, i));
+
+          if (!uid || !g_hash_table_add (queried_uids, (gpointer) uid))
+            continue;
+
+          if (n_uids == 0)
+            g_string_assign (sexp, "(or");
+
+          g_string_append (sexp, " (uid? ");
+          e_sexp_encode_string (sexp, uid);
+          g_string_append (sexp, ")");
+
+          if (++n_uids < UIDS_PER_QUERY)
+            continue;
+        }
+
+      if (n_uids == 0)
+        break;
+
+      g_string_append (sexp, ")");
+      n_uids = 0;
+
+      if (!e_cal_client_get_object_list_sync (client, sexp->str, &existing, cancellable, error))
+        return NULL;
+
+      for (l = existing; l; l = l->next)
+        gcal_import_index_add (index, l->data);
+
+      g_slist_free_full (existing, g_object_unref);
+    }
+
+  return g_steal_pointer (&index);
+}
@@ -27,14 +27,63 @@
 G_BEGIN_DECLS
 
 #define I_CAL_ERROR i_cal_error_quark ()
+
+/**
+ * GcalImportAction:
+ * @GCAL_IMPORT_ACTION_CREATE: the component doesn't exist in the calendar
+ * @GCAL_IMPORT_ACTION_MODIFY: the component is newer than the existing one
+ * @GCAL_IMPORT_ACTION_SKIP: the component is identical to, or older than, the existing one
+ *
+ * What to do with an imported component.
+ */
+typedef enum
+{
+  GCAL_IMPORT_ACTION_CREATE,
+  GCAL_IMPORT_ACTION_MODIFY,
+  GCAL_IMPORT_ACTION_SKIP,
+} GcalImportAction;
+
+typedef struct _GcalImportIndex GcalImportIndex;
+
 GQuark               i_cal_error_quark                           (void);
 
-void                 gcal_importer_import_file                   (GFile               *file,
-                                                                  GCancellable        *cancellable,
-                                                                  GAsyncReadyCallback  callback,
-                                                                  gpointer             user_data);
+/**
+ * GcalImporterComponentsFunc:
+ * @components: (element-type ICalComponent): a chunk of parsed events
+ * @fraction: the fraction of the file read so far, from 0.0 to 1.0
+ * @user_data: closure data
+ *
+ * Called with the events of an ICS file as they are parsed.
+ */
+typedef void (*GcalImporterComponentsFunc) (GPtrArray *components,
+                                            gdouble    fraction,
+                                            gpointer   user_data);
+
+void                 gcal_importer_import_file                   (GFile                      *file,
+                                                                  GCancellable               *cancellable,
+                                                                  GcalImporterComponentsFunc  components_func,
+                                                                  gpointer                    components_data,
+                                                                  GAsyncReadyCallback         callback,
+                                                                  gpointer                    user_data);
 
-ICalComponent*       gcal_importer_import_file_finish            (GAsyncResult       *result,
+GPtrArray*           gcal_importer_import_file_finish            (GAsyncResult       *result,
                                                                   GError            **error);
 
+GcalImportIndex*     gcal_import_index_new                       (void);
+
+void                 gcal_import_index_free                      (GcalImportIndex    *self);
+
+void                 gcal_import_index_add                       (GcalImportIndex    *self,
+                                                                  ICalComponent      *component);
+
+GcalImportAction     gcal_import_index_classify                  (GcalImportIndex    *self,
+                                                                  ICalComponent      *component);
+
+GcalImportIndex*     gcal_importer_query_index                   (ECalClient         *client,
+                                                                  GPtrArray          *components,
+                                                                  GCancellable       *cancellable,
+                                                                  GError            **error);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GcalImportIndex, gcal_import_index_free)
+
 G_END_DECLS
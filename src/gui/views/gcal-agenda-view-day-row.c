@@ -20,6 +20,9 @@
  */
 
 #include "gcal-agenda-view-day-row.h"
+#include "gcal-application.h"
+#include "gcal-clock.h"
+#include "gcal-context.h"
 #include "gcal-date-time-utils.h"
 #include "gcal-debug.h"
 #include "gcal-enums.h"
@@ -62,22 +65,20 @@ static guint signals[N_SIGNALS] = { 0, };
 static gchar *
 new_date_header_string (GDateTime *date)
 {
-  g_autoptr (GDateTime) today = NULL;
-  g_autoptr (GDateTime) tomorrow = NULL;
-  g_autoptr (GDateTime) yesterday = NULL;
+  GcalContext *context;
+  gint64 days_diff;
 
   if (date == NULL)
     return NULL;
 
-  today = g_date_time_new_now_local ();
-  tomorrow = g_date_time_add_days (today, 1);
-  yesterday = g_date_time_add_days (today, -1);
+  context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  days_diff = gcal_date_time_get_julian_day (date) - gcal_clock_get_today (gcal_context_get_clock (context));
 
-  if (gcal_date_time_compare_date (date, today) == 0)
+  if (days_diff == 0)
     return g_strdup (_("Today"));
-  else if (gcal_date_time_compare_date (date, tomorrow) == 0)
+  else if (days_diff == 1)
     return g_strdup (_("Tomorrow"));
-  else if (gcal_date_time_compare_date (date, yesterday) == 0)
+  else if (days_diff == -1)
     return g_strdup (_("Yesterday"));
   else
     /*
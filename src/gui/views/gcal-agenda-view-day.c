@@ -24,16 +24,14 @@
 #include "gcal-agenda-view-day.h"
 
 #include "gcal-date-time-utils.h"
-#include "gcal-range.h"
 
 struct _GcalAgendaViewDay
 {
   GObject parent_instance;
 
   GDateTime *date;
-  GcalRange *range;
 
-  GtkFilterListModel *filtered_events;
+  GListStore *events;
 };
 
 static void          g_list_model_interface_init                 (GListModelInterface *iface);
@@ -44,7 +42,6 @@ G_DEFINE_FINAL_TYPE_WITH_CODE (GcalAgendaViewDay, gcal_agenda_view_day, G_TYPE_O
 enum {
   PROP_0,
   PROP_DATE,
-  PROP_MODEL,
   PROP_N_ITEMS,
   N_PROPS,
 };
@@ -56,11 +53,11 @@ static GParamSpec *properties [N_PROPS];
  * Callbacks
  */
 static void
-on_filtered_events_items_changed_cb (GListModel        *model,
-                                     unsigned int       position,
-                                     unsigned int       removed,
-                                     unsigned int       added,
-                                     GcalAgendaViewDay *self)
+on_events_items_changed_cb (GListModel        *model,
+                            unsigned int       position,
+                            unsigned int       removed,
+                            unsigned int       added,
+                            GcalAgendaViewDay *self)
 {
   g_list_model_items_changed (G_LIST_MODEL (self), position, removed, added);
   if (removed != added)
@@ -85,7 +82,7 @@ gcal_agenda_view_day_get_n_items (GListModel *model)
 
   g_assert (GCAL_IS_AGENDA_VIEW_DAY (self));
 
-  return g_list_model_get_n_items (G_LIST_MODEL (self->filtered_events));
+  return g_list_model_get_n_items (G_LIST_MODEL (self->events));
 }
 
 static gpointer
@@ -96,7 +93,7 @@ gcal_agenda_view_day_get_item (GListModel *model,
 
   g_assert (GCAL_IS_AGENDA_VIEW_DAY (self));
 
-  return g_list_model_get_item (G_LIST_MODEL (self->filtered_events), position);
+  return g_list_model_get_item (G_LIST_MODEL (self->events), position);
 }
 
 static void
@@ -117,7 +114,7 @@ gcal_agenda_view_day_dispose (GObject *object)
 {
   GcalAgendaViewDay *self = (GcalAgendaViewDay *)object;
 
-  g_clear_pointer (&self->range, gcal_range_unref);
+  g_clear_object (&self->events);
   gcal_clear_date_time (&self->date);
 
   G_OBJECT_CLASS (gcal_agenda_view_day_parent_class)->dispose (object);
@@ -137,12 +134,8 @@ gcal_agenda_view_day_get_property (GObject    *object,
       g_value_set_boxed (value, self->date);
       break;
 
-    case PROP_MODEL:
-      g_value_set_object (value, gcal_agenda_view_day_get_model (self));
-      break;
-
     case PROP_N_ITEMS:
-      g_value_set_uint (value, g_list_model_get_n_items (G_LIST_MODEL (self->filtered_events)));
+      g_value_set_uint (value, g_list_model_get_n_items (G_LIST_MODEL (self->events)));
       break;
 
     default:
@@ -164,10 +157,6 @@ gcal_agenda_view_day_set_property (GObject      *object,
       gcal_agenda_view_day_set_date (self, g_value_get_boxed (value));
       break;
 
-    case PROP_MODEL:
-      gcal_agenda_view_day_set_model (self, g_value_get_object (value));
-      break;
-
     case PROP_N_ITEMS:
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -187,10 +176,6 @@ gcal_agenda_view_day_class_init (GcalAgendaViewDayClass *klass)
                                               G_TYPE_DATE_TIME,
                                               G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
 
-  properties[PROP_MODEL] = g_param_spec_object ("model", NULL, NULL,
-                                                G_TYPE_LIST_MODEL,
-                                                G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
-
   properties[PROP_N_ITEMS] = g_param_spec_uint ("n-items", NULL, NULL,
                                                 0, G_MAXUINT, 0,
                                                 G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
@@ -198,27 +183,11 @@ gcal_agenda_view_day_class_init (GcalAgendaViewDayClass *klass)
   g_object_class_install_properties (object_class, N_PROPS, properties);
 }
 
-static gboolean
-filter_events_func (gpointer item,
-                    gpointer user_data)
-{
-  GcalAgendaViewDay *self = (GcalAgendaViewDay *) user_data;
-
-  g_assert (GCAL_IS_EVENT (item));
-  g_assert (GCAL_IS_AGENDA_VIEW_DAY (self));
-
-  if (!self->range)
-    return FALSE;
-
-  return gcal_event_overlaps (item, self->range);
-}
-
 static void
 gcal_agenda_view_day_init (GcalAgendaViewDay *self)
 {
-  self->filtered_events = gtk_filter_list_model_new (NULL,
-                                                     GTK_FILTER (gtk_custom_filter_new (filter_events_func, self, NULL)));
-  g_signal_connect (self->filtered_events, "items-changed", G_CALLBACK (on_filtered_events_items_changed_cb), self);
+  self->events = g_list_store_new (GCAL_TYPE_EVENT);
+  g_signal_connect (self->events, "items-changed", G_CALLBACK (on_events_items_changed_cb), self);
 }
 
 GcalAgendaViewDay *
@@ -242,53 +211,44 @@ gcal_agenda_view_day_set_date (GcalAgendaViewDay *self,
   g_assert (GCAL_IS_AGENDA_VIEW_DAY (self));
 
   if (gcal_set_date_time (&self->date, date))
-    {
-      GtkFilter *filter = NULL;
-
-      g_clear_pointer (&self->range, gcal_range_unref);
-
-      if (date)
-        {
-          g_autoptr (GDateTime) start = NULL;
-          g_autoptr (GDateTime) end = NULL;
-
-          start = g_date_time_new (g_date_time_get_timezone (date),
-                                   g_date_time_get_year (date),
-                                   g_date_time_get_month (date),
-                                   g_date_time_get_day_of_month (date),
-                                   0, 0, 0);
-          end = g_date_time_add_days (start, 1);
-
-          self->range = gcal_range_new_take (g_steal_pointer (&start),
-                                             g_steal_pointer (&end),
-                                             GCAL_RANGE_DEFAULT);
-        }
-
-      filter = gtk_filter_list_model_get_filter (self->filtered_events);
-      // FIXME: better filter change
-      gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
-
-      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_DATE]);
-    }
-}
-
-GListModel *
-gcal_agenda_view_day_get_model (GcalAgendaViewDay *self)
-{
-  g_assert (GCAL_IS_AGENDA_VIEW_DAY (self));
-
-  return gtk_filter_list_model_get_model (self->filtered_events);
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_DATE]);
 }
 
+/**
+ * gcal_agenda_view_day_set_events:
+ * @self: a #GcalAgendaViewDay
+ * @events: (array length=n_events): the events of this day
+ * @n_events: the number of events in @events
+ *
+ * Sets the events of @self. The events are bucketed by the agenda
+ * view, and this is a no-op when @events is what @self already
+ * contains, so rows bound to @self are not rebuilt for nothing.
+ */
 void
-gcal_agenda_view_day_set_model (GcalAgendaViewDay *self,
-                                GListModel        *model)
+gcal_agenda_view_day_set_events (GcalAgendaViewDay  *self,
+                                 GcalEvent         **events,
+                                 guint               n_events)
 {
+  guint n_items;
+  guint i;
+
   g_assert (GCAL_IS_AGENDA_VIEW_DAY (self));
 
-  if (gtk_filter_list_model_get_model (self->filtered_events) != model)
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (self->events));
+
+  if (n_items == n_events)
     {
-      gtk_filter_list_model_set_model (self->filtered_events, model);
-      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_MODEL]);
+      for (i = 0; i < n_items; i++)
+        {
+          g_autoptr (GcalEvent) event = g_list_model_get_item (G_LIST_MODEL (self->events), i);
+
+          if (event != events[i])
+            break;
+        }
+
+      if (i == n_items)
+        return;
     }
+
+  g_list_store_splice (self->events, 0, n_items, (gpointer *) events, n_events);
 }
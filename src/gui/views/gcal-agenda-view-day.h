@@ -28,12 +28,12 @@ G_BEGIN_DECLS
 #define GCAL_TYPE_AGENDA_VIEW_DAY (gcal_agenda_view_day_get_type())
 G_DECLARE_FINAL_TYPE (GcalAgendaViewDay, gcal_agenda_view_day, GCAL, AGENDA_VIEW_DAY, GObject)
 
-GcalAgendaViewDay *gcal_agenda_view_day_new       (void);
-GDateTime         *gcal_agenda_view_day_get_date  (GcalAgendaViewDay *self);
-void               gcal_agenda_view_day_set_date  (GcalAgendaViewDay *self,
-                                                   GDateTime         *date);
-GListModel        *gcal_agenda_view_day_get_model (GcalAgendaViewDay *self);
-void               gcal_agenda_view_day_set_model (GcalAgendaViewDay *self,
-                                                   GListModel        *model);
+GcalAgendaViewDay *gcal_agenda_view_day_new        (void);
+GDateTime         *gcal_agenda_view_day_get_date   (GcalAgendaViewDay  *self);
+void               gcal_agenda_view_day_set_date   (GcalAgendaViewDay  *self,
+                                                    GDateTime          *date);
+void               gcal_agenda_view_day_set_events (GcalAgendaViewDay  *self,
+                                                    GcalEvent         **events,
+                                                    guint               n_events);
 
 G_END_DECLS
@@ -31,7 +31,8 @@
 
 #include <adwaita.h>
 
-#include <math.h>
+#define N_DAYS_PER_PAGE N_WEEKDAYS
+#define MAX_DAYS        366
 
 typedef struct
 {
@@ -51,6 +52,10 @@ struct _GcalAgendaView
   GListStore         *days_model;
   GtkFilterListModel *filtered_days;
 
+  /* Events of the timeline, bucketed into days_model */
+  GListModel         *model;
+  gboolean            days_valid;
+
   guint               scroll_grid_timeout_id;
   gulong              stack_page_changed_id;
 
@@ -60,6 +65,10 @@ struct _GcalAgendaView
 
 static void          schedule_position_scroll                    (GcalAgendaView       *self);
 
+static gboolean      days_tick_cb                                (GtkWidget            *widget,
+                                                                  GdkFrameClock        *frame_clock,
+                                                                  gpointer              user_data);
+
 static void          gcal_view_interface_init                    (GcalViewInterface  *iface);
 
 static void          gcal_timeline_subscriber_interface_init     (GcalTimelineSubscriberInterface *iface);
@@ -82,11 +91,217 @@ G_DEFINE_TYPE_WITH_CODE (GcalAgendaView, gcal_agenda_view, GTK_TYPE_BOX,
  * Auxiliary methods
  */
 
+/*
+ * Distributes the events of the timeline into the days, in a single pass
+ * over the model. Days whose events didn't change are left untouched, so
+ * their rows are not rebuilt.
+ */
+static void
+rebuild_days (GcalAgendaView *self)
+{
+  g_autoptr (GPtrArray) day_events = NULL;
+  gint64 first_day;
+  guint n_events;
+  guint n_days;
+  guint i;
+
+  GCAL_ENTRY;
+
+  n_days = g_list_model_get_n_items (G_LIST_MODEL (self->days_model));
+  n_events = self->model ? g_list_model_get_n_items (self->model) : 0;
+  first_day = gcal_date_time_get_julian_day (self->date);
+
+  GCAL_TRACE_MSG ("Distributing %u events into %u days", n_events, n_days);
+
+  /* The model keeps the events alive, no need to reference them here */
+  day_events = g_ptr_array_new_full (n_days, (GDestroyNotify) g_ptr_array_unref);
+  for (i = 0; i < n_days; i++)
+    g_ptr_array_add (day_events, g_ptr_array_new ());
+
+  for (i = 0; i < n_events; i++)
+    {
+      g_autoptr (GcalEvent) event = g_list_model_get_item (self->model, i);
+      gint64 first, last;
+      gint64 day;
+
+      gcal_event_get_local_days (event, &first, &last);
+
+      first = MAX (first - first_day, 0);
+      last = MIN (last - first_day, (gint64) n_days - 1);
+
+      for (day = first; day <= last; day++)
+        g_ptr_array_add (g_ptr_array_index (day_events, day), event);
+    }
+
+  for (i = 0; i < n_days; i++)
+    {
+      g_autoptr (GcalAgendaViewDay) day = g_list_model_get_item (G_LIST_MODEL (self->days_model), i);
+      GPtrArray *events = g_ptr_array_index (day_events, i);
+
+      gcal_agenda_view_day_set_events (day, (GcalEvent **) events->pdata, events->len);
+    }
+
+  self->days_valid = TRUE;
+
+  GCAL_EXIT;
+}
+
+static void
+invalidate_days (GcalAgendaView *self)
+{
+  if (!self->days_valid)
+    return;
+
+  if (gtk_widget_get_mapped (GTK_WIDGET (self)))
+    gtk_widget_add_tick_callback (GTK_WIDGET (self), days_tick_cb, self, NULL);
+
+  self->days_valid = FALSE;
+}
+
+static void
+append_days (GcalAgendaView *self,
+             guint           n_days)
+{
+  g_autoptr (GPtrArray) new_days = NULL;
+  guint n_items;
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (self->days_model));
+  new_days = g_ptr_array_new_full (n_days, g_object_unref);
+
+  for (guint i = 0; i < n_days; i++)
+    {
+      g_autoptr (GDateTime) date = NULL;
+      GcalAgendaViewDay *day;
+
+      date = g_date_time_add_days (self->date, n_items + i);
+
+      day = gcal_agenda_view_day_new ();
+      gcal_agenda_view_day_set_date (day, date);
+
+      g_ptr_array_add (new_days, day);
+    }
+
+  g_list_store_splice (self->days_model, n_items, 0, new_days->pdata, new_days->len);
+}
+
+static void
+reset_days (GcalAgendaView *self)
+{
+  guint n_items;
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (self->days_model));
+
+  /* Go back to a single page of days, the rest is loaded on demand */
+  if (n_items > N_DAYS_PER_PAGE)
+    {
+      g_list_store_splice (self->days_model, N_DAYS_PER_PAGE, n_items - N_DAYS_PER_PAGE, NULL, 0);
+      n_items = N_DAYS_PER_PAGE;
+    }
+
+  for (guint i = 0; i < n_items; i++)
+    {
+      g_autoptr (GcalAgendaViewDay) day = NULL;
+      g_autoptr (GDateTime) date = NULL;
+
+      day = g_list_model_get_item (G_LIST_MODEL (self->days_model), i);
+      date = g_date_time_add_days (self->date, i);
+
+      gcal_agenda_view_day_set_date (day, date);
+    }
+
+  if (n_items < N_DAYS_PER_PAGE)
+    append_days (self, N_DAYS_PER_PAGE - n_items);
+}
+
+static void
+load_more_days (GcalAgendaView *self)
+{
+  guint n_days;
+
+  n_days = g_list_model_get_n_items (G_LIST_MODEL (self->days_model));
+  if (n_days >= MAX_DAYS)
+    return;
+
+  GCAL_TRACE_MSG ("Loading more days into the agenda (%u days loaded)", n_days);
+
+  append_days (self, MIN (N_DAYS_PER_PAGE, MAX_DAYS - n_days));
+  invalidate_days (self);
+
+  gcal_timeline_subscriber_range_changed (GCAL_TIMELINE_SUBSCRIBER (self));
+}
+
+/*
+ * Only scrolling loads more days. Loading them on model or size changes
+ * would cascade, since the new days change the model and the size again.
+ */
+static void
+maybe_load_more_days (GcalAgendaView *self)
+{
+  GtkAdjustment *vadjustment;
+  gdouble page_size;
+
+  if (!gtk_widget_get_mapped (GTK_WIDGET (self)))
+    return;
+
+  vadjustment = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (self->scrolled_window));
+  page_size = gtk_adjustment_get_page_size (vadjustment);
+
+  /* Keep at least one page of content below the viewport */
+  if (page_size == 0.0 ||
+      gtk_adjustment_get_value (vadjustment) + 2 * page_size < gtk_adjustment_get_upper (vadjustment))
+    {
+      return;
+    }
+
+  load_more_days (self);
+}
+
 
 /*
  * Callbacks
  */
 
+static gboolean
+days_tick_cb (GtkWidget     *widget,
+              GdkFrameClock *frame_clock,
+              gpointer       user_data)
+{
+  GcalAgendaView *self = GCAL_AGENDA_VIEW (user_data);
+
+  GCAL_ENTRY;
+
+  if (!self->days_valid)
+    rebuild_days (self);
+
+  GCAL_RETURN (G_SOURCE_REMOVE);
+}
+
+static void
+on_model_items_changed_cb (GListModel     *model,
+                           guint           position,
+                           guint           removed,
+                           guint           added,
+                           GcalAgendaView *self)
+{
+  invalidate_days (self);
+}
+
+static void
+on_vadjustment_value_changed_cb (GtkAdjustment  *vadjustment,
+                                 GcalAgendaView *self)
+{
+  maybe_load_more_days (self);
+}
+
+static void
+on_scrolled_window_edge_reached_cb (GtkScrolledWindow *scrolled_window,
+                                    GtkPositionType    position,
+                                    GcalAgendaView    *self)
+{
+  if (position == GTK_POS_BOTTOM)
+    load_more_days (self);
+}
+
 static void
 stack_visible_child_changed_cb (AdwViewStack   *stack,
                                 GParamSpec     *pspec,
@@ -110,6 +325,7 @@ update_grid_scroll_position (GcalAgendaView *self)
   gdouble minutes, real_value;
   gdouble max, page, page_increment, value;
   gboolean dummy;
+  guint n_days;
 
   /* While the scrolled window is not mapped, we keep waiting */
   if (!gtk_widget_get_realized (self->scrolled_window) ||
@@ -142,7 +358,10 @@ update_grid_scroll_position (GcalAgendaView *self)
   vadjustment = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (self->scrolled_window));
   minutes = g_date_time_get_hour (now) * 60 + g_date_time_get_minute (now);
   page = gtk_adjustment_get_page_size (vadjustment);
-  max = gtk_adjustment_get_upper (vadjustment);
+  n_days = g_list_model_get_n_items (G_LIST_MODEL (self->days_model));
+
+  /* Only the first page of days counts, even if more were loaded already */
+  max = gtk_adjustment_get_upper (vadjustment) * MIN (N_DAYS_PER_PAGE, n_days) / MAX (n_days, 1);
 
   real_value = max / MINUTES_PER_DAY * minutes - (page / 2.0);
   page_increment = gtk_adjustment_get_page_increment (vadjustment);
@@ -182,16 +401,11 @@ n_items_and_date_to_boolean (GcalAgendaViewDay *day,
                              gpointer           user_data)
 {
   GcalAgendaView *self = (GcalAgendaView *) user_data;
-  g_autoptr (GcalRange) view_range = NULL;
 
   g_assert (GCAL_IS_AGENDA_VIEW (self));
   g_assert (GCAL_IS_AGENDA_VIEW_DAY (day));
   g_assert (self->date != NULL);
 
-  view_range = gcal_timeline_subscriber_get_range (GCAL_TIMELINE_SUBSCRIBER (self));
-  if (!gcal_range_contains_datetime (view_range, date))
-    return FALSE;
-
   if (n_items > 0)
     return TRUE;
 
@@ -224,16 +438,8 @@ gcal_agenda_view_set_date (GcalView  *view,
 
   gcal_set_date_time (&self->date, date);
 
-  for (unsigned int i = 0; i < g_list_model_get_n_items (G_LIST_MODEL (self->days_model)); i++)
-    {
-      g_autoptr (GcalAgendaViewDay) day = NULL;
-      g_autoptr (GDateTime) next_date = NULL;
-
-      day = g_list_model_get_item (G_LIST_MODEL (self->days_model), i);
-      next_date = g_date_time_add_days (date, i);
-
-      gcal_agenda_view_day_set_date (day, next_date);
-    }
+  reset_days (self);
+  invalidate_days (self);
 
   schedule_position_scroll (self);
 
@@ -312,9 +518,19 @@ static GcalRange*
 gcal_agenda_view_get_range (GcalTimelineSubscriber *subscriber)
 {
   GcalAgendaView *self = GCAL_AGENDA_VIEW (subscriber);
-
-  return gcal_range_new_take (g_date_time_ref (self->date),
-                              gcal_date_time_get_end_of_week (self->date),
+  g_autoptr (GDateTime) start = NULL;
+  guint n_days;
+
+  /* The range grows as more days are loaded */
+  n_days = g_list_model_get_n_items (G_LIST_MODEL (self->days_model));
+  start = g_date_time_new (g_date_time_get_timezone (self->date),
+                           g_date_time_get_year (self->date),
+                           g_date_time_get_month (self->date),
+                           g_date_time_get_day_of_month (self->date),
+                           0, 0, 0);
+
+  return gcal_range_new_take (g_date_time_ref (start),
+                              g_date_time_add_days (start, n_days),
                               GCAL_RANGE_DEFAULT);
 }
 
@@ -328,12 +544,15 @@ gcal_agenda_view_set_model (GcalTimelineSubscriber *subscriber,
 
   self = GCAL_AGENDA_VIEW (subscriber);
 
-  for (unsigned int i = 0; i < g_list_model_get_n_items (G_LIST_MODEL (self->days_model)); i++)
-    {
-      g_autoptr (GcalAgendaViewDay) day = g_list_model_get_item (G_LIST_MODEL (self->days_model), i);
+  if (self->model)
+    g_signal_handlers_disconnect_by_func (self->model, on_model_items_changed_cb, self);
 
-      gcal_agenda_view_day_set_model (day, model);
-    }
+  g_set_object (&self->model, model);
+
+  if (self->model)
+    g_signal_connect (self->model, "items-changed", G_CALLBACK (on_model_items_changed_cb), self);
+
+  invalidate_days (self);
 
   GCAL_EXIT;
 }
@@ -346,6 +565,22 @@ gcal_timeline_subscriber_interface_init (GcalTimelineSubscriberInterface *iface)
 }
 
 
+/*
+ * GtkWidget overrides
+ */
+
+static void
+gcal_agenda_view_map (GtkWidget *widget)
+{
+  GcalAgendaView *self = GCAL_AGENDA_VIEW (widget);
+
+  if (!self->days_valid)
+    rebuild_days (self);
+
+  GTK_WIDGET_CLASS (gcal_agenda_view_parent_class)->map (widget);
+}
+
+
 /*
  * GObject overrides
  */
@@ -355,6 +590,10 @@ gcal_agenda_view_dispose (GObject *object)
 {
   GcalAgendaView *self = GCAL_AGENDA_VIEW (object);
 
+  if (self->model)
+    g_signal_handlers_disconnect_by_func (self->model, on_model_items_changed_cb, self);
+  g_clear_object (&self->model);
+
   gtk_widget_dispose_template (GTK_WIDGET (self), GCAL_TYPE_AGENDA_VIEW);
 
   G_OBJECT_CLASS (gcal_agenda_view_parent_class)->dispose (object);
@@ -366,6 +605,7 @@ gcal_agenda_view_finalize (GObject       *object)
   GcalAgendaView *self = GCAL_AGENDA_VIEW (object);
 
   g_clear_pointer (&self->date, g_date_time_unref);
+  g_clear_object (&self->days_model);
 
   /* Chain up to parent's finalize() method. */
   G_OBJECT_CLASS (gcal_agenda_view_parent_class)->finalize (object);
@@ -429,6 +669,8 @@ gcal_agenda_view_class_init (GcalAgendaViewClass *klass)
   object_class->set_property = gcal_agenda_view_set_property;
   object_class->get_property = gcal_agenda_view_get_property;
 
+  widget_class->map = gcal_agenda_view_map;
+
   g_object_class_override_property (object_class, PROP_DATE, "active-date");
   g_object_class_override_property (object_class, PROP_TIME_DIRECTION, "time-direction");
 
@@ -446,23 +688,19 @@ gcal_agenda_view_class_init (GcalAgendaViewClass *klass)
 static void
 gcal_agenda_view_init (GcalAgendaView *self)
 {
+  GtkAdjustment *vadjustment;
+
   gtk_widget_init_template (GTK_WIDGET (self));
 
   self->date = g_date_time_new_now_local ();
   self->days_model = g_list_store_new (GCAL_TYPE_AGENDA_VIEW_DAY);
+  self->days_valid = TRUE;
 
-  for (size_t i = 0; i < N_WEEKDAYS; i++)
-    {
-      g_autoptr (GcalAgendaViewDay) day = NULL;
-      g_autoptr (GDateTime) date = NULL;
-
-      date = g_date_time_add_days (self->date, i);
-
-      day = gcal_agenda_view_day_new ();
-      gcal_agenda_view_day_set_date (day, date);
-
-      g_list_store_append (self->days_model, day);
-    }
+  append_days (self, N_DAYS_PER_PAGE);
 
   gtk_filter_list_model_set_model (self->filtered_days, G_LIST_MODEL (self->days_model));
+
+  vadjustment = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (self->scrolled_window));
+  g_signal_connect_object (vadjustment, "value-changed", G_CALLBACK (on_vadjustment_value_changed_cb), self, 0);
+  g_signal_connect_object (self->scrolled_window, "edge-reached", G_CALLBACK (on_scrolled_window_edge_reached_cb), self, 0);
 }
@@ -84,13 +84,11 @@ get_parent_bin_height (GtkWidget *widget)
 static void
 update_style_flags (GcalMonthCell *self)
 {
-  g_autoptr (GDateTime) today = NULL;
+  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
   gint weekday;
 
   /* Today */
-  today = g_date_time_new_now_local ();
-
-  if (gcal_date_time_compare_date (self->date, today) == 0)
+  if (gcal_date_time_get_julian_day (self->date) == gcal_clock_get_today (gcal_context_get_clock (context)))
     gtk_widget_add_css_class (GTK_WIDGET (self), "today");
   else
     gtk_widget_remove_css_class (GTK_WIDGET (self), "today");
@@ -185,13 +183,6 @@ update_weather (GcalMonthCell *self)
  * Callbacks
  */
 
-static void
-day_changed_cb (GcalClock     *clock,
-                GcalMonthCell *self)
-{
-  update_style_flags (self);
-}
-
 static void
 overflow_button_clicked_cb (GtkWidget     *button,
                             GcalMonthCell *self)
@@ -199,13 +190,6 @@ overflow_button_clicked_cb (GtkWidget     *button,
   g_signal_emit (self, signals[SHOW_OVERFLOW], 0, button);
 }
 
-static void
-on_weather_service_weather_changed_cb (GcalWeatherService *weather_service,
-                                       GcalMonthCell      *self)
-{
-  update_weather (self);
-}
-
 static void
 on_breakpoint_changed_cb (GcalMonthCell *self)
 {
@@ -251,10 +235,6 @@ static void
 gcal_month_cell_dispose (GObject *object)
 {
   GcalMonthCell *self = (GcalMonthCell *)object;
-  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
-
-  GcalWeatherService *weather_service = gcal_context_get_weather_service (context);
-  gcal_weather_service_release (weather_service);
 
   gcal_clear_date_time (&self->date);
   g_clear_pointer (&self->breakpoint_bin, gtk_widget_unparent);
@@ -304,28 +284,11 @@ gcal_month_cell_class_init (GcalMonthCellClass *klass)
 static void
 gcal_month_cell_init (GcalMonthCell *self)
 {
-  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
-
   gtk_widget_init_template (GTK_WIDGET (self));
 
   g_signal_connect_swapped (self->breakpoint_bin,
                             "notify::current-breakpoint", G_CALLBACK (on_breakpoint_changed_cb), self);
 
-  g_signal_connect_object (gcal_context_get_clock (context),
-                           "day-changed",
-                           G_CALLBACK (day_changed_cb),
-                           self,
-                           0);
-
-  g_signal_connect_object (gcal_context_get_weather_service (context),
-                           "weather-changed",
-                           G_CALLBACK (on_weather_service_weather_changed_cb),
-                           self,
-                           0);
-
-  GcalWeatherService *weather_service = gcal_context_get_weather_service (context);
-  gcal_weather_service_hold (weather_service);
-
   gtk_widget_set_child_visible (self->overflow_button, FALSE);
 }
 
@@ -479,3 +442,34 @@ gcal_month_cell_get_overflow_button (GcalMonthCell *self)
   return self->overflow_button;
 }
 
+
+/**
+ * gcal_month_cell_update_weather:
+ * @self: a #GcalMonthCell
+ *
+ * Updates the weather forecast shown by @self. Cells don't track the
+ * weather service themselves; the month view refreshes all of them
+ * at once when the forecast changes.
+ */
+void
+gcal_month_cell_update_weather (GcalMonthCell *self)
+{
+  g_return_if_fail (GCAL_IS_MONTH_CELL (self));
+
+  update_weather (self);
+}
+
+/**
+ * gcal_month_cell_update_today:
+ * @self: a #GcalMonthCell
+ *
+ * Updates whether @self is highlighted as today. Like the weather,
+ * this is driven by the month view when the day changes.
+ */
+void
+gcal_month_cell_update_today (GcalMonthCell *self)
+{
+  g_return_if_fail (GCAL_IS_MONTH_CELL (self));
+
+  update_style_flags (self);
+}
@@ -54,6 +54,10 @@ void                 gcal_month_cell_set_selected                (GcalMonthCell
 
 GtkWidget           *gcal_month_cell_get_overflow_button         (GcalMonthCell      *self);
 
+void                 gcal_month_cell_update_weather              (GcalMonthCell      *self);
+
+void                 gcal_month_cell_update_today                (GcalMonthCell      *self);
+
 G_END_DECLS
 
 #endif /* GCAL_MONTH_VIEW_CELL_H */
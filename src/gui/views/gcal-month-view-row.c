@@ -51,6 +51,7 @@ struct _GcalMonthViewRow
   GtkWidget          *day_cells[N_WEEKDAYS];
 
   GcalRange          *range;
+  gint64              first_day;
   gboolean            ceiled_height;
 
   GListModel         *events;
@@ -487,53 +488,21 @@ calculate_event_cells (GcalMonthViewRow *self,
                        gint             *out_first_cell,
                        gint             *out_last_cell)
 {
-  g_autoptr (GDateTime) range_start = NULL;
-  g_autoptr (GDateTime) start_date = NULL;
-  gboolean all_day;
+  gint64 first_day;
+  gint64 last_day;
   gint first_cell;
 
   g_assert (out_first_cell != NULL || out_last_cell != NULL);
 
-  all_day = gcal_event_get_all_day (event);
-  range_start = gcal_range_get_start (self->range);
-  start_date = gcal_event_get_date_start (event);
-  start_date = all_day ? g_date_time_ref (start_date) : g_date_time_to_local (start_date);
-  first_cell = MAX (gcal_date_time_compare_date (start_date, range_start), 0);
+  gcal_event_get_local_days (event, &first_day, &last_day);
+
+  first_cell = MAX (first_day - self->first_day, 0);
 
-  /* Start date */
   if (out_first_cell)
     *out_first_cell = first_cell;
 
-  /*
-   * The logic for the end date is the same, except that we have to check
-   * if the event is all day or not.
-   */
   if (out_last_cell)
-    {
-      g_autoptr (GDateTime) range_start = NULL;
-      g_autoptr (GDateTime) end_date = NULL;
-      gint last_cell = N_WEEKDAYS - 1;
-
-      range_start = gcal_range_get_start (self->range);
-      end_date = gcal_event_get_date_end (event);
-
-      if (all_day)
-        {
-          end_date = g_date_time_ref (end_date);
-        }
-      else
-        {
-          g_autoptr (GDateTime) local_end_date = g_date_time_to_local (end_date);
-          end_date = g_date_time_add_seconds (local_end_date, -1);
-        }
-
-      last_cell = gcal_date_time_compare_date (end_date, range_start);
-
-      if (all_day)
-        last_cell--;
-
-      *out_last_cell = CLAMP (last_cell, first_cell, N_WEEKDAYS - 1);
-    }
+    *out_last_cell = CLAMP (last_day - self->first_day, first_cell, N_WEEKDAYS - 1);
 }
 
 static void
@@ -549,7 +518,7 @@ prepare_layout_blocks (GcalMonthViewRow *self,
 
   g_assert (self->layout_blocks_valid);
 
-  n_events = g_list_model_get_n_items (self->events);
+  n_events = self->events ? g_list_model_get_n_items (self->events) : 0;
 
   for (guint i = 0; i < N_WEEKDAYS; i++)
     {
@@ -574,9 +543,6 @@ prepare_layout_blocks (GcalMonthViewRow *self,
 
       event = g_list_model_get_item (self->events, i);
 
-      if (!gcal_event_overlaps (event, self->range))
-        continue;
-
       blocks = g_hash_table_lookup (self->layout_blocks, event);
       g_assert (blocks != NULL);
 
@@ -745,7 +711,7 @@ recalculate_layout_blocks (GcalMonthViewRow *self)
   g_assert (!self->layout_blocks_valid);
 
   range_start = gcal_range_get_start (self->range);
-  n_events = g_list_model_get_n_items (self->events);
+  n_events = self->events ? g_list_model_get_n_items (self->events) : 0;
 
   event_widgets = extract_current_event_widgets (self);
 
@@ -761,9 +727,6 @@ recalculate_layout_blocks (GcalMonthViewRow *self)
 
       event = g_list_model_get_item (self->events, i);
 
-      if (!gcal_event_overlaps (event, self->range))
-        continue;
-
       calculate_event_cells (self, event, &first_cell, &last_cell);
       g_assert (last_cell >= first_cell);
 
@@ -866,22 +829,6 @@ invalidate_layout_blocks (GcalMonthViewRow *self)
  * Callbacks
  */
 
-static gboolean
-filter_by_range_cb (gpointer item,
-                    gpointer user_data)
-{
-  GcalMonthViewRow *self = user_data;
-  GcalEvent *event = item;
-
-  g_assert (GCAL_IS_EVENT (event));
-  g_assert (GCAL_IS_MONTH_VIEW_ROW (self));
-
-  if (!self->range)
-    return FALSE;
-
-  return gcal_event_overlaps (event, self->range);
-}
-
 static void
 events_changed_cb (GListModel       *model,
                    guint             position,
@@ -1125,7 +1072,7 @@ gcal_month_view_row_size_allocate (GtkWidget *widget,
 
       prepare_layout_blocks (self, overflows);
 
-      n_events = g_list_model_get_n_items (self->events);
+      n_events = self->events ? g_list_model_get_n_items (self->events) : 0;
 
       for (guint i = 0; i < n_events; i++)
         {
@@ -1134,9 +1081,6 @@ gcal_month_view_row_size_allocate (GtkWidget *widget,
 
           event = g_list_model_get_item (self->events, i);
 
-          if (!gcal_event_overlaps (event, self->range))
-            continue;
-
           blocks = g_hash_table_lookup (self->layout_blocks, event);
           g_assert (blocks != NULL);
 
@@ -1188,6 +1132,9 @@ gcal_month_view_row_dispose (GObject *object)
     g_clear_pointer (&self->day_cells[i], gtk_widget_unparent);
 
   g_clear_pointer (&self->layout_blocks, g_hash_table_destroy);
+
+  if (self->events)
+    g_signal_handlers_disconnect_by_func (self->events, events_changed_cb, self);
   g_clear_object (&self->events);
 
   G_OBJECT_CLASS (gcal_month_view_row_parent_class)->dispose (object);
@@ -1314,9 +1261,6 @@ gcal_month_view_row_class_init (GcalMonthViewRowClass *klass)
 static void
 gcal_month_view_row_init (GcalMonthViewRow *self)
 {
-  self->events = G_LIST_MODEL (gtk_filter_list_model_new (NULL, GTK_FILTER (gtk_custom_filter_new (filter_by_range_cb, self, NULL))));
-  g_signal_connect (self->events, "items-changed", G_CALLBACK (events_changed_cb), self);
-
   self->layout_blocks = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_ptr_array_unref);
   self->layout_blocks_valid = TRUE;
 
@@ -1359,7 +1303,6 @@ gcal_month_view_row_set_range (GcalMonthViewRow *self,
                                GcalRange        *range)
 {
   g_autoptr (GDateTime) start = NULL;
-  GtkFilter *filter;
 
   g_return_if_fail (GCAL_IS_MONTH_VIEW_ROW (self));
   g_return_if_fail (range != NULL);
@@ -1373,28 +1316,46 @@ gcal_month_view_row_set_range (GcalMonthViewRow *self,
   self->range = gcal_range_ref (range);
 
   start = gcal_range_get_start (range);
+  self->first_day = gcal_date_time_get_julian_day (start);
+
   for (guint i = 0; i < N_WEEKDAYS; i++)
     {
       g_autoptr (GDateTime) day = g_date_time_add_days (start, i);
       gcal_month_cell_set_date (GCAL_MONTH_CELL (self->day_cells[i]), day);
     }
 
-  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (self->events));
-  g_assert (GTK_IS_CUSTOM_FILTER (filter));
-  gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
+  invalidate_layout_blocks (self);
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_RANGE]);
 
   GCAL_EXIT;
 }
 
+/**
+ * gcal_month_view_row_set_model:
+ * @self: a #GcalMonthViewRow
+ * @model: (nullable): a #GListModel
+ *
+ * Sets the events of @self. All events in @model must overlap
+ * the range of @self; the row does not filter them.
+ */
 void
 gcal_month_view_row_set_model (GcalMonthViewRow *self,
                                GListModel       *model)
 {
   g_return_if_fail (GCAL_IS_MONTH_VIEW_ROW (self));
 
-  gtk_filter_list_model_set_model (GTK_FILTER_LIST_MODEL (self->events), model);
+  if (self->events == model)
+    return;
+
+  if (self->events)
+    g_signal_handlers_disconnect_by_func (self->events, events_changed_cb, self);
+
+  g_set_object (&self->events, model);
+
+  if (self->events)
+    g_signal_connect (self->events, "items-changed", G_CALLBACK (events_changed_cb), self);
+
   invalidate_layout_blocks (self);
 }
 
@@ -1504,3 +1465,21 @@ gcal_month_view_row_set_ceiled_height (GcalMonthViewRow *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_CEILED_HEIGHT]);
 }
+
+void
+gcal_month_view_row_update_weather (GcalMonthViewRow *self)
+{
+  g_return_if_fail (GCAL_IS_MONTH_VIEW_ROW (self));
+
+  for (guint i = 0; i < N_WEEKDAYS; i++)
+    gcal_month_cell_update_weather (GCAL_MONTH_CELL (self->day_cells[i]));
+}
+
+void
+gcal_month_view_row_update_today (GcalMonthViewRow *self)
+{
+  g_return_if_fail (GCAL_IS_MONTH_VIEW_ROW (self));
+
+  for (guint i = 0; i < N_WEEKDAYS; i++)
+    gcal_month_cell_update_today (GCAL_MONTH_CELL (self->day_cells[i]));
+}
@@ -60,4 +60,9 @@ gboolean             gcal_month_view_row_get_ceiled_height      (GcalMonthViewRo
 
 void                 gcal_month_view_row_set_ceiled_height      (GcalMonthViewRow    *self,
                                                                  gboolean             ceiled_height);
+
+void                 gcal_month_view_row_update_weather         (GcalMonthViewRow    *self);
+
+void                 gcal_month_view_row_update_today           (GcalMonthViewRow    *self);
+
 G_END_DECLS
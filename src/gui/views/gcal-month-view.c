@@ -58,6 +58,15 @@ struct _GcalMonthView
 
   GPtrArray          *week_rows;
 
+  /*
+   * Events of each week, in the same order as week_rows. Buckets
+   * travel with their rows when rows are recycled.
+   */
+  GPtrArray          *week_buckets;
+  gboolean            week_buckets_valid;
+
+  GListModel         *events;
+
   GcalEventWidgetPool *event_widget_pool;
 
   struct {
@@ -94,6 +103,10 @@ static void          gtk_buildable_interface_init                (GtkBuildableIf
 
 static void          gcal_timeline_subscriber_interface_init     (GcalTimelineSubscriberInterface *iface);
 
+static gboolean      week_buckets_tick_cb                        (GtkWidget          *widget,
+                                                                  GdkFrameClock      *frame_clock,
+                                                                  gpointer            user_data);
+
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (GcalMonthView, gcal_month_view, GTK_TYPE_WIDGET,
                                G_IMPLEMENT_INTERFACE (GCAL_TYPE_TIMELINE_SUBSCRIBER, gcal_timeline_subscriber_interface_init)
@@ -240,6 +253,176 @@ update_active_date (GcalMonthView *self)
   g_object_notify (G_OBJECT (self), "active-date");
 }
 
+static void
+update_week_bucket (GListStore *bucket,
+                    GPtrArray  *events)
+{
+  guint n_items;
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (bucket));
+
+  /* Don't wake up rows whose week didn't change */
+  if (n_items == events->len)
+    {
+      gboolean changed = FALSE;
+
+      for (guint i = 0; i < n_items && !changed; i++)
+        {
+          g_autoptr (GcalEvent) event = g_list_model_get_item (G_LIST_MODEL (bucket), i);
+
+          changed = event != g_ptr_array_index (events, i);
+        }
+
+      if (!changed)
+        return;
+    }
+
+  g_list_store_splice (bucket, 0, n_items, events->pdata, events->len);
+}
+
+static void
+fill_week_bucket (GcalMonthView *self,
+                  GListStore    *bucket,
+                  GcalRange     *range)
+{
+  g_autoptr (GPtrArray) events = NULL;
+  guint n_events = 0;
+
+  GCAL_ENTRY;
+
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+
+  if (self->events)
+    n_events = g_list_model_get_n_items (self->events);
+
+  for (guint i = 0; i < n_events; i++)
+    {
+      g_autoptr (GcalEvent) event = g_list_model_get_item (self->events, i);
+
+      if (gcal_event_overlaps (event, range))
+        g_ptr_array_add (events, g_steal_pointer (&event));
+    }
+
+  update_week_bucket (bucket, events);
+
+  GCAL_EXIT;
+}
+
+/*
+ * Rows are contiguous and sorted, so the rows overlapping an event are
+ * contiguous too. Binary search one of them, then extend to the sides.
+ */
+static gboolean
+find_overlapping_rows (GcalRange  *event_range,
+                       GcalRange **row_ranges,
+                       guint       n_rows,
+                       guint      *out_first_row,
+                       guint      *out_last_row)
+{
+  guint first_row;
+  guint last_row;
+  guint low = 0;
+  guint high = n_rows;
+
+  while (low < high)
+    {
+      GcalRangePosition position;
+      guint middle = low + (high - low) / 2;
+
+      if (gcal_range_calculate_overlap (event_range, row_ranges[middle], &position) != GCAL_RANGE_NO_OVERLAP)
+        {
+          first_row = middle;
+          last_row = middle;
+
+          while (first_row > 0 &&
+                 gcal_range_calculate_overlap (event_range, row_ranges[first_row - 1], NULL) != GCAL_RANGE_NO_OVERLAP)
+            first_row--;
+
+          while (last_row + 1 < n_rows &&
+                 gcal_range_calculate_overlap (event_range, row_ranges[last_row + 1], NULL) != GCAL_RANGE_NO_OVERLAP)
+            last_row++;
+
+          *out_first_row = first_row;
+          *out_last_row = last_row;
+          return TRUE;
+        }
+
+      if (position == GCAL_RANGE_BEFORE)
+        high = middle;
+      else
+        low = middle + 1;
+    }
+
+  return FALSE;
+}
+
+static void
+rebuild_week_buckets (GcalMonthView *self)
+{
+  g_autoptr (GPtrArray) events = NULL;
+  GcalRange *row_ranges[N_TOTAL_ROWS];
+  GPtrArray *row_events[N_TOTAL_ROWS];
+  guint n_events = 0;
+
+  GCAL_ENTRY;
+
+  g_assert (self->week_rows->len == N_TOTAL_ROWS);
+  g_assert (self->week_buckets->len == N_TOTAL_ROWS);
+
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (guint i = 0; i < N_TOTAL_ROWS; i++)
+    {
+      row_ranges[i] = gcal_month_view_row_get_range (g_ptr_array_index (self->week_rows, i));
+      row_events[i] = g_ptr_array_new ();
+
+      g_assert (row_ranges[i] != NULL);
+    }
+
+  if (self->events)
+    n_events = g_list_model_get_n_items (self->events);
+
+  for (guint i = 0; i < n_events; i++)
+    {
+      GcalEvent *event;
+      guint first_row;
+      guint last_row;
+
+      event = g_list_model_get_item (self->events, i);
+      g_ptr_array_add (events, event);
+
+      if (!find_overlapping_rows (gcal_event_get_range (event), row_ranges, N_TOTAL_ROWS, &first_row, &last_row))
+        continue;
+
+      for (guint row = first_row; row <= last_row; row++)
+        g_ptr_array_add (row_events[row], event);
+    }
+
+  for (guint i = 0; i < N_TOTAL_ROWS; i++)
+    {
+      update_week_bucket (g_ptr_array_index (self->week_buckets, i), row_events[i]);
+
+      g_clear_pointer (&row_events[i], g_ptr_array_unref);
+      g_clear_pointer (&row_ranges[i], gcal_range_unref);
+    }
+
+  self->week_buckets_valid = TRUE;
+
+  GCAL_EXIT;
+}
+
+static void
+invalidate_week_buckets (GcalMonthView *self)
+{
+  if (!self->week_buckets_valid)
+    return;
+
+  if (gtk_widget_get_mapped (GTK_WIDGET (self)))
+    gtk_widget_add_tick_callback (GTK_WIDGET (self), week_buckets_tick_cb, self, NULL);
+
+  self->week_buckets_valid = FALSE;
+}
+
 static inline void
 maybe_popdown_overflow_popover (GcalMonthView *self)
 {
@@ -262,6 +445,7 @@ move_bottom_row_to_top (GcalMonthView *self)
   g_autoptr (GcalRange) first_row_range = NULL;
   g_autoptr (GcalRange) new_range = NULL;
   GDateTime *first_row_range_start;
+  GListStore *last_bucket;
   GtkWidget *first_row;
   GtkWidget *last_row;
 
@@ -286,6 +470,10 @@ move_bottom_row_to_top (GcalMonthView *self)
   last_row = g_ptr_array_steal_index (self->week_rows, self->week_rows->len - 1);
   gcal_month_view_row_set_range (GCAL_MONTH_VIEW_ROW (last_row), new_range);
   g_ptr_array_insert (self->week_rows, 0, last_row);
+
+  last_bucket = g_ptr_array_steal_index (self->week_buckets, self->week_buckets->len - 1);
+  fill_week_bucket (self, last_bucket, new_range);
+  g_ptr_array_insert (self->week_buckets, 0, last_bucket);
 }
 
 static void
@@ -294,6 +482,7 @@ move_top_row_to_bottom (GcalMonthView *self)
   g_autoptr (GcalRange) last_row_range = NULL;
   g_autoptr (GcalRange) new_range = NULL;
   GDateTime *last_row_range_end;
+  GListStore *first_bucket;
   GtkWidget *first_row;
   GtkWidget *last_row;
 
@@ -318,6 +507,10 @@ move_top_row_to_bottom (GcalMonthView *self)
   first_row = g_ptr_array_steal_index (self->week_rows, 0);
   gcal_month_view_row_set_range (GCAL_MONTH_VIEW_ROW (first_row), new_range);
   g_ptr_array_insert (self->week_rows, -1, first_row);
+
+  first_bucket = g_ptr_array_steal_index (self->week_buckets, 0);
+  fill_week_bucket (self, first_bucket, new_range);
+  g_ptr_array_insert (self->week_buckets, -1, first_bucket);
 }
 
 static inline void
@@ -400,6 +593,9 @@ update_week_ranges (GcalMonthView *self,
           row = g_ptr_array_index (self->week_rows, i);
           gcal_month_view_row_set_range (row, range);
         }
+
+      /* Rows must never hold events outside of their range */
+      rebuild_week_buckets (self);
     }
 
   maybe_popdown_overflow_popover (self);
@@ -859,6 +1055,33 @@ move_event_to_date (GcalMonthView         *self,
  * Callbacks
  */
 
+static void
+on_events_items_changed_cb (GListModel    *model,
+                            guint          position,
+                            guint          removed,
+                            guint          added,
+                            GcalMonthView *self)
+{
+  invalidate_week_buckets (self);
+}
+
+static gboolean
+week_buckets_tick_cb (GtkWidget     *widget,
+                      GdkFrameClock *frame_clock,
+                      gpointer       user_data)
+{
+  GcalMonthView *self = (GcalMonthView *) widget;
+
+  GCAL_ENTRY;
+
+  g_assert (GCAL_IS_MONTH_VIEW (self));
+
+  if (!self->week_buckets_valid)
+    rebuild_week_buckets (self);
+
+  GCAL_RETURN (G_SOURCE_REMOVE);
+}
+
 static void
 on_click_gesture_pressed_cb (GtkGestureClick *click_gesture,
                              gint             n_press,
@@ -1450,6 +1673,23 @@ on_month_popover_closed_cb (GcalMonthPopover *month_popover,
     }
 }
 
+static void
+on_weather_service_weather_changed_cb (GcalWeatherService *weather_service,
+                                       GcalMonthView      *self)
+{
+  /* Refresh all cells in a single pass, rather than per cell */
+  for (guint i = 0; i < self->week_rows->len; i++)
+    gcal_month_view_row_update_weather (g_ptr_array_index (self->week_rows, i));
+}
+
+static void
+on_clock_day_changed_cb (GcalClock     *clock,
+                         GcalMonthView *self)
+{
+  for (guint i = 0; i < self->week_rows->len; i++)
+    gcal_month_view_row_update_today (g_ptr_array_index (self->week_rows, i));
+}
+
 
 /*
  * GcalTimelineSubscriber iface
@@ -1481,12 +1721,15 @@ gcal_month_view_set_model (GcalTimelineSubscriber *subscriber,
 
   self = GCAL_MONTH_VIEW (subscriber);
 
-  for (guint i = 0; i < self->week_rows->len; i++)
-    {
-      GcalMonthViewRow *row = g_ptr_array_index (self->week_rows, i);
+  if (self->events)
+    g_signal_handlers_disconnect_by_func (self->events, on_events_items_changed_cb, self);
 
-      gcal_month_view_row_set_model (row, model);
-    }
+  g_set_object (&self->events, model);
+
+  if (self->events)
+    g_signal_connect (self->events, "items-changed", G_CALLBACK (on_events_items_changed_cb), self);
+
+  invalidate_week_buckets (self);
 
   gcal_month_popover_set_model (GCAL_MONTH_POPOVER (self->overflow.popover), model);
 
@@ -1669,6 +1912,19 @@ gtk_buildable_interface_init (GtkBuildableIface *iface)
  * GtkWidget overrides
  */
 
+static void
+gcal_month_view_map (GtkWidget *widget)
+{
+  GcalMonthView *self = (GcalMonthView *) widget;
+
+  g_assert (GCAL_IS_MONTH_VIEW (self));
+
+  if (!self->week_buckets_valid)
+    rebuild_week_buckets (self);
+
+  GTK_WIDGET_CLASS (gcal_month_view_parent_class)->map (widget);
+}
+
 static gboolean
 gcal_month_view_focus (GtkWidget        *widget,
                        GtkDirectionType  direction)
@@ -1941,12 +2197,24 @@ gcal_month_view_dispose (GObject *object)
 
   GCAL_ENTRY;
 
+  if (self->week_rows)
+    {
+      GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+
+      gcal_weather_service_release (gcal_context_get_weather_service (context));
+    }
+
   g_clear_object (&self->kinetic_scroll_animation);
   g_clear_object (&self->row_offset_animation);
 
   g_clear_pointer (&self->overflow.popover, gtk_widget_unparent);
   g_clear_pointer (&self->header, gtk_widget_unparent);
   g_clear_pointer (&self->week_rows, g_ptr_array_unref);
+  g_clear_pointer (&self->week_buckets, g_ptr_array_unref);
+
+  if (self->events)
+    g_signal_handlers_disconnect_by_func (self->events, on_events_items_changed_cb, self);
+  g_clear_object (&self->events);
 
   g_clear_weak_pointer (&self->last_focused_widget);
   g_clear_pointer (&self->dnd_widget, gtk_widget_unparent);
@@ -2022,6 +2290,7 @@ gcal_month_view_class_init (GcalMonthViewClass *klass)
   object_class->get_property = gcal_month_view_get_property;
   object_class->set_property = gcal_month_view_set_property;
 
+  widget_class->map = gcal_month_view_map;
   widget_class->focus = gcal_month_view_focus;
   widget_class->measure = gcal_month_view_measure;
   widget_class->size_allocate = gcal_month_view_size_allocate;
@@ -2059,6 +2328,7 @@ gcal_month_view_class_init (GcalMonthViewClass *klass)
 static void
 gcal_month_view_init (GcalMonthView *self)
 {
+  GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
   GtkDropTarget *drop_target;
   g_autoptr (GDateTime) now = NULL;
 
@@ -2072,10 +2342,17 @@ gcal_month_view_init (GcalMonthView *self)
                                   GTK_ACCESSIBLE_RELATION_ROW_COUNT, N_ROWS_PER_PAGE,
                                   -1);
 
+  self->week_buckets_valid = TRUE;
+  self->week_buckets = g_ptr_array_new_full (N_TOTAL_ROWS, g_object_unref);
   self->week_rows = g_ptr_array_new_full (N_TOTAL_ROWS, (GDestroyNotify) gtk_widget_unparent);
   for (gint i = 0; i < N_TOTAL_ROWS; i++)
     {
       GtkWidget *row = gcal_month_view_row_new (self->event_widget_pool);
+      GListStore *bucket = g_list_store_new (GCAL_TYPE_EVENT);
+
+      gcal_month_view_row_set_model (GCAL_MONTH_VIEW_ROW (row), G_LIST_MODEL (bucket));
+      g_ptr_array_add (self->week_buckets, bucket);
+
       g_signal_connect (row, "event-activated", G_CALLBACK (on_event_widget_activated_cb), self);
       g_signal_connect (row, "cell-activated", G_CALLBACK (on_month_row_cell_activated_cb), self);
       g_signal_connect (row, "show-overflow", G_CALLBACK (on_month_row_show_overflow_cb), self);
@@ -2085,6 +2362,19 @@ gcal_month_view_init (GcalMonthView *self)
 
   gtk_widget_insert_before (self->header, GTK_WIDGET (self), NULL);
 
+  g_signal_connect_object (gcal_context_get_weather_service (context),
+                           "weather-changed",
+                           G_CALLBACK (on_weather_service_weather_changed_cb),
+                           self,
+                           0);
+  gcal_weather_service_hold (gcal_context_get_weather_service (context));
+
+  g_signal_connect_object (gcal_context_get_clock (context),
+                           "day-changed",
+                           G_CALLBACK (on_clock_day_changed_cb),
+                           self,
+                           0);
+
   /* Overflow popover */
   self->overflow.popover = gcal_month_popover_new ();
   g_signal_connect (self->overflow.popover, "event-activated", G_CALLBACK (on_month_popover_event_activated_cb), self);
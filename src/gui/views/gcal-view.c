@@ -292,5 +292,9 @@ gcal_view_event_activated (GcalView        *self,
   g_assert (GCAL_IS_VIEW (self));
   g_assert (GCAL_IS_EVENT_WIDGET (event_widget));
 
+  /* Placeholders can't be previewed, edited or removed */
+  if (gcal_event_is_placeholder (gcal_event_widget_get_event (event_widget)))
+    return;
+
   g_signal_emit (self, signals[EVENT_ACTIVATED], 0, event_widget);
 }
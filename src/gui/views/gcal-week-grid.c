@@ -190,14 +190,19 @@ layout_block_add_event (LayoutBlock *layout_block,
 
       if (!gcal_range_tree_has_entries_at_range (column_data, event_range))
         {
-          g_autoptr (GcalRange) new_block_range = NULL;
-
           child_data = child_data_new (NULL, event);
           gcal_range_tree_add_range (column_data, event_range, child_data);
 
-          new_block_range = gcal_range_union (layout_block->range, event_range);
-          g_clear_pointer (&layout_block->range, gcal_range_unref);
-          layout_block->range = g_steal_pointer (&new_block_range);
+          /* Only allocate a new block range when the event extends it */
+          if (!gcal_range_value_contains (gcal_range_get_value (layout_block->range),
+                                          gcal_range_get_value (event_range)))
+            {
+              g_autoptr (GcalRange) new_block_range = NULL;
+
+              new_block_range = gcal_range_union (layout_block->range, event_range);
+              g_clear_pointer (&layout_block->range, gcal_range_unref);
+              layout_block->range = g_steal_pointer (&new_block_range);
+            }
 
           break;
         }
@@ -476,28 +481,24 @@ compare_events_cb (gconstpointer a,
                    gconstpointer b,
                    gpointer      user_data)
 {
-  GDateTime *event_a_start;
-  GDateTime *event_b_start;
-  GDateTime *event_a_end;
-  GDateTime *event_b_end;
   GcalEvent *event_a;
   GcalEvent *event_b;
-  int result;
+  gint64 a_time;
+  gint64 b_time;
 
   event_a = (GcalEvent *) a;
   event_b = (GcalEvent *) b;
 
-  event_a_start = gcal_event_get_date_start (event_a);
-  event_b_start = gcal_event_get_date_start (event_b);
-  result = g_date_time_compare (event_a_start, event_b_start);
-  if (result != 0)
-    return result;
+  a_time = gcal_event_get_start_unix (event_a);
+  b_time = gcal_event_get_start_unix (event_b);
+  if (a_time != b_time)
+    return a_time < b_time ? -1 : 1;
 
-  event_a_end = gcal_event_get_date_end (event_a);
-  event_b_end = gcal_event_get_date_end (event_b);
-  result = g_date_time_compare (event_a_end, event_b_end);
-  if (result != 0)
-    return -result;
+  /* Longer events first */
+  a_time = gcal_event_get_end_unix (event_a);
+  b_time = gcal_event_get_end_unix (event_b);
+  if (a_time != b_time)
+    return a_time < b_time ? 1 : -1;
 
   return 0;
 }
@@ -880,15 +881,15 @@ static inline gint
 get_today_column (GcalWeekGrid *self)
 {
   g_autoptr(GDateTime) week_start = NULL;
-  g_autoptr(GDateTime) today = NULL;
-  gint days_diff;
+  GcalContext *context;
+  gint64 days_diff;
 
-  today = g_date_time_new_now_local ();
+  context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
   week_start = gcal_date_time_get_start_of_week (self->active_date);
-  days_diff = g_date_time_difference (today, week_start) / G_TIME_SPAN_DAY;
+  days_diff = gcal_clock_get_today (gcal_context_get_clock (context)) - gcal_date_time_get_julian_day (week_start);
 
   /* Today is out of range */
-  if (g_date_time_compare (today, week_start) < 0 || days_diff > N_WEEKDAYS)
+  if (days_diff < 0 || days_diff >= N_WEEKDAYS)
     return -1;
 
   return days_diff;
@@ -1136,14 +1137,13 @@ gcal_week_grid_size_allocate (GtkWidget *widget,
 
   if (today_column != -1)
     {
-      g_autoptr (GDateTime) now = NULL;
+      GcalContext *context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
       GtkAllocation allocation;
       guint minutes_from_midnight;
       gint now_strip_height;
       gint x;
 
-      now = g_date_time_new_now_local ();
-      minutes_from_midnight = g_date_time_get_hour (now) * 60 + g_date_time_get_minute (now);
+      minutes_from_midnight = gcal_clock_get_minute_of_day (gcal_context_get_clock (context));
 
       gtk_widget_measure (self->now_strip,
                           GTK_ORIENTATION_VERTICAL,
@@ -36,7 +36,6 @@
 
 #include <glib/gi18n.h>
 #include <string.h>
-#include <math.h>
 
 #define GDK_ARRAY_TYPE_NAME GcalEventArray
 #define GDK_ARRAY_NAME gcal_event_array
@@ -76,6 +75,31 @@ typedef struct
   gint                drop_cell;
 } DropData;
 
+/* Segment:
+ * @event: the event
+ * @widget: (nullable): the widget showing this segment
+ * @first: first day of @event, relative to the week start
+ * @last: last day of @event, relative to the week start
+ * @column: first column of the segment
+ * @span: number of columns of the segment
+ * @row: grid row of the segment
+ * @visible: whether the segment is visible
+ *
+ * A contiguous run of columns where an event sits at the same
+ * position, and is shown by a single widget.
+ */
+typedef struct
+{
+  GcalEvent          *event;
+  GtkWidget          *widget;
+  gint                first;
+  gint                last;
+  gint                column;
+  gint                span;
+  gint                row;
+  gboolean            visible;
+} Segment;
+
 struct _GcalWeekHeader
 {
   GtkWidget           parent;
@@ -98,6 +122,10 @@ struct _GcalWeekHeader
    */
   GPtrArray          *events[N_WEEKDAYS];
   GtkWidget          *overflow_label[N_WEEKDAYS];
+
+  /* Julian day of the first weekday, and the dates where each column starts */
+  gint64              week_start_day;
+  GDateTime          *column_dates[N_WEEKDAYS + 1];
   WeekdayHeader       weekday_header[N_WEEKDAYS];
 
   gint                first_weekday;
@@ -126,12 +154,6 @@ struct _GcalWeekHeader
   WeatherInfoDay      weather_infos[N_WEEKDAYS];
 };
 
-typedef enum
-{
-  UP,
-  DOWN
-} MoveDirection;
-
 enum
 {
   PROP_0,
@@ -388,15 +410,15 @@ static inline gint
 get_today_column (GcalWeekHeader *self)
 {
   g_autoptr (GDateTime) week_start = NULL;
-  g_autoptr (GDateTime) today = NULL;
-  gint days_diff;
+  GcalContext *context;
+  gint64 days_diff;
 
-  today = g_date_time_new_now_local ();
+  context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
   week_start = gcal_date_time_get_start_of_week (self->active_date);
-  days_diff = g_date_time_difference (today, week_start) / G_TIME_SPAN_DAY;
+  days_diff = gcal_clock_get_today (gcal_context_get_clock (context)) - gcal_date_time_get_julian_day (week_start);
 
   /* Today is out of range */
-  if (g_date_time_compare (today, week_start) < 0 || days_diff > N_WEEKDAYS)
+  if (days_diff < 0 || days_diff >= N_WEEKDAYS)
     return -1;
 
   return days_diff;
@@ -414,22 +436,6 @@ compare_events_by_length (GcalEvent **event1,
   return gcal_event_compare (*event1, *event2);
 }
 
-static gint
-add_event_to_weekday (GcalWeekHeader *self,
-                      GcalEvent      *event,
-                      gint            weekday)
-{
-  guint position = 0;
-
-  g_ptr_array_add (self->events[weekday], g_object_ref (event));
-  g_ptr_array_sort (self->events[weekday], (GCompareFunc) compare_events_by_length);
-
-  if (!g_ptr_array_find (self->events[weekday], event, &position))
-    g_assert_not_reached ();
-
-  return position;
-}
-
 static gboolean
 is_event_visible (GcalWeekHeader *self,
                   gint            weekday,
@@ -505,606 +511,389 @@ update_overflow (GcalWeekHeader *self)
 }
 
 static void
-merge_events (GcalWeekHeader *self,
-              GtkWidget      *event,
-              GtkWidget      *to_be_removed)
+update_week_days (GcalWeekHeader *self)
 {
-  GtkLayoutManager *layout_manager;
-  GtkLayoutChild *layout_child;
-  GDateTime *end_date;
-  gint deleted_width, current_width;
-
-  /* Setup the new end date of the merged event */
-  end_date = gcal_event_widget_get_date_end (GCAL_EVENT_WIDGET (to_be_removed));
-  gcal_event_widget_set_date_end (GCAL_EVENT_WIDGET (event), end_date);
-
-  /* Retrieve the current sizes */
-  layout_manager = gtk_widget_get_layout_manager (GTK_WIDGET (self->grid));
-  layout_child = gtk_layout_manager_get_layout_child (layout_manager, to_be_removed);
-  deleted_width = gtk_grid_layout_child_get_column_span (GTK_GRID_LAYOUT_CHILD (layout_child));
-
-  layout_child = gtk_layout_manager_get_layout_child (layout_manager, event);
-  current_width = gtk_grid_layout_child_get_column_span (GTK_GRID_LAYOUT_CHILD (layout_child));
+  g_autoptr (GDateTime) week_start = NULL;
+  gint i;
 
-  destroy_event_widget (self, to_be_removed);
+  week_start = gcal_date_time_get_start_of_week (self->active_date);
+  self->week_start_day = gcal_date_time_get_julian_day (week_start);
 
-  /* Update the event's size */
-  gtk_grid_layout_child_set_column_span (GTK_GRID_LAYOUT_CHILD (layout_child),
-                                         current_width + deleted_width);
+  for (i = 0; i <= N_WEEKDAYS; i++)
+    {
+      gcal_clear_date_time (&self->column_dates[i]);
+      self->column_dates[i] = g_date_time_add_days (week_start, i);
+    }
 }
 
 static void
-check_mergeable_events (GcalWeekHeader *self)
+distribute_events_in_weekdays (GcalWeekHeader *self)
 {
-  GList *checked_events[N_WEEKDAYS] = { NULL, };
-  gint weekday;
-
-  /* We don't need to check the last column */
-  for (weekday = 0; weekday < N_WEEKDAYS - 1; weekday++)
-    {
-      gint index = 0;
-
-      for (gsize i = 0; i < self->events[weekday]->len; i++)
-        {
-          GcalEvent *current_event;
-          gint events_to_merge;
-
-          current_event = g_ptr_array_index (self->events[weekday], i);
-          events_to_merge = 0;
-
-          if (g_list_find (checked_events[weekday], current_event))
-            {
-              index++;
-              continue;
-            }
-          else
-            {
-              checked_events[weekday] = g_list_prepend (checked_events[weekday], current_event);
-            }
-
-          /*
-           * Horizontally check if the next cells have the same event
-           * than the current cell.
-           */
-          for (gsize j = 1; j < N_WEEKDAYS - weekday; j++)
-            {
-              GcalEvent *next_event;
-
-              if (index >= self->events[weekday + j]->len)
-                break;
-
-              next_event = g_ptr_array_index (self->events[weekday + j], index);
-              if (next_event != current_event)
-                break;
+  g_autoptr (GPtrArray) sorted_events = NULL;
+  guint n_events;
+  guint i;
 
-              events_to_merge++;
+  for (i = 0; i < N_WEEKDAYS; i++)
+    g_ptr_array_set_size (self->events[i], 0);
 
-              /* Add to the list of checked days so we don't check it more times than necessary */
-              checked_events[weekday + j] = g_list_prepend (checked_events[weekday + j], current_event);
-            }
+  n_events = gcal_event_array_get_size (&self->event_array);
+  sorted_events = g_ptr_array_sized_new (n_events);
 
-          /* We found events to merge. Lets merge them */
+  for (i = 0; i < n_events; i++)
+    g_ptr_array_add (sorted_events, gcal_event_array_get (&self->event_array, i));
 
-          for (gsize j = 0; j < events_to_merge; j++)
-            {
-              GtkWidget *current_widget, *to_be_removed;
-
-              current_widget = gtk_grid_get_child_at (self->grid, weekday + j, index + 1);
-              to_be_removed = gtk_grid_get_child_at (self->grid, weekday + j + 1, index + 1);
-
-              /*
-               * We don't want to merge:
-               *  - Overflow labels
-               *  - The same widget
-               *  - Widgets with different visibilities (i.e. broken by overflow
-               */
-              if (!GCAL_IS_EVENT_WIDGET (current_widget) ||
-                  !GCAL_IS_EVENT_WIDGET (to_be_removed) ||
-                  current_widget == to_be_removed ||
-                  gtk_widget_get_visible (current_widget) != gtk_widget_get_visible (to_be_removed))
-                {
-                  continue;
-                }
+  /* Sorting once means every weekday receives its events already sorted */
+  g_ptr_array_sort (sorted_events, (GCompareFunc) compare_events_by_length);
 
-              merge_events (self, current_widget, to_be_removed);
+  for (i = 0; i < sorted_events->len; i++)
+    {
+      GcalEvent *event = g_ptr_array_index (sorted_events, i);
+      gint64 first, last;
+      gint64 day;
 
-              gtk_widget_set_visible (current_widget, is_event_visible (self, weekday + j, index));
-            }
+      gcal_event_get_local_days (event, &first, &last);
+      first -= self->week_start_day;
+      last -= self->week_start_day;
 
-          index++;
-        }
-
-      /* We can get rid of the checked list here */
-      g_list_free (checked_events[weekday]);
+      for (day = MAX (first, 0); day <= MIN (last, N_WEEKDAYS - 1); day++)
+        g_ptr_array_add (self->events[day], event);
     }
 }
 
-static void
-split_event_widget_at_column (GcalWeekHeader *self,
-                              GtkWidget      *widget,
-                              gint            column)
+/*
+ * Removes @event from the weekdays it is in, and returns the mask of
+ * these weekdays. The dates of @event are not used, since they may not
+ * match the weekdays it was added to anymore.
+ */
+static guint
+remove_event_from_weekdays (GcalWeekHeader *self,
+                            GcalEvent      *event)
 {
-  GtkLayoutManager *layout_manager;
-  GtkLayoutChild *layout_child;
-  GDateTime *week_start, *column_date, *end_column_date;
-  GcalEvent *event;
-  gboolean create_before;
-  gboolean create_after;
-  gint left_attach;
-  gint top_attach;
-  gint new_width;
-  gint old_width;
-
-  week_start = gcal_date_time_get_start_of_week (self->active_date);
-  column_date = g_date_time_add_days (week_start, column);
-  end_column_date = g_date_time_add_days (column_date, 1);
+  guint columns = 0;
+  gint day;
 
-  layout_manager = gtk_widget_get_layout_manager (GTK_WIDGET (self->grid));
-  layout_child = gtk_layout_manager_get_layout_child (layout_manager, widget);
-  top_attach = gtk_grid_layout_child_get_row (GTK_GRID_LAYOUT_CHILD (layout_child));
-  left_attach = gtk_grid_layout_child_get_column (GTK_GRID_LAYOUT_CHILD (layout_child));
-  old_width = gtk_grid_layout_child_get_column_span (GTK_GRID_LAYOUT_CHILD (layout_child));
-
-  create_before = column > 0 && left_attach < column;
-  create_after = column < N_WEEKDAYS - 1 && old_width > 1 && left_attach + old_width > column + 1;
-
-  event = gcal_event_widget_get_event (GCAL_EVENT_WIDGET (widget));
-
-  if (create_before)
+  for (day = 0; day < N_WEEKDAYS; day++)
     {
-      GtkWidget *widget_before;
-
-      widget_before = gcal_event_widget_pool_take_or_create (self->event_widget_pool, event);
-      g_assert (GCAL_IS_EVENT_WIDGET (widget_before));
-
-      gcal_event_widget_set_date_end (GCAL_EVENT_WIDGET (widget_before), column_date);
-
-      setup_event_widget (self, widget_before);
-
-      gtk_grid_attach (self->grid,
-                       widget_before,
-                       left_attach,
-                       top_attach,
-                       column - left_attach,
-                       1);
-
-      gtk_widget_set_visible (widget_before, is_event_visible (self, left_attach, top_attach - 1));
-
-      new_width = old_width - column + left_attach;
-      old_width = new_width;
-      left_attach = column;
-
-      /* Update the current event position, size and start date */
-      gtk_grid_layout_child_set_column (GTK_GRID_LAYOUT_CHILD (layout_child), left_attach);
-      gtk_grid_layout_child_set_column_span (GTK_GRID_LAYOUT_CHILD (layout_child), new_width);
-
-      gcal_event_widget_set_date_start (GCAL_EVENT_WIDGET (widget), column_date);
-      gtk_widget_set_visible (widget, is_event_visible (self, left_attach, top_attach - 1));
+      if (g_ptr_array_remove (self->events[day], event))
+        columns |= 1 << day;
     }
 
-  /* Create a new widget after the current widget */
-  if (create_after)
-    {
-      g_autoptr (GDateTime) event_end = NULL;
-      GtkWidget *widget_after;
+  return columns;
+}
 
-      event_end = g_date_time_to_local (gcal_event_widget_get_date_end (GCAL_EVENT_WIDGET (widget)));
+/*
+ * Inserts @event in the weekdays it spans, keeping them sorted, and
+ * returns the mask of these weekdays.
+ */
+static guint
+add_event_to_weekdays (GcalWeekHeader *self,
+                       GcalEvent      *event)
+{
+  guint columns = 0;
+  gint64 first, last;
+  gint64 day;
 
-      widget_after = gcal_event_widget_pool_take_or_create (self->event_widget_pool, event);
-      g_assert (GCAL_IS_EVENT_WIDGET (widget_after));
+  gcal_event_get_local_days (event, &first, &last);
+  first -= self->week_start_day;
+  last -= self->week_start_day;
 
-      gcal_event_widget_set_date_start (GCAL_EVENT_WIDGET (widget_after), end_column_date);
-      gcal_event_widget_set_date_end (GCAL_EVENT_WIDGET (widget_after), event_end);
+  for (day = MAX (first, 0); day <= MIN (last, N_WEEKDAYS - 1); day++)
+    {
+      GPtrArray *events = self->events[day];
+      guint start = 0;
+      guint end = events->len;
 
-      setup_event_widget (self, widget_after);
+      while (start < end)
+        {
+          guint middle = start + (end - start) / 2;
 
-      gtk_grid_attach (self->grid,
-                       widget_after,
-                       column + 1,
-                       top_attach,
-                       old_width - 1,
-                       1);
+          if (compare_events_by_length ((GcalEvent **) &events->pdata[middle], &event) <= 0)
+            start = middle + 1;
+          else
+            end = middle;
+        }
 
-      new_width = column - left_attach + 1;
+      g_ptr_array_insert (events, start, event);
+      columns |= 1 << day;
+    }
 
-      /* Only update the current widget's width */
-      gtk_grid_layout_child_set_column_span (GTK_GRID_LAYOUT_CHILD (layout_child), new_width);
+  return columns;
+}
 
-      gtk_widget_set_visible (widget_after, is_event_visible (self, column + 1, top_attach - 1));
-    }
+/*
+ * Retrieves the mask of the columns whose events can change the layout
+ * of a segment starting at @column and spanning @span columns: its own
+ * columns, and the columns right before and after it, since a segment
+ * is extended, or not, depending on the neighbouring columns.
+ */
+static inline guint
+get_segment_columns (gint column,
+                     gint span)
+{
+  gint first = MAX (column - 1, 0);
+  gint last = MIN (column + span, N_WEEKDAYS - 1);
 
-  g_clear_pointer (&end_column_date, g_date_time_unref);
-  g_clear_pointer (&column_date, g_date_time_unref);
-  g_clear_pointer (&week_start, g_date_time_unref);
+  return ((1 << (last + 1)) - 1) & ~((1 << first) - 1);
 }
 
-static void
-move_events_at_column (GcalWeekHeader *self,
-                       MoveDirection   direction,
-                       gint            column,
-                       gint            start_at)
+static GArray*
+calculate_segments (GcalWeekHeader *self)
 {
-  GtkLayoutManager *layout_manager;
-  GtkWidget *child;
+  g_autoptr (GArray) previous = NULL;
+  g_autoptr (GArray) current = NULL;
+  g_autoptr (GArray) segments = NULL;
+  gint weekday;
 
-  layout_manager = gtk_widget_get_layout_manager (GTK_WIDGET (self->grid));
+  segments = g_array_new (FALSE, FALSE, sizeof (Segment));
+  previous = g_array_new (FALSE, FALSE, sizeof (guint));
+  current = g_array_new (FALSE, FALSE, sizeof (guint));
 
-  /* First, lets find the widgets at this column */
-  for (child = gtk_widget_get_first_child (GTK_WIDGET (self->grid));
-       child;
-       child = gtk_widget_get_next_sibling (child))
+  for (weekday = 0; weekday < N_WEEKDAYS; weekday++)
     {
-      gint top_attach, left_attach, width;
-      GtkLayoutChild *layout_child;
+      GArray *aux;
+      guint position;
 
-      /* Get the widget's current position... */
-      layout_child = gtk_layout_manager_get_layout_child (layout_manager, child);
-      top_attach = gtk_grid_layout_child_get_row (GTK_GRID_LAYOUT_CHILD (layout_child));
-      left_attach = gtk_grid_layout_child_get_column (GTK_GRID_LAYOUT_CHILD (layout_child));
-      width = gtk_grid_layout_child_get_column_span (GTK_GRID_LAYOUT_CHILD (layout_child));
+      g_array_set_size (current, 0);
 
-      if (left_attach != column || start_at > top_attach - 1 || !GCAL_IS_EVENT_WIDGET (child))
-        continue;
+      for (position = 0; position < self->events[weekday]->len; position++)
+        {
+          GcalEvent *event;
+          Segment segment;
+          gboolean visible;
+          gint64 first, last;
+          guint index;
 
-      /* If this is a multiday event, break it */
-      if (width > 1)
-        split_event_widget_at_column (self, child, column);
+          event = g_ptr_array_index (self->events[weekday], position);
+          visible = is_event_visible (self, weekday, position);
+
+          /* Extend the segment from the previous weekday when the event sits at the same row */
+          if (position < previous->len)
+            {
+              Segment *previous_segment;
 
-      top_attach = top_attach + (direction == DOWN ? 1 : -1);
+              index = g_array_index (previous, guint, position);
+              previous_segment = &g_array_index (segments, Segment, index);
 
-      /* And move it to position + 1 */
-      gtk_grid_layout_child_set_row (GTK_GRID_LAYOUT_CHILD (layout_child), top_attach);
+              if (previous_segment->event == event &&
+                  previous_segment->visible == visible &&
+                  previous_segment->column + previous_segment->span == weekday)
+                {
+                  previous_segment->span++;
+                  g_array_append_val (current, index);
+                  continue;
+                }
+            }
 
-      gtk_widget_set_visible (child, is_event_visible (self, left_attach, top_attach - 1));
+          gcal_event_get_local_days (event, &first, &last);
+
+          segment = (Segment) {
+            .event = event,
+            .widget = NULL,
+            .column = weekday,
+            .span = 1,
+            .row = position + 1,
+            .visible = visible,
+            .first = first - self->week_start_day,
+            .last = last - self->week_start_day,
+          };
+
+          index = segments->len;
+          g_array_append_val (segments, segment);
+          g_array_append_val (current, index);
+        }
+
+      aux = previous;
+      previous = current;
+      current = aux;
     }
+
+  return g_steal_pointer (&segments);
 }
 
-static void
-apply_overflow_at_weekday (GcalWeekHeader *self,
-                           guint           weekday)
+static inline gboolean
+widget_matches_segment (GtkLayoutManager *layout_manager,
+                        GtkWidget        *widget,
+                        Segment          *segment)
 {
-  GtkWidget *child;
-
-  /*
-   * If we don't need overflow, or we already applied the overflow,
-   * we don't need to do anything els.
-   */
-  if (self->expanded || self->overflow_label[weekday] || self->events[weekday]->len < 4)
-    return;
+  GtkGridLayoutChild *layout_child;
 
-  child = gtk_grid_get_child_at (self->grid, weekday, 3);
+  layout_child = GTK_GRID_LAYOUT_CHILD (gtk_layout_manager_get_layout_child (layout_manager, widget));
 
-  if (!child)
-    return;
-
-  split_event_widget_at_column (self, child, weekday);
-  gtk_widget_set_visible (child, FALSE);
+  return gtk_grid_layout_child_get_column (layout_child) == segment->column &&
+         gtk_grid_layout_child_get_row (layout_child) == segment->row &&
+         gtk_grid_layout_child_get_column_span (layout_child) == segment->span;
 }
 
+/*
+ * Lays out the all-day and multiday events of the current week, in the
+ * @columns mask. The new layout is diffed against the widgets already in
+ * the grid: widgets that are already in place are kept untouched, other
+ * widgets of the same event are moved and resized, and only the remaining
+ * segments (i.e. when an event is split) take new widgets from the pool.
+ *
+ * Segments and widgets that are not in, or next to, @columns are skipped:
+ * the events of their columns didn't change, so neither did they.
+ */
 static void
-add_event_to_grid (GcalWeekHeader *self,
-                   GcalEvent      *event,
-                   gint            start,
-                   gint            end)
+update_columns (GcalWeekHeader *self,
+                guint           columns)
 {
-  g_autoptr (GDateTime) week_start = NULL;
-  g_autoptr (GDateTime) week_end = NULL;
+  g_autoptr (GHashTable) event_to_widgets = NULL;
+  g_autoptr (GArray) all_segments = NULL;
+  g_autoptr (GArray) segments = NULL;
   GtkLayoutManager *layout_manager;
-  GtkWidget *widget;
-  gboolean is_visible, was_visible;
-  gint position;
-  gint i;
-
-  /* Take a reference to the event */
-  g_object_ref (event);
-
-  /* Add at least at the first weekday */
-  position = add_event_to_weekday (self, event, start);
-
-  move_events_at_column (self, DOWN, start, position);
-
-  /* Add the event to the grid */
-  widget = gcal_event_widget_pool_take_or_create (self->event_widget_pool, event);
-  g_assert (GCAL_IS_EVENT_WIDGET (widget));
-  setup_event_widget (self, widget);
-
-  gtk_grid_attach (self->grid,
-                   widget,
-                   start,
-                   position + 1,
-                   1,
-                   1);
-
-  /* Setup event visibility */
-  is_visible = is_event_visible (self, start, position);
+  GHashTableIter iter;
+  GPtrArray *widgets;
+  GtkWidget *child;
+  guint i;
 
-  gtk_widget_set_visible (widget, is_visible);
+  GCAL_ENTRY;
 
-  /* Eventually apply the overflow rules */
-  apply_overflow_at_weekday (self, start);
+  all_segments = calculate_segments (self);
+  segments = g_array_sized_new (FALSE, FALSE, sizeof (Segment), all_segments->len);
 
-  /* Single-day events are the simplest case, and the code above is enough to deal with them */
-  if (!gcal_event_is_multiday (event))
-    return;
-
-  week_start = gcal_date_time_get_start_of_week (self->active_date);
-  week_end = gcal_date_time_get_end_of_week (self->active_date);
+  for (i = 0; i < all_segments->len; i++)
+    {
+      Segment *segment = &g_array_index (all_segments, Segment, i);
 
-  gcal_event_widget_set_date_start (GCAL_EVENT_WIDGET (widget), week_start);
-  gcal_event_widget_set_date_end (GCAL_EVENT_WIDGET (widget), week_end);
+      if (get_segment_columns (segment->column, segment->span) & columns)
+        g_array_append_val (segments, *segment);
+    }
 
   layout_manager = gtk_widget_get_layout_manager (GTK_WIDGET (self->grid));
+  event_to_widgets = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_ptr_array_unref);
 
-  /*
-   * In addition to moving the current column's events below, multiday
-   * events must also move the events from ~all~ the columns it spans
-   * below
-   */
-  for (i = start + 1; i <= end; i++)
+  for (child = gtk_widget_get_first_child (GTK_WIDGET (self->grid));
+       child;
+       child = gtk_widget_get_next_sibling (child))
     {
-      gint new_position;
-
-      /* Add the event to that day */
-      new_position = add_event_to_weekday (self, event, i);
+      GtkGridLayoutChild *layout_child;
+      GcalEvent *event;
 
-      was_visible = is_visible;
-      is_visible = is_event_visible (self, i, new_position);
+      if (!GCAL_IS_EVENT_WIDGET (child))
+        continue;
 
-      move_events_at_column (self, DOWN, i, new_position);
+      layout_child = GTK_GRID_LAYOUT_CHILD (gtk_layout_manager_get_layout_child (layout_manager, child));
 
-      /* Add the event to the grid */
-      if (new_position == position && was_visible == is_visible)
+      if (!(get_segment_columns (gtk_grid_layout_child_get_column (layout_child),
+                                 gtk_grid_layout_child_get_column_span (layout_child)) & columns))
         {
-          GtkLayoutChild *layout_child;
-
-          layout_child = gtk_layout_manager_get_layout_child (layout_manager, widget);
-          gtk_grid_layout_child_set_column_span (GTK_GRID_LAYOUT_CHILD (layout_child),
-                                                 i - start + 1);
+          continue;
         }
-      else
-        {
-          GDateTime *cloned_widget_start_dt;
-          GtkWidget *cloned_widget;
-
-          cloned_widget_start_dt = g_date_time_add_days (week_start, i);
-
-          cloned_widget = gcal_event_widget_pool_take_or_create (self->event_widget_pool, event);
-          g_assert (GCAL_IS_EVENT_WIDGET (cloned_widget));
-          setup_event_widget (self, cloned_widget);
-
-          gtk_grid_attach (self->grid,
-                           cloned_widget,
-                           i,
-                           new_position + 1,
-                           1,
-                           1);
-
-          gcal_event_widget_set_date_end (GCAL_EVENT_WIDGET (widget), cloned_widget_start_dt);
-          gcal_event_widget_set_date_start (GCAL_EVENT_WIDGET (cloned_widget), cloned_widget_start_dt);
 
-          /* From now on, let's modify this widget */
-          widget = cloned_widget;
+      event = gcal_event_widget_get_event (GCAL_EVENT_WIDGET (child));
+      widgets = g_hash_table_lookup (event_to_widgets, event);
 
-          gtk_widget_set_visible (widget, is_visible);
-
-          g_clear_pointer (&cloned_widget_start_dt, g_date_time_unref);
+      if (!widgets)
+        {
+          widgets = g_ptr_array_new ();
+          g_hash_table_insert (event_to_widgets, event, widgets);
         }
 
-      /* Eventually apply the overflow rules */
-      apply_overflow_at_weekday (self, i);
-
-      /* Update the widget's end date */
-      gcal_event_widget_set_date_end (GCAL_EVENT_WIDGET (widget), week_end);
+      g_ptr_array_add (widgets, child);
     }
-}
-
-static void
-add_event (GcalWeekHeader *self,
-           GcalEvent      *event)
-{
-  g_autoptr (GDateTime) event_start = NULL;
-  g_autoptr (GDateTime) event_end = NULL;
-  g_autoptr (GDateTime) week_start = NULL;
-  g_autoptr (GDateTime) week_end = NULL;
-  gboolean all_day;
-  gint start, end;
 
-  g_return_if_fail (GCAL_IS_WEEK_HEADER (self));
-
-  all_day = gcal_event_get_all_day (event);
-  week_start = gcal_date_time_get_start_of_week (self->active_date);
-  week_end = gcal_date_time_get_end_of_week (self->active_date);
-
-  /* Retrieve the real start and end dates */
-  if (all_day)
+  /* Widgets that are already in place */
+  for (i = 0; i < segments->len; i++)
     {
-      GDateTime *utc_week_start, *utc_week_end, *aux;
-
-      utc_week_start = g_date_time_new_utc (g_date_time_get_year (week_start),
-                                            g_date_time_get_month (week_start),
-                                            g_date_time_get_day_of_month (week_start),
-                                            0, 0, 0);
-      utc_week_end = g_date_time_new_utc (g_date_time_get_year (week_end),
-                                          g_date_time_get_month (week_end),
-                                          g_date_time_get_day_of_month (week_end),
-                                          0, 0, 0);
+      Segment *segment = &g_array_index (segments, Segment, i);
+      guint j;
 
-      event_start = g_date_time_ref (gcal_event_get_date_start (event));
-      event_end = g_date_time_ref (gcal_event_get_date_end (event));
+      widgets = g_hash_table_lookup (event_to_widgets, segment->event);
 
-      /*
-       * Switch the week start and end by the UTC variants, in
-       * order to correctly compare all-day events.
-       */
-      aux = week_start;
-      week_start = utc_week_start;
-      gcal_clear_date_time (&aux);
+      for (j = 0; widgets && j < widgets->len; j++)
+        {
+          GtkWidget *widget = g_ptr_array_index (widgets, j);
 
-      aux = week_end;
-      week_end = utc_week_end;
-      gcal_clear_date_time (&aux);
+          if (!widget_matches_segment (layout_manager, widget, segment))
+            continue;
 
+          segment->widget = widget;
+          g_ptr_array_remove_index_fast (widgets, j);
+          break;
+        }
     }
-  else
-    {
-      event_start = g_date_time_to_local (gcal_event_get_date_start (event));
-      event_end = g_date_time_to_local (gcal_event_get_date_end (event));
-    }
-
-  /* Start position */
-  if (g_date_time_compare (event_start, week_start) >= 0)
-    start = floor (g_date_time_difference (event_start, week_start) / G_TIME_SPAN_DAY);
-  else
-    start = 0;
-
-  /* End position */
-  if (g_date_time_compare (event_end, week_end) < 0)
-    end = floor (g_date_time_difference (event_end, week_start) / G_TIME_SPAN_DAY) - all_day;
-  else
-    end = N_WEEKDAYS - 1;
 
-  /* Sanity checks */
-  if (start > end || start > N_WEEKDAYS - 1 || end < 0)
+  /* Move widgets of the same event, or take new ones from the pool */
+  for (i = 0; i < segments->len; i++)
     {
-      g_warning ("Error adding event '%s' to the week header", gcal_event_get_summary (event));
-      return;
-    }
-
-  /* Add the event widget to the grid */
-  add_event_to_grid (self, event, start, end);
+      Segment *segment = &g_array_index (segments, Segment, i);
 
-  /* Check if we eventually can merge events */
-  check_mergeable_events (self);
-
-  /* And also update the overflow labels */
-  update_overflow (self);
-}
+      if (segment->widget)
+        continue;
 
-static void
-remove_event (GcalWeekHeader *self,
-              GcalEvent      *event)
-{
-  GtkWidget *child;
-  gint weekday;
+      widgets = g_hash_table_lookup (event_to_widgets, segment->event);
 
-  g_return_if_fail (GCAL_IS_WEEK_HEADER (self));
+      if (widgets && widgets->len > 0)
+        {
+          GtkGridLayoutChild *layout_child;
 
-  child = gtk_widget_get_first_child (GTK_WIDGET (self->grid));
-  while (child)
-    {
-      GtkWidget *next = gtk_widget_get_next_sibling (child);
+          segment->widget = g_ptr_array_steal_index_fast (widgets, widgets->len - 1);
 
-      if (GCAL_IS_EVENT_WIDGET (child))
+          layout_child = GTK_GRID_LAYOUT_CHILD (gtk_layout_manager_get_layout_child (layout_manager, segment->widget));
+          gtk_grid_layout_child_set_column (layout_child, segment->column);
+          gtk_grid_layout_child_set_row (layout_child, segment->row);
+          gtk_grid_layout_child_set_column_span (layout_child, segment->span);
+        }
+      else
         {
-          GcalEventWidget *child_widget = GCAL_EVENT_WIDGET (child);
+          segment->widget = gcal_event_widget_pool_take_or_create (self->event_widget_pool, segment->event);
+          g_assert (GCAL_IS_EVENT_WIDGET (segment->widget));
+          setup_event_widget (self, segment->widget);
 
-          if (gcal_event_widget_get_event (child_widget) == event)
-            destroy_event_widget (self, child);
+          gtk_grid_attach (self->grid,
+                           segment->widget,
+                           segment->column,
+                           segment->row,
+                           segment->span,
+                           1);
         }
+    }
 
-      child = next;
+  /* Whatever is left was merged, or isn't in this week anymore */
+  g_hash_table_iter_init (&iter, event_to_widgets);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &widgets))
+    {
+      for (i = 0; i < widgets->len; i++)
+        destroy_event_widget (self, g_ptr_array_index (widgets, i));
     }
 
-  /* Remove from the weekday's GList */
-  for (weekday = 0; weekday < N_WEEKDAYS; weekday++)
+  for (i = 0; i < segments->len; i++)
     {
-      guint event_position;
+      Segment *segment = &g_array_index (segments, Segment, i);
+      GcalEventWidget *event_widget = GCAL_EVENT_WIDGET (segment->widget);
+      gint last_column = segment->column + segment->span - 1;
 
-      if (!g_ptr_array_find (self->events[weekday], event, &event_position))
-        continue;
+      gcal_event_widget_set_date_start (event_widget,
+                                        segment->column == segment->first ?
+                                        gcal_event_get_date_start (segment->event) :
+                                        self->column_dates[segment->column]);
 
-      /* Remove from the current weekday */
-      g_ptr_array_remove_index (self->events[weekday], event_position);
+      gcal_event_widget_set_date_end (event_widget,
+                                      last_column == segment->last ?
+                                      gcal_event_get_date_end (segment->event) :
+                                      self->column_dates[last_column + 1]);
 
-      /* Move remaining events up */
-      move_events_at_column (self, UP, weekday, event_position);
+      gtk_widget_set_visible (segment->widget, segment->visible);
     }
 
-  /* Check if we eventually can merge events */
-  check_mergeable_events (self);
-
-  /* And also update the overflow labels */
   update_overflow (self);
+
+  GCAL_EXIT;
 }
 
+/*
+ * Lays out all events of the current week from scratch. This is only
+ * necessary when the week, or the visibility of the events, changes.
+ */
 static void
-update_unchanged_events (GcalWeekHeader *self,
-                         GDateTime      *new_date)
+update_layout (GcalWeekHeader *self)
 {
-  g_autoptr (GHashTable) events_to_update = NULL;
-  g_autoptr (GDateTime) new_week_start = NULL;
-  g_autoptr (GDateTime) utc_week_start = NULL;
-  g_autoptr (GDateTime) new_week_end = NULL;
-  g_autoptr (GDateTime) utc_week_end = NULL;
-  GHashTableIter iter;
-  gint weekday;
-
-  events_to_update = g_hash_table_new_full (g_direct_hash, g_direct_equal, g_object_unref, NULL);
-
-  new_week_start = gcal_date_time_get_start_of_week (new_date);
-  new_week_end = gcal_date_time_get_end_of_week (new_date);
-
-  utc_week_start = g_date_time_new_utc (g_date_time_get_year (new_week_start),
-                                        g_date_time_get_month (new_week_start),
-                                        g_date_time_get_day_of_month (new_week_start),
-                                        0, 0, 0);
-  utc_week_end = g_date_time_add_days (utc_week_start, N_WEEKDAYS);
-
-  for (weekday = 0; weekday < N_WEEKDAYS; weekday++)
-    {
-      for (gsize i = 0; i < self->events[weekday]->len; i++)
-        {
-          g_autoptr (GDateTime) event_start = NULL;
-          g_autoptr (GDateTime) event_end = NULL;
-          GDateTime *week_start, *week_end;
-          GcalEvent *event;
-
-          event = g_ptr_array_index (self->events[weekday], i);
-
-          /*
-           * When the event is all day, we must be careful to compare its dates
-           * against the UTC variants of the week start and end dates.
-           */
-          if (gcal_event_get_all_day (event))
-            {
-              event_start = g_date_time_ref (gcal_event_get_date_start (event));
-              event_end = g_date_time_ref (gcal_event_get_date_end (event));
-
-              week_start = utc_week_start;
-              week_end = utc_week_end;
-            }
-          else
-            {
-              event_start = g_date_time_to_local (gcal_event_get_date_start (event));
-              event_end = g_date_time_to_local (gcal_event_get_date_end (event));
-
-              week_start = new_week_start;
-              week_end = new_week_end;
-            }
-
-          /*
-           * Check if the event must be updated. If we're going to the future, updatable events
-           * are events that started somewhere in the past, and are still present. If we're
-           * going to the past, updatable events are events that started
-           */
-          if (g_date_time_compare (event_start, week_end) < 0 &&
-              g_date_time_compare (event_end, week_start) > 0 &&
-              !g_hash_table_contains (events_to_update, event))
-            {
-              g_hash_table_add (events_to_update, g_object_ref (event));
-            }
-        }
-    }
+  if (!self->active_date)
+    return;
 
-  g_hash_table_iter_init (&iter, events_to_update);
-  {
-    GcalEvent *event;
-    while (g_hash_table_iter_next (&iter, (gpointer *) &event, NULL))
-      {
-        remove_event (self, event);
-        add_event (self, event);
-      }
-  }
+  distribute_events_in_weekdays (self);
+  update_columns (self, (1 << N_WEEKDAYS) - 1);
 }
 
 /* Header */
@@ -1164,9 +953,6 @@ update_title (GcalWeekHeader *self)
 static void
 header_collapse (GcalWeekHeader *self)
 {
-  GtkLayoutManager *layout_manager;
-  GtkWidget *child;
-
   self->expanded = FALSE;
 
   gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (self->scrolledwindow),
@@ -1174,36 +960,16 @@ header_collapse (GcalWeekHeader *self)
                                   GTK_POLICY_NEVER);
   gtk_scrolled_window_set_max_content_height (GTK_SCROLLED_WINDOW (self->scrolledwindow), -1);
 
-  layout_manager = gtk_widget_get_layout_manager (GTK_WIDGET (self->grid));
-
-  for (child = gtk_widget_get_first_child (GTK_WIDGET (self->grid));
-       child;
-       child = gtk_widget_get_next_sibling (child))
-    {
-      GtkLayoutChild *layout_child;
-      gint top_attach, left_attach;
-
-      layout_child = gtk_layout_manager_get_layout_child (layout_manager, child);
-      left_attach = gtk_grid_layout_child_get_column (GTK_GRID_LAYOUT_CHILD (layout_child));
-      top_attach = gtk_grid_layout_child_get_row (GTK_GRID_LAYOUT_CHILD (layout_child));
-
-      gtk_widget_set_visible (child, is_event_visible (self, left_attach, top_attach - 1));
-
-      apply_overflow_at_weekday (self, left_attach);
-    }
-
-  update_overflow (self);
+  /* Split events broken by the overflow labels */
+  update_layout (self);
 }
 
 static void
 header_expand (GcalWeekHeader *self)
 {
-  GtkLayoutManager *layout_manager;
   GtkWidget *week_view;
-  GtkWidget *child;
 
   week_view = gtk_widget_get_ancestor (GTK_WIDGET (self), GCAL_TYPE_WEEK_VIEW);
-  layout_manager = gtk_widget_get_layout_manager (GTK_WIDGET (self->grid));
 
   self->expanded = TRUE;
 
@@ -1215,33 +981,8 @@ header_expand (GcalWeekHeader *self)
   gtk_scrolled_window_set_max_content_height (GTK_SCROLLED_WINDOW (self->scrolledwindow),
                                               gtk_widget_get_height (week_view) / 2);
 
-  child = gtk_widget_get_first_child (GTK_WIDGET (self->grid));
-  while (child)
-    {
-      GtkWidget *next = gtk_widget_get_next_sibling (child);
-
-      /* Remove any remaining labels */
-      if (GTK_IS_LABEL (child))
-        {
-          GtkLayoutChild *layout_child;
-          gint column;
-
-          layout_child = gtk_layout_manager_get_layout_child (layout_manager, child);
-          column = gtk_grid_layout_child_get_column (GTK_GRID_LAYOUT_CHILD (layout_child));
-
-          self->overflow_label[column] = NULL;
-          gtk_grid_remove (self->grid, child);
-        }
-      else
-        {
-          gtk_widget_set_visible (child, TRUE);
-        }
-
-      child = next;
-    }
-
-  /* Merge events that were broken because of the overflow label */
-  check_mergeable_events (self);
+  /* Remove the overflow labels, and merge events that were broken by them */
+  update_layout (self);
 }
 
 static void
@@ -1450,17 +1191,11 @@ events_changed_cb (GListModel     *model,
                    GcalWeekHeader *self)
 {
   g_autoptr (GPtrArray) added_events = NULL;
+  guint columns = 0;
 
-  added_events = g_ptr_array_new_full (added, NULL);
-
-  for (unsigned int i = 0; i < removed; i++)
-    {
-      GcalEvent *event = gcal_event_array_get (&self->event_array, position + i);
-
-      g_assert (GCAL_IS_EVENT (event));
+  GCAL_ENTRY;
 
-      remove_event (self, event);
-    }
+  added_events = g_ptr_array_new_full (added, NULL);
 
   for (unsigned int i = 0; i < added; i++)
     {
@@ -1469,7 +1204,13 @@ events_changed_cb (GListModel     *model,
       g_assert (GCAL_IS_EVENT (event));
 
       g_ptr_array_add (added_events, g_object_ref (event));
-      add_event (self, event);
+    }
+
+  /* The weekdays don't own the events, so drop them before the array does */
+  if (self->active_date)
+    {
+      for (unsigned int i = 0; i < removed; i++)
+        columns |= remove_event_from_weekdays (self, gcal_event_array_get (&self->event_array, position + i));
     }
 
   gcal_event_array_splice (&self->event_array,
@@ -1478,6 +1219,17 @@ events_changed_cb (GListModel     *model,
                            FALSE,
                            (GcalEvent **) added_events->pdata,
                            added_events->len);
+
+  if (!self->active_date)
+    GCAL_RETURN ();
+
+  for (unsigned int i = 0; i < added_events->len; i++)
+    columns |= add_event_to_weekdays (self, g_ptr_array_index (added_events, i));
+
+  if (columns != 0)
+    update_columns (self, columns);
+
+  GCAL_EXIT;
 }
 
 /* Drawing area content and size */
@@ -1630,6 +1382,9 @@ gcal_week_header_finalize (GObject *object)
   for (i = 0; i < N_WEEKDAYS; i++)
     g_clear_pointer (&self->events[i], g_ptr_array_unref);
 
+  for (i = 0; i <= N_WEEKDAYS; i++)
+    gcal_clear_date_time (&self->column_dates[i]);
+
   for (i = 0; i < G_N_ELEMENTS (self->weather_infos); i++)
     wid_clear (&self->weather_infos[i]);
 
@@ -1746,8 +1501,9 @@ gcal_week_header_init (GcalWeekHeader *self)
 
   g_signal_connect (self->events_model, "items-changed", G_CALLBACK (events_changed_cb), self);
 
+  /* Events are owned by the event array */
   for (gsize i = 0; i < N_WEEKDAYS; i++)
-    self->events[i] = g_ptr_array_new_with_free_func (g_object_unref);
+    self->events[i] = g_ptr_array_new ();
 
   self->expanded = FALSE;
 
@@ -1853,8 +1609,6 @@ void
 gcal_week_header_set_date (GcalWeekHeader *self,
                            GDateTime      *date)
 {
-  gboolean had_date;
-
   /*
    * If the active date changed, but we're still in the same week,
    * there's no need to recalculate visible events.
@@ -1866,15 +1620,16 @@ gcal_week_header_set_date (GcalWeekHeader *self,
       return;
     }
 
-  had_date = self->active_date != NULL;
-
   gcal_set_date_time (&self->active_date, date);
 
   update_title (self);
   gtk_widget_queue_draw (GTK_WIDGET (self));
 
-  if (had_date)
-    update_unchanged_events (self, self->active_date);
+  if (self->active_date)
+    {
+      update_week_days (self);
+      update_layout (self);
+    }
 
   update_weather_infos (self);
 }
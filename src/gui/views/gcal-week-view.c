@@ -94,9 +94,9 @@ static gboolean
 update_grid_scroll_position (GcalWeekView *self)
 {
   g_autoptr(GDateTime) week_start = NULL;
-  g_autoptr(GDateTime) week_end = NULL;
-  g_autoptr(GDateTime) now = NULL;
+  GcalContext *context;
   GtkAdjustment *vadjustment;
+  GcalClock *clock;
   gdouble minutes, real_value;
   gdouble max, page, page_increment, value;
   gboolean dummy;
@@ -121,16 +121,16 @@ update_grid_scroll_position (GcalWeekView *self)
       GCAL_RETURN (G_SOURCE_REMOVE);
     }
 
-  now = g_date_time_new_now_local ();
+  context = gcal_application_get_context (GCAL_DEFAULT_APPLICATION);
+  clock = gcal_context_get_clock (context);
   week_start = gcal_date_time_get_start_of_week (self->date);
-  week_end = gcal_date_time_get_end_of_week (self->date);
 
   /* Don't animate when not today */
-  if (gcal_date_time_compare_date (now, week_start) < 0 || gcal_date_time_compare_date (now, week_end) >= 0)
+  if (gcal_date_time_compare_date (week_start, gcal_clock_get_week_start (clock)) != 0)
     GCAL_GOTO (out);
 
   vadjustment = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (self->scrolled_window));
-  minutes = g_date_time_get_hour (now) * 60 + g_date_time_get_minute (now);
+  minutes = gcal_clock_get_minute_of_day (clock);
   page = gtk_adjustment_get_page_size (vadjustment);
   max = gtk_adjustment_get_upper (vadjustment);
 
@@ -0,0 +1,303 @@
+/* gcal-date-format-cache.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GcalDateFormatCache"
+
+#include <locale.h>
+
+#include "gcal-date-format-cache.h"
+#include "gcal-date-time-utils.h"
+
+/*
+ * Cache of formatted day and time strings. Event widgets, popovers and
+ * search hits format the same few days and times over and over, and
+ * g_date_time_format() goes through the locale machinery every time.
+ *
+ * Date strings are keyed by the format and the Julian day of the date;
+ * time strings are keyed by the format and the minute of the day. The
+ * caller is responsible for passing date-only and time-only formats,
+ * respectively. Each LC_TIME locale gets its own set of tables.
+ *
+ * Returned strings are owned by the cache, and stay valid until the
+ * next call to gcal_date_format_cache_clear(), which GcalContext does
+ * when the clock format or the time zone changes. Switching locales
+ * does not drop the tables of the previous locale, so strings handed
+ * out before the switch remain valid too.
+ *
+ * This cache is not thread-safe, and must only be used from the main
+ * thread.
+ */
+
+#define MINUTES_PER_DAY (24 * 60)
+
+typedef struct
+{
+  /* interned format → GHashTable (GINT_TO_POINTER (julian day) → gchar*) */
+  GHashTable         *dates;
+
+  /* interned format → GHashTable (GINT_TO_POINTER (minute of day) → gchar*) */
+  GHashTable         *times;
+} LocaleCache;
+
+static GHashTable *locales = NULL;
+static LocaleCache *current_locale = NULL;
+static gchar *current_locale_name = NULL;
+
+static GcalTimeFormat current_time_format = GCAL_TIME_FORMAT_24H;
+
+static guint64 hits = 0;
+static guint64 misses = 0;
+
+
+/*
+ * Auxiliary methods
+ */
+
+static GHashTable*
+new_strings_table (void)
+{
+  return g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+}
+
+static LocaleCache*
+locale_cache_new (void)
+{
+  LocaleCache *cache = g_new0 (LocaleCache, 1);
+
+  cache->dates = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_hash_table_destroy);
+  cache->times = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_hash_table_destroy);
+
+  return cache;
+}
+
+static void
+locale_cache_free (gpointer data)
+{
+  LocaleCache *cache = data;
+
+  g_clear_pointer (&cache->dates, g_hash_table_destroy);
+  g_clear_pointer (&cache->times, g_hash_table_destroy);
+  g_free (cache);
+}
+
+static LocaleCache*
+get_locale_cache (void)
+{
+  const gchar *locale_name;
+
+  locale_name = setlocale (LC_TIME, NULL);
+
+  if (!locale_name)
+    locale_name = "C";
+
+  if (current_locale && g_strcmp0 (current_locale_name, locale_name) == 0)
+    return current_locale;
+
+  if (!locales)
+    locales = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, locale_cache_free);
+
+  current_locale = g_hash_table_lookup (locales, locale_name);
+
+  if (!current_locale)
+    {
+      current_locale = locale_cache_new ();
+      g_hash_table_insert (locales, g_strdup (locale_name), current_locale);
+    }
+
+  g_free (current_locale_name);
+  current_locale_name = g_strdup (locale_name);
+
+  return current_locale;
+}
+
+static const gchar*
+lookup_or_format (GHashTable  *formats,
+                  GDateTime   *date_time,
+                  const gchar *format,
+                  gint         key)
+{
+  const gchar *interned_format;
+  GHashTable *strings;
+  gchar *formatted;
+
+  interned_format = g_intern_string (format);
+  strings = g_hash_table_lookup (formats, interned_format);
+
+  if (!strings)
+    {
+      strings = new_strings_table ();
+      g_hash_table_insert (formats, (gpointer) interned_format, strings);
+    }
+
+  formatted = g_hash_table_lookup (strings, GINT_TO_POINTER (key));
+
+  if (formatted)
+    {
+      hits++;
+      return formatted;
+    }
+
+  misses++;
+
+  formatted = g_date_time_format (date_time, format);
+
+  /* Cache failures as empty strings, so callers never get NULL */
+  if (!formatted)
+    formatted = g_strdup ("");
+
+  g_hash_table_insert (strings, GINT_TO_POINTER (key), formatted);
+
+  return formatted;
+}
+
+
+/*
+ * Public API
+ */
+
+/**
+ * gcal_date_format_cache_set_time_format:
+ * @time_format: a #GcalTimeFormat
+ *
+ * Sets the clock format used by gcal_date_format_cache_get_hour_format().
+ * This is kept in sync with the GcalContext:time-format property.
+ */
+void
+gcal_date_format_cache_set_time_format (GcalTimeFormat time_format)
+{
+  current_time_format = time_format;
+}
+
+/**
+ * gcal_date_format_cache_get_time_format:
+ *
+ * Retrieves the current clock format.
+ *
+ * Returns: a #GcalTimeFormat
+ */
+GcalTimeFormat
+gcal_date_format_cache_get_time_format (void)
+{
+  return current_time_format;
+}
+
+/**
+ * gcal_date_format_cache_get_hour_format:
+ *
+ * Retrieves the g_date_time_format() format matching the current
+ * clock format.
+ *
+ * Returns: (transfer none): a time-only format string
+ */
+const gchar*
+gcal_date_format_cache_get_hour_format (void)
+{
+  return current_time_format == GCAL_TIME_FORMAT_24H ? "%R" : "%I:%M %P";
+}
+
+/**
+ * gcal_date_format_cache_format_date:
+ * @date_time: a #GDateTime
+ * @format: a format string that only depends on the date
+ *
+ * Cached equivalent of g_date_time_format() for date-only formats.
+ *
+ * Returns: (transfer none): the formatted date
+ */
+const gchar*
+gcal_date_format_cache_format_date (GDateTime   *date_time,
+                                    const gchar *format)
+{
+  LocaleCache *cache;
+
+  g_return_val_if_fail (date_time != NULL, NULL);
+  g_return_val_if_fail (format != NULL, NULL);
+
+  cache = get_locale_cache ();
+
+  return lookup_or_format (cache->dates,
+                           date_time,
+                           format,
+                           (gint) gcal_date_time_get_julian_day (date_time));
+}
+
+/**
+ * gcal_date_format_cache_format_time:
+ * @date_time: a #GDateTime
+ * @format: a format string that only depends on the hour and minute
+ *
+ * Cached equivalent of g_date_time_format() for time-only formats.
+ * Seconds are not part of the key, so @format must not use them.
+ *
+ * Returns: (transfer none): the formatted time
+ */
+const gchar*
+gcal_date_format_cache_format_time (GDateTime   *date_time,
+                                    const gchar *format)
+{
+  LocaleCache *cache;
+  gint minute_of_day;
+
+  g_return_val_if_fail (date_time != NULL, NULL);
+  g_return_val_if_fail (format != NULL, NULL);
+
+  cache = get_locale_cache ();
+  minute_of_day = g_date_time_get_hour (date_time) * 60 + g_date_time_get_minute (date_time);
+
+  g_assert (minute_of_day >= 0 && minute_of_day < MINUTES_PER_DAY);
+
+  return lookup_or_format (cache->times, date_time, format, minute_of_day);
+}
+
+/**
+ * gcal_date_format_cache_get_stats:
+ * @out_hits: (out)(optional): return location for the number of hits
+ * @out_misses: (out)(optional): return location for the number of misses
+ *
+ * Retrieves the number of strings served from the cache, and the
+ * number of strings that had to be formatted.
+ */
+void
+gcal_date_format_cache_get_stats (guint64 *out_hits,
+                                  guint64 *out_misses)
+{
+  if (out_hits)
+    *out_hits = hits;
+
+  if (out_misses)
+    *out_misses = misses;
+}
+
+/**
+ * gcal_date_format_cache_clear:
+ *
+ * Drops all cached strings of all locales, and resets the statistics.
+ * Strings previously returned by the cache become invalid.
+ */
+void
+gcal_date_format_cache_clear (void)
+{
+  g_clear_pointer (&locales, g_hash_table_destroy);
+  g_clear_pointer (&current_locale_name, g_free);
+  current_locale = NULL;
+
+  hits = 0;
+  misses = 0;
+}
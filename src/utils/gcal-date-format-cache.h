@@ -0,0 +1,46 @@
+/* gcal-date-format-cache.h
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+#include "gcal-enums.h"
+
+G_BEGIN_DECLS
+
+void                 gcal_date_format_cache_set_time_format      (GcalTimeFormat      time_format);
+
+GcalTimeFormat       gcal_date_format_cache_get_time_format      (void);
+
+const gchar*         gcal_date_format_cache_get_hour_format      (void);
+
+const gchar*         gcal_date_format_cache_format_date          (GDateTime          *date_time,
+                                                                  const gchar        *format);
+
+const gchar*         gcal_date_format_cache_format_time          (GDateTime          *date_time,
+                                                                  const gchar        *format);
+
+void                 gcal_date_format_cache_get_stats            (guint64            *out_hits,
+                                                                  guint64            *out_misses);
+
+void                 gcal_date_format_cache_clear                (void);
+
+G_END_DECLS
@@ -19,8 +19,12 @@
  */
 
 #include "gcal-date-time-utils.h"
+#include "gcal-time-zone-cache.h"
 #include "gcal-utils.h"
 
+#define SECONDS_PER_DAY       (24 * 60 * 60)
+#define UNIX_EPOCH_JULIAN_DAY 719163 /* 1970-01-01 */
+
 /**
  * gcal_set_datetime:
  * @dest: location to a #GDateTime pointer
@@ -152,6 +156,57 @@ gcal_date_time_compare_date (GDateTime *dt1,
   return g_date_days_between (&d2, &d1);
 }
 
+/**
+ * gcal_date_time_get_julian_day:
+ * @dt: a #GDateTime
+ *
+ * Retrieves the Julian day number of the date of @dt, in
+ * the timezone of @dt. Day 1 is January 1st of year 1.
+ *
+ * Returns: the Julian day number of @dt
+ */
+gint64
+gcal_date_time_get_julian_day (GDateTime *dt)
+{
+  GDate date;
+  gint year, month, day;
+
+  g_date_time_get_ymd (dt, &year, &month, &day);
+
+  g_date_clear (&date, 1);
+  g_date_set_dmy (&date, day, month, year);
+
+  return g_date_get_julian (&date);
+}
+
+/**
+ * gcal_date_time_get_julian_day_at_timezone:
+ * @unix_time: a UNIX timestamp
+ * @tz: a #GTimeZone
+ *
+ * Retrieves the Julian day number of @unix_time at @tz. This is
+ * equivalent to converting to @tz and calling gcal_date_time_get_julian_day(),
+ * but doesn't allocate any #GDateTime.
+ *
+ * Returns: the Julian day number of @unix_time at @tz
+ */
+gint64
+gcal_date_time_get_julian_day_at_timezone (gint64     unix_time,
+                                           GTimeZone *tz)
+{
+  gint64 local_time;
+  gint interval;
+
+  interval = g_time_zone_find_interval (tz, G_TIME_TYPE_UNIVERSAL, unix_time);
+  local_time = unix_time + g_time_zone_get_offset (tz, interval);
+
+  /* Round towards negative infinity, so that times before the epoch land on the right day */
+  if (local_time < 0)
+    local_time -= SECONDS_PER_DAY - 1;
+
+  return local_time / SECONDS_PER_DAY + UNIX_EPOCH_JULIAN_DAY;
+}
+
 /**
  * gcal_date_time_to_icaltime:
  * @dt: a #GDateTime
@@ -259,16 +314,7 @@ gcal_date_time_from_icaltime (const ICalTime *date)
 ICalTimezone*
 gcal_timezone_to_icaltimezone (GTimeZone *tz)
 {
-  ICalTimezone *ical_tz;
-  const gchar *tzid;
-
-  tzid = g_time_zone_get_identifier (tz);
-  ical_tz = i_cal_timezone_get_builtin_timezone (tzid);
-
-  if (!ical_tz)
-    ical_tz = i_cal_timezone_get_utc_timezone ();
-
-  return ical_tz;
+  return gcal_time_zone_cache_lookup_builtin_zone (tz);
 }
 
 /**
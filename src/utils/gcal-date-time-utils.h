@@ -45,6 +45,11 @@ GDateTime*           gcal_date_time_get_end_of_week              (GDateTime
 gint                 gcal_date_time_compare_date                 (GDateTime          *dt1,
                                                                   GDateTime          *dt2);
 
+gint64               gcal_date_time_get_julian_day               (GDateTime          *dt);
+
+gint64               gcal_date_time_get_julian_day_at_timezone   (gint64              unix_time,
+                                                                  GTimeZone          *tz);
+
 ICalTime*            gcal_date_time_to_icaltime                  (GDateTime          *dt);
 
 gboolean             gcal_date_time_is_date                      (GDateTime          *dt);
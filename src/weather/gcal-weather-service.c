@@ -18,7 +18,9 @@
 
 #define G_LOG_DOMAIN      "GcalWeatherService"
 
+#include <errno.h>
 #include <geoclue.h>
+#include <stdio.h>
 #include <string.h>
 #include <math.h>
 
@@ -35,6 +37,8 @@
 
 #define DAY_SECONDS (24 * 60 * 60)
 
+#define FORECAST_GROUP "forecast"
+
 /**
  * Internal structure used to manage known
  * weather icons.
@@ -62,7 +66,10 @@ typedef struct
  * @location_cancellable:    Used to deal with async location service construction.
  * @locaton_running:         Whether location service is active.
  * @weather_infos:           List of #GcalWeatherInfo objects.
- * @weather_infos_upated:    The monotonic time @weather_info was set at.
+ * @weather_infos_by_day:    @weather_infos indexed by their Julian day.
+ * @weather_infos_upated:    The real time @weather_info was fetched at.
+ * @location_key:            Identifies the location of @gweather_info.
+ * @forecast_location_key:   Identifies the location @weather_infos belong to.
  * @valid_timespan:          Amount of seconds weather information are considered valid.
  * @gweather_info:           The weather info to query.
  * @max_days:                Number of days we want weather information for.
@@ -104,7 +111,10 @@ struct _GcalWeatherService
 
   /* weather: */
   GPtrArray          *weather_infos;        /* owned[owned] */
+  GHashTable         *weather_infos_by_day; /* owned[unowned] */
   gint64              weather_infos_upated;
+  gchar              *location_key;         /* owned, nullable */
+  gchar              *forecast_location_key; /* owned, nullable */
   gint64              valid_timespan;
   GWeatherInfo       *gweather_info;        /* owned, nullable */
   guint               max_days;
@@ -220,8 +230,198 @@ has_valid_weather_infos (GcalWeatherService *self)
   if (self->gweather_info == NULL || self->weather_infos_upated < 0)
     return FALSE;
 
-  now = g_get_monotonic_time ();
-  return (now - self->weather_infos_upated) / 1000000 <= self->valid_timespan;
+  now = g_get_real_time ();
+  return (now - self->weather_infos_upated) / G_USEC_PER_SEC <= self->valid_timespan;
+}
+
+static gchar*
+get_location_key (GWeatherLocation *location)
+{
+  gchar latitude[G_ASCII_DTOSTR_BUF_SIZE];
+  gchar longitude[G_ASCII_DTOSTR_BUF_SIZE];
+  gdouble lat;
+  gdouble lon;
+
+  if (!location)
+    return NULL;
+
+  if (!gweather_location_has_coords (location))
+    return g_strdup (gweather_location_get_name (location));
+
+  gweather_location_get_coords (location, &lat, &lon);
+
+  return g_strdup_printf ("%s,%s",
+                          g_ascii_formatd (latitude, sizeof (latitude), "%.4f", lat),
+                          g_ascii_formatd (longitude, sizeof (longitude), "%.4f", lon));
+}
+
+static gchar*
+get_forecast_path (void)
+{
+  return g_build_filename (g_get_user_cache_dir (), "gnome-calendar", "weather-forecast", NULL);
+}
+
+static void
+set_weather_infos (GcalWeatherService *self,
+                   GPtrArray          *weather_infos,
+                   gint64              updated,
+                   const gchar        *location_key)
+{
+  g_autofree gchar *new_location_key = g_strdup (location_key);
+
+  g_clear_pointer (&self->weather_infos, g_ptr_array_unref);
+  g_clear_pointer (&self->forecast_location_key, g_free);
+  g_hash_table_remove_all (self->weather_infos_by_day);
+
+  self->weather_infos = weather_infos;
+  self->weather_infos_upated = weather_infos ? updated : -1;
+  self->forecast_location_key = weather_infos ? g_steal_pointer (&new_location_key) : NULL;
+
+  for (guint i = 0; weather_infos && i < weather_infos->len; i++)
+    {
+      GcalWeatherInfo *info;
+      GDate date;
+
+      info = g_ptr_array_index (weather_infos, i);
+      gcal_weather_info_get_date (info, &date);
+
+      g_hash_table_insert (self->weather_infos_by_day, GUINT_TO_POINTER (g_date_get_julian (&date)), info);
+    }
+}
+
+/*
+ * Forecasts are persisted, so that they can be shown right away at
+ * startup instead of waiting for the location and weather services.
+ */
+static void
+save_forecast (GcalWeatherService *self)
+{
+  g_autoptr (GKeyFile) key_file = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *dirname = NULL;
+  g_autofree gchar *path = NULL;
+
+  if (!self->weather_infos || !self->forecast_location_key)
+    return;
+
+  key_file = g_key_file_new ();
+  g_key_file_set_int64 (key_file, FORECAST_GROUP, "updated", self->weather_infos_upated / G_USEC_PER_SEC);
+  g_key_file_set_string (key_file, FORECAST_GROUP, "location", self->forecast_location_key);
+
+  for (guint i = 0; i < self->weather_infos->len; i++)
+    {
+      GcalWeatherInfo *info;
+      gchar group[16];
+      GDate date;
+
+      info = g_ptr_array_index (self->weather_infos, i);
+      gcal_weather_info_get_date (info, &date);
+      g_snprintf (group, sizeof (group), "%04u-%02u-%02u",
+                  g_date_get_year (&date),
+                  g_date_get_month (&date),
+                  g_date_get_day (&date));
+
+      g_key_file_set_string (key_file, group, "icon-name", gcal_weather_info_get_icon_name (info));
+      g_key_file_set_string (key_file, group, "temperature", gcal_weather_info_get_temperature (info));
+    }
+
+  path = get_forecast_path ();
+  dirname = g_path_get_dirname (path);
+
+  if (g_mkdir_with_parents (dirname, 0700) != 0)
+    {
+      g_debug ("Could not create %s: %s", dirname, g_strerror (errno));
+      return;
+    }
+
+  if (!g_key_file_save_to_file (key_file, path, &error))
+    g_debug ("Could not save weather forecast: %s", error->message);
+}
+
+static gboolean
+load_forecast (GcalWeatherService *self,
+               const gchar        *location_key)
+{
+  g_autoptr (GPtrArray) weather_infos = NULL;
+  g_autoptr (GKeyFile) key_file = NULL;
+  g_autoptr (GDateTime) now = NULL;
+  g_autoptr (GTimeZone) zone = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *cached_location_key = NULL;
+  g_autofree gchar *path = NULL;
+  g_auto (GStrv) groups = NULL;
+  GDate today;
+  gint64 updated;
+
+  key_file = g_key_file_new ();
+  path = get_forecast_path ();
+
+  if (!g_key_file_load_from_file (key_file, path, G_KEY_FILE_NONE, &error))
+    {
+      if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+        g_debug ("Could not load weather forecast: %s", error->message);
+      return FALSE;
+    }
+
+  updated = g_key_file_get_int64 (key_file, FORECAST_GROUP, "updated", NULL);
+  cached_location_key = g_key_file_get_string (key_file, FORECAST_GROUP, "location", NULL);
+
+  if (!cached_location_key || (location_key && g_strcmp0 (location_key, cached_location_key) != 0))
+    return FALSE;
+
+  if (g_get_real_time () / G_USEC_PER_SEC - updated > self->valid_timespan)
+    return FALSE;
+
+  zone = !self->timezone ? g_time_zone_new_local () : g_time_zone_ref (self->timezone);
+  now = g_date_time_new_now (zone);
+
+  g_date_clear (&today, 1);
+  g_date_set_dmy (&today,
+                  g_date_time_get_day_of_month (now),
+                  g_date_time_get_month (now),
+                  g_date_time_get_year (now));
+
+  weather_infos = g_ptr_array_new_full (self->max_days, g_object_unref);
+  groups = g_key_file_get_groups (key_file, NULL);
+
+  for (gsize i = 0; groups[i]; i++)
+    {
+      g_autofree gchar *temperature = NULL;
+      g_autofree gchar *icon_name = NULL;
+      guint year, month, day;
+      GDate date;
+
+      if (sscanf (groups[i], "%04u-%02u-%02u", &year, &month, &day) != 3 ||
+          !g_date_valid_dmy (day, month, year))
+        {
+          continue;
+        }
+
+      g_date_clear (&date, 1);
+      g_date_set_dmy (&date, day, month, year);
+
+      /* Past days have no forecast */
+      if (g_date_compare (&date, &today) < 0)
+        continue;
+
+      icon_name = g_key_file_get_string (key_file, groups[i], "icon-name", NULL);
+      temperature = g_key_file_get_string (key_file, groups[i], "temperature", NULL);
+
+      if (!icon_name || !temperature)
+        continue;
+
+      g_ptr_array_add (weather_infos, gcal_weather_info_new (&date, icon_name, temperature));
+    }
+
+  if (weather_infos->len == 0)
+    return FALSE;
+
+  g_debug ("Using the weather forecast cached for '%s'", cached_location_key);
+
+  set_weather_infos (self, g_steal_pointer (&weather_infos), updated * G_USEC_PER_SEC, cached_location_key);
+  g_signal_emit (self, signals[SIG_WEATHER_CHANGED], 0);
+
+  return TRUE;
 }
 
 static void
@@ -606,17 +806,18 @@ update_weather (GcalWeatherService *self,
     {
       if (!reuse_old_on_error || !has_valid_weather_infos (self))
         {
-          g_clear_pointer (&self->weather_infos, g_ptr_array_unref);
-          self->weather_infos_upated = -1;
+          set_weather_infos (self, NULL, -1, NULL);
 
           g_signal_emit (self, signals[SIG_WEATHER_CHANGED], 0);
         }
     }
   else if (gwforecast)
     {
-      g_clear_pointer (&self->weather_infos, g_ptr_array_unref);
-      self->weather_infos = preprocess_gweather_reports (self, gwforecast);
-      self->weather_infos_upated = g_get_monotonic_time ();
+      set_weather_infos (self,
+                         preprocess_gweather_reports (self, gwforecast),
+                         g_get_real_time (),
+                         self->location_key);
+      save_forecast (self);
 
       g_signal_emit (self, signals[SIG_WEATHER_CHANGED], 0);
     }
@@ -626,6 +827,8 @@ static void
 update_location (GcalWeatherService  *self,
                  GWeatherLocation    *location)
 {
+  gboolean same_location;
+
   if (gcal_timer_is_running (self->duration_timer))
     stop_timer (self);
 
@@ -635,6 +838,11 @@ update_location (GcalWeatherService  *self,
       g_clear_object (&self->gweather_info);
     }
 
+  g_clear_pointer (&self->location_key, g_free);
+  self->location_key = get_location_key (location);
+
+  same_location = self->location_key && g_strcmp0 (self->location_key, self->forecast_location_key) == 0;
+
   if (!location)
     {
       g_debug ("Could not retrieve current location");
@@ -661,9 +869,10 @@ update_location (GcalWeatherService  *self,
        * remove weather information before querying new one.
        * This might result in icon flickering on screen.
        * We probably want to introduce a "unknown" or "loading"
-       * state in gweather-info to soften the effect.
+       * state in gweather-info to soften the effect. Forecasts
+       * that are still valid for the same location are kept.
        */
-      update_weather (self, NULL, FALSE);
+      update_weather (self, NULL, same_location);
       gweather_info_update (self->gweather_info);
 
       start_timer (self);
@@ -881,6 +1090,9 @@ gcal_weather_service_finalize (GObject *object)
   g_clear_pointer (&self->midnight_timer, gcal_timer_free);
   g_clear_pointer (&self->timezone, g_time_zone_unref);
   g_clear_pointer (&self->weather_infos, g_ptr_array_unref);
+  g_clear_pointer (&self->weather_infos_by_day, g_hash_table_destroy);
+  g_clear_pointer (&self->location_key, g_free);
+  g_clear_pointer (&self->forecast_location_key, g_free);
 
   g_clear_object (&self->gweather_info);
   g_clear_object (&self->location_service);
@@ -1003,6 +1215,7 @@ gcal_weather_service_init (GcalWeatherService *self)
   self->check_interval_renew = GCAL_WEATHER_CHECK_INTERVAL_RENEW_DEFAULT;
   self->location_cancellable = g_cancellable_new ();
   self->weather_infos_upated = -1;
+  self->weather_infos_by_day = g_hash_table_new (g_direct_hash, g_direct_equal);
   self->valid_timespan = GCAL_WEATHER_VALID_TIMESPAN_DEFAULT;
 
   self->duration_timer = gcal_timer_new (GCAL_WEATHER_CHECK_INTERVAL_NEW_DEFAULT);
@@ -1124,21 +1337,9 @@ gcal_weather_service_get_weather_info_for_date (GcalWeatherService *self,
                                                 GDate              *date)
 {
   g_return_val_if_fail (GCAL_IS_WEATHER_SERVICE (self), NULL);
+  g_return_val_if_fail (date != NULL && g_date_valid (date), NULL);
 
-  for (guint i = 0; self->weather_infos && i < self->weather_infos->len; i++)
-    {
-      GcalWeatherInfo *info;
-      GDate weather_date;
-
-      info = g_ptr_array_index (self->weather_infos, i);
-
-      gcal_weather_info_get_date (info, &weather_date);
-
-      if (g_date_compare (&weather_date, date) == 0)
-        return info;
-    }
-
-  return NULL;
+  return g_hash_table_lookup (self->weather_infos_by_day, GUINT_TO_POINTER (g_date_get_julian (date)));
 }
 
 /**
@@ -1258,6 +1459,17 @@ gcal_weather_service_start (GcalWeatherService *self)
 
   self->weather_service_running = TRUE;
 
+  /*
+   * Show the last forecast while the location and the weather are
+   * being fetched. When the location is automatic, it's assumed to
+   * be the same as last time until GeoClue reports it.
+   */
+  if (!self->weather_infos)
+    {
+      g_autofree gchar *location_key = get_location_key (self->location);
+      load_forecast (self, location_key);
+    }
+
   if (!self->location)
     {
       /* Start location and weather service: */
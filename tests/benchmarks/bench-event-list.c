@@ -0,0 +1,76 @@
+/* bench-event-list.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "gcal-benchmark.h"
+#include "gcal-event-list.h"
+
+/*********************************************************************************************************************/
+
+static void
+event_list_add_events (GcalBenchmark *benchmark,
+                       guint          n_events)
+{
+  g_autoptr (GcalEventList) event_list = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+
+  events = gcal_benchmark_generate_events (benchmark, n_events);
+  event_list = gcal_event_list_new ();
+
+  gcal_benchmark_start (benchmark);
+
+  gcal_event_list_add_events (event_list, (GcalEvent **) events->pdata);
+
+  gcal_benchmark_stop (benchmark, events->len);
+}
+
+/*********************************************************************************************************************/
+
+static void
+event_list_remove_events (GcalBenchmark *benchmark,
+                          guint          n_events)
+{
+  g_autoptr (GcalEventList) event_list = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+
+  events = gcal_benchmark_generate_events (benchmark, n_events);
+  event_list = gcal_event_list_new ();
+  gcal_event_list_add_events (event_list, (GcalEvent **) events->pdata);
+
+  gcal_benchmark_start (benchmark);
+
+  gcal_event_list_remove_events (event_list, (GcalEvent **) events->pdata);
+
+  gcal_benchmark_stop (benchmark, events->len);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  gcal_benchmark_init (&argc, &argv);
+
+  gcal_benchmark_add ("/event-list/add-events", event_list_add_events);
+  gcal_benchmark_add ("/event-list/remove-events", event_list_remove_events);
+
+  return gcal_benchmark_run ();
+}
@@ -0,0 +1,85 @@
+/* bench-event.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "gcal-benchmark.h"
+#include "gcal-event.h"
+
+/*********************************************************************************************************************/
+
+static void
+event_new (GcalBenchmark *benchmark,
+           guint          n_events)
+{
+  g_autoptr (GPtrArray) components = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  GcalCalendar *calendar;
+
+  calendar = gcal_benchmark_get_calendar (benchmark);
+  components = gcal_benchmark_generate_components (benchmark, n_events);
+  events = g_ptr_array_new_full (n_events, g_object_unref);
+
+  gcal_benchmark_start (benchmark);
+
+  for (guint i = 0; i < components->len; i++)
+    g_ptr_array_add (events, gcal_event_new (calendar, g_ptr_array_index (components, i), NULL));
+
+  gcal_benchmark_stop (benchmark, components->len);
+}
+
+/*********************************************************************************************************************/
+
+static void
+event_new_take (GcalBenchmark *benchmark,
+                guint          n_events)
+{
+  g_autoptr (GPtrArray) components = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  GcalCalendar *calendar;
+
+  calendar = gcal_benchmark_get_calendar (benchmark);
+  components = gcal_benchmark_generate_components (benchmark, n_events);
+  events = g_ptr_array_new_full (n_events, g_object_unref);
+
+  gcal_benchmark_start (benchmark);
+
+  for (guint i = 0; i < components->len; i++)
+    {
+      ECalComponent *component = g_object_ref (g_ptr_array_index (components, i));
+
+      g_ptr_array_add (events, gcal_event_new_take (calendar, component, NULL));
+    }
+
+  gcal_benchmark_stop (benchmark, components->len);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  gcal_benchmark_init (&argc, &argv);
+
+  gcal_benchmark_add ("/event/new", event_new);
+  gcal_benchmark_add ("/event/new-take", event_new_take);
+
+  return gcal_benchmark_run ();
+}
@@ -0,0 +1,144 @@
+/* bench-range-tree.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gcal-benchmark.h"
+#include "gcal-event.h"
+#include "gcal-range-tree.h"
+
+#define N_QUERIES 1000
+
+/*
+ * Auxiliary methods
+ */
+
+static GcalRangeTree*
+create_tree_for_events (GPtrArray *events)
+{
+  GcalRangeTree *range_tree;
+
+  range_tree = gcal_range_tree_new_with_free_func (g_object_unref);
+
+  for (guint i = 0; i < events->len; i++)
+    {
+      GcalEvent *event = g_ptr_array_index (events, i);
+
+      gcal_range_tree_add_range (range_tree, gcal_event_get_range (event), g_object_ref (event));
+    }
+
+  return range_tree;
+}
+
+
+/*********************************************************************************************************************/
+
+static void
+range_tree_insert (GcalBenchmark *benchmark,
+                   guint          n_events)
+{
+  g_autoptr (GcalRangeTree) range_tree = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+
+  events = gcal_benchmark_generate_events (benchmark, n_events);
+  range_tree = gcal_range_tree_new_with_free_func (g_object_unref);
+
+  gcal_benchmark_start (benchmark);
+
+  for (guint i = 0; i < events->len; i++)
+    {
+      GcalEvent *event = g_ptr_array_index (events, i);
+
+      gcal_range_tree_add_range (range_tree, gcal_event_get_range (event), g_object_ref (event));
+    }
+
+  gcal_benchmark_stop (benchmark, events->len);
+}
+
+/*********************************************************************************************************************/
+
+static void
+range_tree_query (GcalBenchmark *benchmark,
+                  guint          n_events)
+{
+  g_autoptr (GcalRangeTree) range_tree = NULL;
+  g_autoptr (GPtrArray) queries = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  guint n_results = 0;
+
+  events = gcal_benchmark_generate_events (benchmark, n_events);
+  range_tree = create_tree_for_events (events);
+
+  /* Week-sized queries, like the week view */
+  queries = g_ptr_array_new_full (N_QUERIES, (GDestroyNotify) gcal_range_unref);
+  for (guint i = 0; i < N_QUERIES; i++)
+    g_ptr_array_add (queries, gcal_benchmark_generate_range (benchmark, 7 * G_TIME_SPAN_DAY));
+
+  gcal_benchmark_start (benchmark);
+
+  for (guint i = 0; i < queries->len; i++)
+    {
+      g_autoptr (GPtrArray) results = NULL;
+
+      results = gcal_range_tree_get_data_at_range (range_tree, g_ptr_array_index (queries, i));
+      n_results += results ? results->len : 0;
+    }
+
+  gcal_benchmark_stop (benchmark, queries->len);
+
+  g_debug ("%u events found by %u queries", n_results, queries->len);
+}
+
+/*********************************************************************************************************************/
+
+static void
+range_tree_remove (GcalBenchmark *benchmark,
+                   guint          n_events)
+{
+  g_autoptr (GcalRangeTree) range_tree = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+
+  events = gcal_benchmark_generate_events (benchmark, n_events);
+  range_tree = create_tree_for_events (events);
+
+  gcal_benchmark_start (benchmark);
+
+  for (guint i = 0; i < events->len; i++)
+    {
+      GcalEvent *event = g_ptr_array_index (events, i);
+
+      gcal_range_tree_remove_range (range_tree, gcal_event_get_range (event), event);
+    }
+
+  gcal_benchmark_stop (benchmark, events->len);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  gcal_benchmark_init (&argc, &argv);
+
+  gcal_benchmark_add ("/range-tree/insert", range_tree_insert);
+  gcal_benchmark_add ("/range-tree/query", range_tree_query);
+  gcal_benchmark_add ("/range-tree/remove", range_tree_remove);
+
+  return gcal_benchmark_run ();
+}
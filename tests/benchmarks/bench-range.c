@@ -0,0 +1,64 @@
+/* bench-range.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "gcal-benchmark.h"
+#include "gcal-event.h"
+
+/*********************************************************************************************************************/
+
+static void
+range_calculate_overlap (GcalBenchmark *benchmark,
+                         guint          n_events)
+{
+  g_autoptr (GPtrArray) events = NULL;
+  guint n_overlaps = 0;
+
+  events = gcal_benchmark_generate_events (benchmark, n_events);
+
+  gcal_benchmark_start (benchmark);
+
+  /* Each event against a pseudo-random other event */
+  for (guint i = 0; i < events->len; i++)
+    {
+      GcalRange *a = gcal_event_get_range (g_ptr_array_index (events, i));
+      GcalRange *b = gcal_event_get_range (g_ptr_array_index (events, (i * 7919u) % events->len));
+
+      if (gcal_range_calculate_overlap (a, b, NULL) != GCAL_RANGE_NO_OVERLAP)
+        n_overlaps++;
+    }
+
+  gcal_benchmark_stop (benchmark, events->len);
+
+  g_debug ("%u overlapping pairs", n_overlaps);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  gcal_benchmark_init (&argc, &argv);
+
+  gcal_benchmark_add ("/range/calculate-overlap", range_calculate_overlap);
+
+  return gcal_benchmark_run ();
+}
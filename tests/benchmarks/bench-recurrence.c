@@ -0,0 +1,164 @@
+/* bench-recurrence.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "gcal-benchmark.h"
+#include "gcal-event.h"
+
+#define INSTANCES_PER_SERIES 100
+
+typedef struct
+{
+  GcalCalendar       *calendar;
+  GPtrArray          *events;
+} ExpandData;
+
+/*
+ * Auxiliary methods
+ */
+
+static GPtrArray*
+generate_series (GcalBenchmark *benchmark,
+                 guint          n_series)
+{
+  GPtrArray *series;
+
+  series = g_ptr_array_new_full (n_series, g_object_unref);
+
+  for (guint i = 0; i < n_series; i++)
+    {
+      g_autoptr (GString) string = NULL;
+      ICalComponent *icomponent;
+
+      string = g_string_new_take (gcal_benchmark_generate_event_string (benchmark, i));
+      g_string_replace (string,
+                        "END:VEVENT",
+                        "RRULE:FREQ=DAILY;COUNT=" G_STRINGIFY (INSTANCES_PER_SERIES) "\nEND:VEVENT",
+                        1);
+
+      icomponent = i_cal_component_new_from_string (string->str);
+
+      if (!icomponent)
+        g_error ("Error parsing generated component:\n%s", string->str);
+
+      g_ptr_array_add (series, icomponent);
+    }
+
+  return series;
+}
+
+/*
+ * Mimics what the calendar backend does for each instance, and what the
+ * calendar monitor does with the result.
+ */
+static gboolean
+instance_generated_cb (ICalComponent  *icomponent,
+                       ICalTime       *instance_start,
+                       ICalTime       *instance_end,
+                       gpointer        user_data,
+                       GCancellable   *cancellable,
+                       GError        **error)
+{
+  g_autoptr (ICalProperty) rrule = NULL;
+  ExpandData *data = user_data;
+  ECalComponent *ecomponent;
+  ICalComponent *instance;
+  GcalEvent *event;
+
+  instance = i_cal_component_clone (icomponent);
+
+  rrule = i_cal_component_get_first_property (instance, I_CAL_RRULE_PROPERTY);
+  if (rrule)
+    i_cal_component_remove_property (instance, rrule);
+
+  i_cal_component_set_recurrenceid (instance, instance_start);
+  i_cal_component_set_dtstart (instance, instance_start);
+  i_cal_component_set_dtend (instance, instance_end);
+
+  ecomponent = e_cal_component_new_from_icalcomponent (instance);
+  event = gcal_event_new_take (data->calendar, ecomponent, error);
+
+  if (event)
+    g_ptr_array_add (data->events, event);
+
+  return event != NULL;
+}
+
+
+/*********************************************************************************************************************/
+
+static void
+recurrence_expand (GcalBenchmark *benchmark,
+                   guint          n_events)
+{
+  g_autoptr (GPtrArray) events = NULL;
+  g_autoptr (GPtrArray) series = NULL;
+  g_autoptr (ICalTime) range_start = NULL;
+  g_autoptr (ICalTime) range_end = NULL;
+  ICalTimezone *utc;
+  ExpandData data;
+
+  utc = i_cal_timezone_get_utc_timezone ();
+  series = generate_series (benchmark, MAX (n_events / INSTANCES_PER_SERIES, 1));
+  events = g_ptr_array_new_full (n_events, g_object_unref);
+
+  /* Wide enough for every instance of every series */
+  range_start = i_cal_time_new_from_string ("20250101T000000Z");
+  range_end = i_cal_time_new_from_string ("20290101T000000Z");
+
+  data.calendar = gcal_benchmark_get_calendar (benchmark);
+  data.events = events;
+
+  gcal_benchmark_start (benchmark);
+
+  for (guint i = 0; i < series->len; i++)
+    {
+      g_autoptr (GError) error = NULL;
+
+      e_cal_recur_generate_instances_sync (g_ptr_array_index (series, i),
+                                           range_start,
+                                           range_end,
+                                           instance_generated_cb,
+                                           &data,
+                                           NULL,
+                                           NULL,
+                                           utc,
+                                           NULL,
+                                           &error);
+
+      if (error)
+        g_error ("Error expanding recurrence: %s", error->message);
+    }
+
+  gcal_benchmark_stop (benchmark, events->len);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  gcal_benchmark_init (&argc, &argv);
+
+  gcal_benchmark_add ("/recurrence/expand", recurrence_expand);
+
+  return gcal_benchmark_run ();
+}
@@ -0,0 +1,63 @@
+/* bench-timeline-sorter.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "gcal-benchmark.h"
+#include "gcal-event.h"
+#include "gcal-timeline.h"
+
+/*********************************************************************************************************************/
+
+static void
+timeline_sorter_sort (GcalBenchmark *benchmark,
+                      guint          n_events)
+{
+  g_autoptr (GtkSortListModel) sorted_events = NULL;
+  g_autoptr (GListStore) store = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+
+  events = gcal_benchmark_generate_events (benchmark, n_events);
+
+  store = g_list_store_new (GCAL_TYPE_EVENT);
+  g_list_store_splice (store, 0, 0, events->pdata, events->len);
+
+  gcal_benchmark_start (benchmark);
+
+  /* Non-incremental sort list models sort synchronously */
+  sorted_events = gtk_sort_list_model_new (G_LIST_MODEL (g_object_ref (store)),
+                                           gcal_timeline_new_event_sorter ());
+
+  gcal_benchmark_stop (benchmark, events->len);
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (sorted_events)), ==, n_events);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  gcal_benchmark_init (&argc, &argv);
+
+  gcal_benchmark_add ("/timeline/sorter", timeline_sorter_sort);
+
+  return gcal_benchmark_run ();
+}
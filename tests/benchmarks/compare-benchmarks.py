@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+#
+# Copyright 2026 The GNOME Calendar developers
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Compare two sets of benchmark results.
+
+Each input file contains the JSON lines printed by the bench-* programs,
+usually for two different commits:
+
+    $ git checkout main && ninja -C _build
+    $ _build/tests/benchmarks/bench-range-tree --label=main > main.json
+    $ git checkout my-branch && ninja -C _build
+    $ _build/tests/benchmarks/bench-range-tree --label=my-branch > my-branch.json
+    $ tests/benchmarks/compare-benchmarks.py main.json my-branch.json
+
+Results are matched by benchmark name and dataset size. Changes smaller
+than the threshold are considered noise.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    results = {}
+
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith('{'):
+                continue
+
+            result = json.loads(line)
+            results[(result['benchmark'], result['n_events'])] = result
+
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two sets of benchmark results')
+    parser.add_argument('baseline', help='results of the baseline')
+    parser.add_argument('candidate', help='results to compare against the baseline')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='changes below this percentage are reported as noise (default: 5)')
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    candidate = load_results(args.candidate)
+
+    print(f'{"benchmark":<32} {"events":>8} {"baseline":>14} {"candidate":>14} {"change":>9}')
+
+    n_regressions = 0
+
+    for key in sorted(baseline.keys() & candidate.keys()):
+        name, n_events = key
+        before = baseline[key]['ns_per_operation']
+        after = candidate[key]['ns_per_operation']
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+
+        if abs(change) < args.threshold:
+            verdict = ''
+        elif change > 0:
+            verdict = '  slower'
+            n_regressions += 1
+        else:
+            verdict = '  faster'
+
+        print(f'{name:<32} {n_events:>8} {before:>11.2f} ns {after:>11.2f} ns {change:>+8.1f}%{verdict}')
+
+    for key in sorted(baseline.keys() ^ candidate.keys()):
+        print(f'{key[0]:<32} {key[1]:>8} only in {"baseline" if key in baseline else "candidate"}')
+
+    return 1 if n_regressions > 0 else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,638 @@
+/* gcal-benchmark.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "gcal-benchmark.h"
+#include "gcal-event.h"
+#include "gcal-stub-calendar.h"
+
+/*
+ * Minimal harness for microbenchmarks. Each benchmark runs once per
+ * dataset size and repetition, on a synthetic dataset generated from
+ * a fixed seed, so that two builds measure exactly the same work.
+ *
+ * Results are printed to stdout as JSON lines, one per benchmark and
+ * dataset size, and can be compared with compare-benchmarks.py:
+ *
+ *   $ ./bench-range-tree --label=before > before.json
+ *   $ ./bench-range-tree --label=after > after.json
+ *   $ compare-benchmarks.py before.json after.json
+ *
+ * When GCAL_BENCHMARK_COUNT_ALLOCATIONS is defined, the allocator is
+ * interposed, and the number of heap allocations between the start and
+ * stop of each repetition is reported too. The build system only enables
+ * it on glibc, and not when building with sanitizers, which interpose
+ * the allocator themselves.
+ */
+
+/* Events are spread over two years, starting on 2026-01-01 */
+#define DATASET_START_UNIX 1767225600
+#define DATASET_DAYS       730
+
+#define DEFAULT_SIZES      "1000,10000,100000"
+
+struct _GcalBenchmark
+{
+  const gchar        *name;
+  GcalBenchmarkFunc   func;
+
+  GRand              *rand;
+
+  gint64              start_time;
+  gint64              elapsed;
+  guint               n_operations;
+
+  gint                start_allocations;
+  gint                allocations;
+  gboolean            running;
+  gboolean            stopped;
+};
+
+static GPtrArray *benchmarks = NULL;
+static GcalCalendar *calendar = NULL;
+
+static gchar *sizes_option = NULL;
+static gchar *filter_option = NULL;
+static gchar *label_option = NULL;
+static gint repetitions_option = 5;
+static gint seed_option = 42;
+
+#ifdef GCAL_BENCHMARK_COUNT_ALLOCATIONS
+
+static gint n_allocations = 0;
+
+/*
+ * glibc exports the underlying implementation of the allocator, so
+ * this counts the allocations of every library loaded in the process.
+ */
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+extern void *__libc_memalign (size_t alignment, size_t size);
+
+void*
+malloc (size_t size)
+{
+  g_atomic_int_inc (&n_allocations);
+  return __libc_malloc (size);
+}
+
+void*
+calloc (size_t nmemb,
+        size_t size)
+{
+  g_atomic_int_inc (&n_allocations);
+  return __libc_calloc (nmemb, size);
+}
+
+void*
+realloc (void   *ptr,
+         size_t  size)
+{
+  g_atomic_int_inc (&n_allocations);
+  return __libc_realloc (ptr, size);
+}
+
+void*
+memalign (size_t alignment,
+          size_t size)
+{
+  g_atomic_int_inc (&n_allocations);
+  return __libc_memalign (alignment, size);
+}
+
+void*
+aligned_alloc (size_t alignment,
+               size_t size)
+{
+  g_atomic_int_inc (&n_allocations);
+  return __libc_memalign (alignment, size);
+}
+
+int
+posix_memalign (void   **memptr,
+                size_t   alignment,
+                size_t   size)
+{
+  void *ptr;
+
+  if (alignment % sizeof (void *) != 0 || (alignment & (alignment - 1)) != 0)
+    return EINVAL;
+
+  g_atomic_int_inc (&n_allocations);
+  ptr = __libc_memalign (alignment, size);
+
+  if (!ptr)
+    return ENOMEM;
+
+  *memptr = ptr;
+  return 0;
+}
+
+#endif
+
+static GOptionEntry entries[] = {
+  { "sizes", 's', 0, G_OPTION_ARG_STRING, &sizes_option, "Comma-separated dataset sizes (default: " DEFAULT_SIZES ")", "SIZES" },
+  { "filter", 'f', 0, G_OPTION_ARG_STRING, &filter_option, "Only run benchmarks whose name starts with PREFIX", "PREFIX" },
+  { "label", 'l', 0, G_OPTION_ARG_STRING, &label_option, "Label added to every result, e.g. a commit id", "LABEL" },
+  { "repetitions", 'r', 0, G_OPTION_ARG_INT, &repetitions_option, "Number of measured repetitions (default: 5)", "N" },
+  { "seed", 0, 0, G_OPTION_ARG_INT, &seed_option, "Seed of the synthetic datasets (default: 42)", "SEED" },
+  { NULL }
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static gint64
+get_time_ns (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+
+  return (gint64) ts.tv_sec * G_GINT64_CONSTANT (1000000000) + ts.tv_nsec;
+}
+
+static gint
+get_n_allocations (void)
+{
+#ifdef GCAL_BENCHMARK_COUNT_ALLOCATIONS
+  return g_atomic_int_get (&n_allocations);
+#else
+  return 0;
+#endif
+}
+
+static gint
+compare_int64 (gconstpointer a,
+               gconstpointer b)
+{
+  gint64 time_a = *((gint64 *) a);
+  gint64 time_b = *((gint64 *) b);
+
+  return (time_a > time_b) - (time_a < time_b);
+}
+
+static GArray*
+parse_sizes (const gchar *sizes)
+{
+  g_auto (GStrv) tokens = NULL;
+  GArray *result;
+
+  result = g_array_new (FALSE, FALSE, sizeof (guint));
+  tokens = g_strsplit (sizes, ",", -1);
+
+  for (gsize i = 0; tokens[i]; i++)
+    {
+      guint64 value;
+      guint size;
+
+      if (!g_ascii_string_to_unsigned (g_strstrip (tokens[i]), 10, 1, G_MAXUINT, &value, NULL))
+        g_error ("Invalid dataset size: %s", tokens[i]);
+
+      size = (guint) value;
+      g_array_append_val (result, size);
+    }
+
+  return result;
+}
+
+static GDateTime*
+dataset_date_time_new (gint64 day,
+                       gint64 minute)
+{
+  return g_date_time_new_from_unix_utc (DATASET_START_UNIX + day * 86400 + minute * 60);
+}
+
+static void
+run_benchmark (GcalBenchmark *benchmark,
+               guint          n_events)
+{
+  g_autofree gchar *escaped_label = NULL;
+  g_autofree gchar *allocations_per_operation = NULL;
+  g_autoptr (GArray) times = NULL;
+  gint min_allocations;
+  gint64 median;
+  gint64 min;
+
+  times = g_array_sized_new (FALSE, FALSE, sizeof (gint64), repetitions_option);
+  min_allocations = G_MAXINT;
+
+  /* The first run only warms up caches and allocators */
+  for (gint i = -1; i < repetitions_option; i++)
+    {
+      g_rand_set_seed (benchmark->rand, (guint32) seed_option ^ n_events);
+
+      benchmark->running = FALSE;
+      benchmark->stopped = FALSE;
+      benchmark->func (benchmark, n_events);
+
+      if (!benchmark->stopped)
+        g_error ("Benchmark %s didn't call gcal_benchmark_stop()", benchmark->name);
+
+      if (i >= 0)
+        {
+          g_array_append_val (times, benchmark->elapsed);
+          min_allocations = MIN (min_allocations, benchmark->allocations);
+        }
+    }
+
+  g_array_sort (times, compare_int64);
+  min = g_array_index (times, gint64, 0);
+  median = g_array_index (times, gint64, times->len / 2);
+
+  escaped_label = g_strescape (label_option ? label_option : "", NULL);
+
+#ifdef GCAL_BENCHMARK_COUNT_ALLOCATIONS
+  allocations_per_operation = g_strdup_printf ("%.2f", benchmark->n_operations > 0 ? (gdouble) min_allocations / benchmark->n_operations : 0.0);
+#else
+  allocations_per_operation = g_strdup ("null");
+#endif
+
+  g_print ("{\"benchmark\": \"%s\", \"label\": \"%s\", \"n_events\": %u, \"n_operations\": %u, "
+           "\"repetitions\": %d, \"min_ns\": %" G_GINT64_FORMAT ", \"median_ns\": %" G_GINT64_FORMAT ", "
+           "\"ns_per_operation\": %.2f, \"allocations_per_operation\": %s}\n",
+           benchmark->name,
+           escaped_label,
+           n_events,
+           benchmark->n_operations,
+           repetitions_option,
+           min,
+           median,
+           benchmark->n_operations > 0 ? (gdouble) median / benchmark->n_operations : 0.0,
+           allocations_per_operation);
+
+  g_printerr ("%-40s %8u events %12.2f ns/op %10s allocs/op\n",
+              benchmark->name,
+              n_events,
+              benchmark->n_operations > 0 ? (gdouble) median / benchmark->n_operations : 0.0,
+              allocations_per_operation);
+}
+
+
+/*
+ * Public API
+ */
+
+/**
+ * gcal_benchmark_init:
+ * @argc: pointer to the number of command line arguments
+ * @argv: pointer to the command line arguments
+ *
+ * Parses the command line options, and prepares the harness.
+ */
+void
+gcal_benchmark_init (gint    *argc,
+                     gchar ***argv)
+{
+  g_autoptr (GOptionContext) context = NULL;
+  g_autoptr (GError) error = NULL;
+
+  g_setenv ("TZ", "UTC", TRUE);
+
+  context = g_option_context_new ("- run microbenchmarks");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, argc, argv, &error))
+    g_error ("Error parsing options: %s", error->message);
+
+  if (repetitions_option < 1)
+    g_error ("At least one repetition is necessary");
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+
+  if (error)
+    g_error ("Error creating calendar: %s", error->message);
+
+  benchmarks = g_ptr_array_new ();
+}
+
+/**
+ * gcal_benchmark_add:
+ * @name: the name of the benchmark, e.g. "/range-tree/insert"
+ * @func: the function running the benchmark
+ *
+ * Registers a benchmark.
+ */
+void
+gcal_benchmark_add (const gchar       *name,
+                    GcalBenchmarkFunc  func)
+{
+  GcalBenchmark *benchmark;
+
+  g_assert (benchmarks != NULL);
+
+  benchmark = g_new0 (GcalBenchmark, 1);
+  benchmark->name = name;
+  benchmark->func = func;
+  benchmark->rand = g_rand_new_with_seed (seed_option);
+
+  g_ptr_array_add (benchmarks, benchmark);
+}
+
+/**
+ * gcal_benchmark_run:
+ *
+ * Runs all registered benchmarks matching the filter, on each
+ * dataset size.
+ *
+ * Returns: the exit status of the program
+ */
+gint
+gcal_benchmark_run (void)
+{
+  g_autoptr (GArray) sizes = NULL;
+
+  sizes = parse_sizes (sizes_option ? sizes_option : DEFAULT_SIZES);
+
+  for (guint i = 0; i < benchmarks->len; i++)
+    {
+      GcalBenchmark *benchmark = g_ptr_array_index (benchmarks, i);
+
+      if (filter_option && !g_str_has_prefix (benchmark->name, filter_option))
+        continue;
+
+      for (guint j = 0; j < sizes->len; j++)
+        run_benchmark (benchmark, g_array_index (sizes, guint, j));
+    }
+
+  for (guint i = 0; i < benchmarks->len; i++)
+    {
+      GcalBenchmark *benchmark = g_ptr_array_index (benchmarks, i);
+
+      g_clear_pointer (&benchmark->rand, g_rand_free);
+      g_free (benchmark);
+    }
+
+  g_clear_pointer (&benchmarks, g_ptr_array_unref);
+  g_clear_object (&calendar);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * gcal_benchmark_start:
+ * @benchmark: a #GcalBenchmark
+ *
+ * Starts measuring.
+ */
+void
+gcal_benchmark_start (GcalBenchmark *benchmark)
+{
+  g_assert (!benchmark->running);
+  g_assert (!benchmark->stopped);
+
+  benchmark->running = TRUE;
+  benchmark->start_allocations = get_n_allocations ();
+  benchmark->start_time = get_time_ns ();
+}
+
+/**
+ * gcal_benchmark_stop:
+ * @benchmark: a #GcalBenchmark
+ * @n_operations: the number of operations performed since
+ *   gcal_benchmark_start()
+ *
+ * Stops measuring. Allocations made by @benchmark after this call,
+ * e.g. while freeing the dataset, are not counted.
+ */
+void
+gcal_benchmark_stop (GcalBenchmark *benchmark,
+                     guint          n_operations)
+{
+  gint64 end_time = get_time_ns ();
+  gint end_allocations = get_n_allocations ();
+
+  g_assert (benchmark->running);
+
+  benchmark->elapsed = end_time - benchmark->start_time;
+  benchmark->allocations = end_allocations - benchmark->start_allocations;
+  benchmark->n_operations = n_operations;
+  benchmark->running = FALSE;
+  benchmark->stopped = TRUE;
+}
+
+/**
+ * gcal_benchmark_get_rand:
+ * @benchmark: a #GcalBenchmark
+ *
+ * Retrieves the random number generator of @benchmark. It is
+ * reseeded before each repetition.
+ *
+ * Returns: (transfer none): a #GRand
+ */
+GRand*
+gcal_benchmark_get_rand (GcalBenchmark *benchmark)
+{
+  return benchmark->rand;
+}
+
+/**
+ * gcal_benchmark_get_calendar:
+ * @benchmark: a #GcalBenchmark
+ *
+ * Retrieves the calendar that generated events belong to.
+ *
+ * Returns: (transfer none): a #GcalCalendar
+ */
+GcalCalendar*
+gcal_benchmark_get_calendar (GcalBenchmark *benchmark)
+{
+  return calendar;
+}
+
+/**
+ * gcal_benchmark_generate_event_string:
+ * @benchmark: a #GcalBenchmark
+ * @index: the index of the event in the dataset
+ *
+ * Generates a random VEVENT. Roughly 10% of the events are all-day
+ * events, 5% are timed events spanning multiple days, and the rest
+ * are timed events lasting up to 4 hours.
+ *
+ * Returns: (transfer full): a VEVENT string
+ */
+gchar*
+gcal_benchmark_generate_event_string (GcalBenchmark *benchmark,
+                                      guint          index)
+{
+  g_autoptr (GDateTime) last_modified = NULL;
+  g_autoptr (GDateTime) start = NULL;
+  g_autoptr (GDateTime) end = NULL;
+  g_autofree gchar *last_modified_str = NULL;
+  g_autofree gchar *dtstart = NULL;
+  g_autofree gchar *dtend = NULL;
+  gint64 start_day;
+  gint64 start_minute;
+  gint kind;
+
+  start_day = g_rand_int_range (benchmark->rand, 0, DATASET_DAYS);
+  kind = g_rand_int_range (benchmark->rand, 0, 100);
+
+  if (kind < 10)
+    {
+      start = dataset_date_time_new (start_day, 0);
+      end = g_date_time_add_days (start, g_rand_int_range (benchmark->rand, 1, 4));
+
+      dtstart = g_date_time_format (start, "DTSTART;VALUE=DATE:%Y%m%d");
+      dtend = g_date_time_format (end, "DTEND;VALUE=DATE:%Y%m%d");
+    }
+  else
+    {
+      gint64 duration_minutes;
+
+      start_minute = g_rand_int_range (benchmark->rand, 0, 96) * 15;
+
+      if (kind < 15)
+        duration_minutes = g_rand_int_range (benchmark->rand, 1, 4) * 24 * 60;
+      else
+        duration_minutes = g_rand_int_range (benchmark->rand, 1, 17) * 15;
+
+      start = dataset_date_time_new (start_day, start_minute);
+      end = g_date_time_add_minutes (start, duration_minutes);
+
+      dtstart = g_date_time_format (start, "DTSTART:%Y%m%dT%H%M%SZ");
+      dtend = g_date_time_format (end, "DTEND:%Y%m%dT%H%M%SZ");
+    }
+
+  last_modified = dataset_date_time_new (-g_rand_int_range (benchmark->rand, 1, 365), 0);
+  last_modified_str = g_date_time_format (last_modified, "%Y%m%dT%H%M%SZ");
+
+  return g_strdup_printf ("BEGIN:VEVENT\n"
+                          "UID:benchmark-%u@gnome-calendar\n"
+                          "DTSTAMP:20260101T000000Z\n"
+                          "LAST-MODIFIED:%s\n"
+                          "SUMMARY:Event %u\n"
+                          "LOCATION:Room %u\n"
+                          "%s\n"
+                          "%s\n"
+                          "END:VEVENT\n",
+                          index,
+                          last_modified_str,
+                          index % 100,
+                          index % 10,
+                          dtstart,
+                          dtend);
+}
+
+/**
+ * gcal_benchmark_generate_components:
+ * @benchmark: a #GcalBenchmark
+ * @n_events: the number of components to generate
+ *
+ * Generates @n_events random components.
+ *
+ * Returns: (transfer full)(element-type ECalComponent): the components
+ */
+GPtrArray*
+gcal_benchmark_generate_components (GcalBenchmark *benchmark,
+                                    guint          n_events)
+{
+  GPtrArray *components;
+
+  components = g_ptr_array_new_full (n_events, g_object_unref);
+
+  for (guint i = 0; i < n_events; i++)
+    {
+      g_autofree gchar *string = NULL;
+      ECalComponent *component;
+
+      string = gcal_benchmark_generate_event_string (benchmark, i);
+      component = e_cal_component_new_from_string (string);
+
+      if (!component)
+        g_error ("Error parsing generated component:\n%s", string);
+
+      g_ptr_array_add (components, component);
+    }
+
+  return components;
+}
+
+/**
+ * gcal_benchmark_generate_events:
+ * @benchmark: a #GcalBenchmark
+ * @n_events: the number of events to generate
+ *
+ * Generates @n_events random events. The returned array is
+ * %NULL-terminated, so that it can be passed as-is to the
+ * functions taking arrays of events.
+ *
+ * Returns: (transfer full)(element-type GcalEvent): the events
+ */
+GPtrArray*
+gcal_benchmark_generate_events (GcalBenchmark *benchmark,
+                                guint          n_events)
+{
+  g_autoptr (GPtrArray) components = NULL;
+  GPtrArray *events;
+
+  components = gcal_benchmark_generate_components (benchmark, n_events);
+  events = g_ptr_array_new_null_terminated (n_events, g_object_unref, TRUE);
+
+  for (guint i = 0; i < components->len; i++)
+    {
+      g_autoptr (GError) error = NULL;
+      GcalEvent *event;
+
+      event = gcal_event_new_take (calendar, g_object_ref (g_ptr_array_index (components, i)), &error);
+
+      if (error)
+        g_error ("Error creating event: %s", error->message);
+
+      g_ptr_array_add (events, event);
+    }
+
+  return events;
+}
+
+/**
+ * gcal_benchmark_generate_range:
+ * @benchmark: a #GcalBenchmark
+ * @max_duration: the maximum duration of the range
+ *
+ * Generates a random range within the dataset, lasting at least
+ * one hour, and at most @max_duration.
+ *
+ * Returns: (transfer full): a #GcalRange
+ */
+GcalRange*
+gcal_benchmark_generate_range (GcalBenchmark *benchmark,
+                               GTimeSpan      max_duration)
+{
+  GDateTime *start;
+  GDateTime *end;
+  gint64 duration_minutes;
+
+  g_assert (max_duration >= G_TIME_SPAN_HOUR);
+
+  duration_minutes = g_rand_int_range (benchmark->rand, 60, max_duration / G_TIME_SPAN_MINUTE + 1);
+
+  start = dataset_date_time_new (g_rand_int_range (benchmark->rand, 0, DATASET_DAYS),
+                                 g_rand_int_range (benchmark->rand, 0, 24 * 60));
+  end = g_date_time_add_minutes (start, duration_minutes);
+
+  return gcal_range_new_take (start, end, GCAL_RANGE_DEFAULT);
+}
@@ -0,0 +1,73 @@
+/* gcal-benchmark.h
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <libecal/libecal.h>
+
+#include "gcal-calendar.h"
+#include "gcal-range.h"
+
+G_BEGIN_DECLS
+
+typedef struct _GcalBenchmark GcalBenchmark;
+
+/**
+ * GcalBenchmarkFunc:
+ * @benchmark: a #GcalBenchmark
+ * @n_events: the size of the dataset
+ *
+ * Runs one repetition of a benchmark. Setup and teardown happen
+ * outside of the gcal_benchmark_start() and gcal_benchmark_stop()
+ * calls, and are not measured.
+ */
+typedef void         (*GcalBenchmarkFunc)                        (GcalBenchmark      *benchmark,
+                                                                  guint               n_events);
+
+void                 gcal_benchmark_init                         (gint               *argc,
+                                                                  gchar            ***argv);
+
+void                 gcal_benchmark_add                          (const gchar        *name,
+                                                                  GcalBenchmarkFunc   func);
+
+gint                 gcal_benchmark_run                          (void);
+
+void                 gcal_benchmark_start                        (GcalBenchmark      *benchmark);
+
+void                 gcal_benchmark_stop                         (GcalBenchmark      *benchmark,
+                                                                  guint               n_operations);
+
+GRand*               gcal_benchmark_get_rand                     (GcalBenchmark      *benchmark);
+
+GcalCalendar*        gcal_benchmark_get_calendar                 (GcalBenchmark      *benchmark);
+
+gchar*               gcal_benchmark_generate_event_string        (GcalBenchmark      *benchmark,
+                                                                  guint               index);
+
+GPtrArray*           gcal_benchmark_generate_components          (GcalBenchmark      *benchmark,
+                                                                  guint               n_events);
+
+GPtrArray*           gcal_benchmark_generate_events              (GcalBenchmark      *benchmark,
+                                                                  guint               n_events);
+
+GcalRange*           gcal_benchmark_generate_range               (GcalBenchmark      *benchmark,
+                                                                  GTimeSpan           max_duration);
+
+G_END_DECLS
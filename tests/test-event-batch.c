@@ -0,0 +1,241 @@
+/* test-event-batch.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <glib.h>
+
+#include "gcal-event.h"
+#include "gcal-event-batch.h"
+#include "gcal-stub-calendar.h"
+
+#define STUB_INSTANCE "BEGIN:VEVENT\n"                        \
+                      "SUMMARY:Stub series\n"                 \
+                      "UID:series@uid\n"                      \
+                      "DTSTAMP:19970114T170000Z\n"            \
+                      "DTSTART:201807%02dT170000Z\n"          \
+                      "DTEND:201807%02dT180000Z\n"            \
+                      "RRULE:FREQ=DAILY;COUNT=5\n"            \
+                      "RECURRENCE-ID:201807%02dT170000Z\n"    \
+                      "END:VEVENT\n"
+
+#define STUB_EVENT "BEGIN:VEVENT\n"             \
+                   "SUMMARY:Stub event\n"       \
+                   "UID:event-%u@uid\n"         \
+                   "DTSTAMP:19970114T170000Z\n" \
+                   "DTSTART:20180714T170000Z\n" \
+                   "DTEND:20180714T180000Z\n"   \
+                   "END:VEVENT\n"
+
+static GcalEvent*
+create_event_for_string (GcalCalendar *calendar,
+                         const gchar  *string)
+{
+  g_autoptr (ECalComponent) component = NULL;
+  g_autoptr (GError) error = NULL;
+  GcalEvent *event;
+
+  component = e_cal_component_new_from_string (string);
+  g_assert_nonnull (component);
+
+  event = gcal_event_new (calendar, component, &error);
+  g_assert_no_error (error);
+
+  return event;
+}
+
+static GcalEvent*
+create_instance (GcalCalendar *calendar,
+                 gint          day)
+{
+  g_autofree gchar *string = g_strdup_printf (STUB_INSTANCE, day, day, day);
+
+  return create_event_for_string (calendar, string);
+}
+
+static GcalEvent*
+create_event (GcalCalendar *calendar,
+              guint         n)
+{
+  g_autofree gchar *string = g_strdup_printf (STUB_EVENT, n);
+
+  return create_event_for_string (calendar, string);
+}
+
+static GPtrArray*
+create_series_and_event (GcalCalendar *calendar)
+{
+  GPtrArray *events;
+
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+  g_ptr_array_add (events, create_instance (calendar, 14));
+  g_ptr_array_add (events, create_instance (calendar, 15));
+  g_ptr_array_add (events, create_instance (calendar, 16));
+  g_ptr_array_add (events, create_event (calendar, 0));
+
+  return events;
+}
+
+/*********************************************************************************************************************/
+
+static void
+event_batch_remove_series (void)
+{
+  g_autoptr (GcalEventBatch) batch = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  g_autoptr (GError) error = NULL;
+  GSList *ids;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  events = create_series_and_event (calendar);
+
+  /* All instances of the series are the same object */
+  batch = gcal_event_batch_new (events, GCAL_RECURRENCE_MOD_ALL, NULL);
+  g_assert_cmpuint (gcal_event_batch_get_n_events (batch), ==, 2);
+
+  g_assert_true (gcal_event_batch_next_chunk (batch));
+  g_assert_true (gcal_event_batch_get_chunk_calendar (batch) == calendar);
+
+  ids = gcal_event_batch_get_chunk_ids (batch, GCAL_RECURRENCE_MOD_ALL);
+  g_assert_cmpuint (g_slist_length (ids), ==, 2);
+  g_assert_cmpstr (e_cal_component_id_get_uid (ids->data), ==, "series@uid");
+  g_assert_null (e_cal_component_id_get_rid (ids->data));
+  g_assert_cmpstr (e_cal_component_id_get_uid (ids->next->data), ==, "event-0@uid");
+  g_assert_null (e_cal_component_id_get_rid (ids->next->data));
+  g_slist_free_full (ids, (GDestroyNotify) e_cal_component_id_free);
+
+  g_assert_false (gcal_event_batch_next_chunk (batch));
+  g_clear_pointer (&batch, gcal_event_batch_free);
+
+  /* Each instance is removed on its own */
+  batch = gcal_event_batch_new (events, GCAL_RECURRENCE_MOD_THIS_ONLY, NULL);
+  g_assert_cmpuint (gcal_event_batch_get_n_events (batch), ==, 4);
+
+  g_assert_true (gcal_event_batch_next_chunk (batch));
+
+  ids = gcal_event_batch_get_chunk_ids (batch, GCAL_RECURRENCE_MOD_THIS_ONLY);
+  g_assert_cmpuint (g_slist_length (ids), ==, 4);
+  g_assert_nonnull (e_cal_component_id_get_rid (ids->data));
+  g_assert_cmpstr (e_cal_component_id_get_rid (ids->data), !=, e_cal_component_id_get_rid (ids->next->data));
+  g_slist_free_full (ids, (GDestroyNotify) e_cal_component_id_free);
+
+  g_assert_false (gcal_event_batch_next_chunk (batch));
+}
+
+/*********************************************************************************************************************/
+
+static void
+event_batch_move (void)
+{
+  g_autoptr (GcalEventBatch) batch = NULL;
+  g_autoptr (GcalCalendar) destination = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  g_autoptr (GError) error = NULL;
+  GSList *components;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  destination = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+  g_ptr_array_add (events, create_event (calendar, 0));
+  g_ptr_array_add (events, create_event (destination, 1));
+  g_ptr_array_add (events, create_event (calendar, 2));
+
+  /* Events already in the destination are not copied, nor removed */
+  batch = gcal_event_batch_new (events, GCAL_RECURRENCE_MOD_THIS_ONLY, destination);
+  g_assert_cmpuint (gcal_event_batch_get_n_events (batch), ==, 2);
+
+  g_assert_true (gcal_event_batch_next_chunk (batch));
+  g_assert_true (gcal_event_batch_get_chunk_calendar (batch) == calendar);
+  g_assert_cmpuint (gcal_event_batch_get_chunk_n_events (batch), ==, 2);
+
+  components = gcal_event_batch_get_chunk_components (batch);
+  g_assert_cmpuint (g_slist_length (components), ==, 2);
+  g_assert_cmpstr (i_cal_component_get_uid (components->data), ==, "event-0@uid");
+  g_assert_cmpstr (i_cal_component_get_uid (components->next->data), ==, "event-2@uid");
+  g_slist_free (components);
+
+  g_assert_false (gcal_event_batch_next_chunk (batch));
+  g_clear_pointer (&batch, gcal_event_batch_free);
+
+  /* Nothing to do when everything is in the destination already */
+  g_ptr_array_remove_index (events, 2);
+  g_ptr_array_remove_index (events, 0);
+
+  batch = gcal_event_batch_new (events, GCAL_RECURRENCE_MOD_THIS_ONLY, destination);
+  g_assert_cmpuint (gcal_event_batch_get_n_events (batch), ==, 0);
+  g_assert_false (gcal_event_batch_next_chunk (batch));
+}
+
+/*********************************************************************************************************************/
+
+static void
+event_batch_chunks (void)
+{
+  g_autoptr (GcalEventBatch) batch = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  g_autoptr (GError) error = NULL;
+  guint n_events = GCAL_EVENT_BATCH_CHUNK_SIZE * 2 + GCAL_EVENT_BATCH_CHUNK_SIZE / 2;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (guint i = 0; i < n_events; i++)
+    g_ptr_array_add (events, create_event (calendar, i));
+
+  batch = gcal_event_batch_new (events, GCAL_RECURRENCE_MOD_ALL, NULL);
+  g_assert_cmpuint (gcal_event_batch_get_n_events (batch), ==, n_events);
+
+  g_assert_true (gcal_event_batch_next_chunk (batch));
+  g_assert_cmpuint (gcal_event_batch_get_chunk_n_events (batch), ==, GCAL_EVENT_BATCH_CHUNK_SIZE);
+
+  g_assert_true (gcal_event_batch_next_chunk (batch));
+  g_assert_cmpuint (gcal_event_batch_get_chunk_n_events (batch), ==, GCAL_EVENT_BATCH_CHUNK_SIZE);
+
+  g_assert_true (gcal_event_batch_next_chunk (batch));
+  g_assert_cmpuint (gcal_event_batch_get_chunk_n_events (batch), ==, GCAL_EVENT_BATCH_CHUNK_SIZE / 2);
+
+  g_assert_false (gcal_event_batch_next_chunk (batch));
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_setenv ("TZ", "UTC", TRUE);
+
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/event-batch/remove-series", event_batch_remove_series);
+  g_test_add_func ("/event-batch/move", event_batch_move);
+  g_test_add_func ("/event-batch/chunks", event_batch_chunks);
+
+  return g_test_run ();
+}
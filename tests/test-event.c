@@ -17,6 +17,7 @@
  */
 
 #include <glib.h>
+#include <string.h>
 
 #include "gcal-event-attendee.h"
 #include "gcal-event-organizer.h"
@@ -119,6 +120,37 @@ event_new (void)
 
 /*********************************************************************************************************************/
 
+static void
+event_new_take (void)
+{
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GcalEvent) expected = NULL;
+  g_autoptr (GcalEvent) event = NULL;
+  g_autoptr (GError) error = NULL;
+  ECalComponent *component;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  expected = create_event_for_string (STUB_EVENT, &error);
+  g_assert_no_error (error);
+
+  component = e_cal_component_new_from_string (STUB_EVENT);
+  event = gcal_event_new_take (calendar, component, &error);
+
+  g_assert_no_error (error);
+  g_assert_nonnull (event);
+  g_assert_true (gcal_event_get_component (event) == component);
+  g_assert_cmpstr (gcal_event_get_uid (event), ==, gcal_event_get_uid (expected));
+  g_assert_cmpstr (gcal_event_get_summary (event), ==, gcal_event_get_summary (expected));
+  g_assert_true (g_date_time_equal (gcal_event_get_date_start (event), gcal_event_get_date_start (expected)));
+  g_assert_true (g_date_time_equal (gcal_event_get_date_end (event), gcal_event_get_date_end (expected)));
+}
+
+/*********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+
 static void
 event_clone (void)
 {
@@ -168,6 +200,29 @@ event_summary (void)
 
 /*********************************************************************************************************************/
 
+static void
+event_shared_strings (void)
+{
+  g_autoptr (GcalEvent) event1 = NULL;
+  g_autoptr (GcalEvent) event2 = NULL;
+
+  event1 = create_event_for_string (STUB_EVENT, NULL);
+  event2 = create_event_for_string (STUB_EVENT, NULL);
+
+  /* Summaries and locations are interned */
+  g_assert_true (gcal_event_get_summary (event1) == gcal_event_get_summary (event2));
+  g_assert_true (gcal_event_get_location (event1) == gcal_event_get_location (event2));
+
+  gcal_event_set_summary (event2, "Another summary");
+  g_assert_cmpstr (gcal_event_get_summary (event1), ==, "Stub event");
+  g_assert_cmpstr (gcal_event_get_summary (event2), ==, "Another summary");
+
+  g_assert_true (gcal_event_get_uid_ref (event1) == (GRefString *) gcal_event_get_uid (event1));
+  g_assert_cmpuint (gcal_event_get_memory_size (event1), >, strlen (gcal_event_get_uid (event1)));
+}
+
+/*********************************************************************************************************************/
+
 static void
 event_no_dtend (void)
 {
@@ -312,6 +367,48 @@ event_date_multiday (void)
 
 /*********************************************************************************************************************/
 
+static void
+event_date_local_days (void)
+{
+  struct {
+    const gchar *string;
+    const gchar *first_day;
+    const gchar *last_day;
+    gboolean multiday;
+  } events[] = {
+    { EVENT_STRING_FOR_DATE (":20160229T000000Z", ":20160302T000001Z"), "2016-02-29T00:00:00Z", "2016-03-02T00:00:00Z", TRUE },
+    { EVENT_STRING_FOR_DATE (":20160229T020000Z", ":20160301T000000Z"), "2016-02-29T00:00:00Z", "2016-02-29T00:00:00Z", FALSE },
+    { EVENT_STRING_FOR_DATE (";VALUE=DATE:20160229", ";VALUE=DATE:20160301"), "2016-02-29T00:00:00Z", "2016-02-29T00:00:00Z", FALSE },
+    { EVENT_STRING_FOR_DATE (";VALUE=DATE:20160229", ";VALUE=DATE:20160303"), "2016-02-29T00:00:00Z", "2016-03-02T00:00:00Z", TRUE },
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (events); i++)
+    {
+      g_autoptr (GDateTime) first_day = NULL;
+      g_autoptr (GDateTime) last_day = NULL;
+      g_autoptr (GcalEvent) event = NULL;
+      g_autoptr (GError) error = NULL;
+      gint64 first, last;
+
+      event = create_event_for_string (events[i].string, &error);
+      g_assert_no_error (error);
+
+      first_day = g_date_time_new_from_iso8601 (events[i].first_day, NULL);
+      last_day = g_date_time_new_from_iso8601 (events[i].last_day, NULL);
+
+      gcal_event_get_local_days (event, &first, &last);
+      g_assert_cmpint (first, ==, gcal_date_time_get_julian_day (first_day));
+      g_assert_cmpint (last, ==, gcal_date_time_get_julian_day (last_day));
+      g_assert_cmpint (gcal_event_is_multiday (event), ==, events[i].multiday);
+
+      g_assert_cmpint (gcal_event_get_start_unix (event), ==, g_date_time_to_unix (gcal_event_get_date_start (event)));
+      g_assert_cmpint (gcal_event_get_end_unix (event), ==, g_date_time_to_unix (gcal_event_get_date_end (event)));
+    }
+}
+
+/*********************************************************************************************************************/
+
 static void
 event_date_create_tzid (void)
 {
@@ -454,6 +551,41 @@ event_get_attendees (void)
 
 /*********************************************************************************************************************/
 
+static gpointer
+decode_fields_thread_func (gpointer data)
+{
+  GcalEvent *event = data;
+
+  g_assert_cmpstr (gcal_event_get_description (event), ==, "Discuss project updates and next steps.");
+  g_assert_cmpuint (g_list_model_get_n_items (gcal_event_get_attendees (event)), ==, 2);
+  g_assert_nonnull (gcal_event_get_organizer (event));
+
+  return gcal_event_get_organizer (event);
+}
+
+static void
+event_decode_fields_concurrently (void)
+{
+  g_autoptr (GcalEvent) event = NULL;
+  g_autoptr (GError) error = NULL;
+  GThread *threads[8];
+  gpointer organizer;
+  guint i;
+
+  event = create_event_for_string (STUB_EVENT_WITH_ATTENDEES, &error);
+  g_assert_no_error (error);
+
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("decode", decode_fields_thread_func, event);
+
+  /* All threads must see the same, singly decoded, organizer */
+  organizer = gcal_event_get_organizer (event);
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_assert_true (g_thread_join (threads[i]) == organizer);
+}
+
+/*********************************************************************************************************************/
+
 static GDateTime *
 dt_add_second_random (GDateTime *dt)
 {
@@ -584,17 +716,21 @@ main (gint   argc,
   g_test_bug_base ("https://gitlab.gnome.org/GNOME/gnome-calendar/-/issues/");
 
   g_test_add_func ("/event/new", event_new);
+  g_test_add_func ("/event/new-take", event_new_take);
   g_test_add_func ("/event/clone", event_clone);
   g_test_add_func ("/event/uid", event_uid);
   g_test_add_func ("/event/summary", event_summary);
+  g_test_add_func ("/event/shared-strings", event_shared_strings);
   g_test_add_func ("/event/nodtend", event_no_dtend);
   g_test_add_func ("/event/date/start", event_date_start);
   g_test_add_func ("/event/date/end", event_date_end);
   g_test_add_func ("/event/date/singleday", event_date_singleday);
   g_test_add_func ("/event/date/multiday", event_date_multiday);
+  g_test_add_func ("/event/date/local-days", event_date_local_days);
   g_test_add_func ("/event/date/create-tzid", event_date_create_tzid);
   g_test_add_func ("/event/date/check-tz", event_date_check_tz);
   g_test_add_func ("/event/date/get-attendees", event_get_attendees);
+  g_test_add_func ("/event/decode-fields-concurrently", event_decode_fields_concurrently);
   g_test_add_func ("/event/equal/schedule", event_schedule_equal);
 
   return g_test_run ();
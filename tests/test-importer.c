@@ -0,0 +1,265 @@
+/* test-importer.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "gcal-importer.h"
+
+#define STUB_CALENDAR "BEGIN:VCALENDAR\r\n"                           \
+                      "VERSION:2.0\r\n"                               \
+                      "PRODID:-//GNOME//Calendar Tests//EN\r\n"       \
+                      "BEGIN:VTIMEZONE\r\n"                           \
+                      "TZID:Test/Zone\r\n"                            \
+                      "BEGIN:STANDARD\r\n"                            \
+                      "DTSTART:19700101T000000\r\n"                   \
+                      "TZOFFSETFROM:+0100\r\n"                        \
+                      "TZOFFSETTO:+0100\r\n"                          \
+                      "END:STANDARD\r\n"                              \
+                      "END:VTIMEZONE\r\n"                             \
+                      "BEGIN:VEVENT\r\n"                              \
+                      "UID:first@uid\r\n"                             \
+                      "SUMMARY:A very long summary that is folded \r\n" \
+                      " across two lines\r\n"                         \
+                      "DTSTART;TZID=Test/Zone:20180714T170000\r\n"    \
+                      "DTEND;TZID=Test/Zone:20180714T180000\r\n"      \
+                      "BEGIN:VALARM\r\n"                              \
+                      "ACTION:DISPLAY\r\n"                            \
+                      "TRIGGER:-PT15M\r\n"                            \
+                      "END:VALARM\r\n"                                \
+                      "END:VEVENT\r\n"                                \
+                      "BEGIN:VEVENT\r\n"                              \
+                      "UID:second@uid\r\n"                            \
+                      "SUMMARY:Second event\r\n"                      \
+                      "DTSTART;VALUE=DATE:20180716\r\n"               \
+                      "DTEND;VALUE=DATE:20180717\r\n"                 \
+                      "END:VEVENT\r\n"                                \
+                      "END:VCALENDAR\r\n"
+
+typedef struct
+{
+  GMainLoop          *mainloop;
+  GPtrArray          *components;
+  GPtrArray          *timezones;
+  GError             *error;
+} ImportResult;
+
+static void
+components_parsed_cb (GPtrArray *components,
+                      gdouble    fraction,
+                      gpointer   user_data)
+{
+  ImportResult *result = user_data;
+
+  g_assert_null (result->timezones);
+  g_assert_cmpfloat (fraction, >=, 0.0);
+  g_assert_cmpfloat (fraction, <=, 1.0);
+
+  for (guint i = 0; i < components->len; i++)
+    g_ptr_array_add (result->components, g_object_ref (g_ptr_array_index (components, i)));
+}
+
+static void
+import_finished_cb (GObject      *source_object,
+                    GAsyncResult *res,
+                    gpointer      user_data)
+{
+  ImportResult *result = user_data;
+
+  result->timezones = gcal_importer_import_file_finish (res, &result->error);
+
+  g_main_loop_quit (result->mainloop);
+}
+
+static void
+import_contents (const gchar  *contents,
+                 ImportResult *result)
+{
+  g_autoptr (GFile) file = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *path = NULL;
+  gint fd;
+
+  fd = g_file_open_tmp ("test-importer-XXXXXX.ics", &path, &error);
+  g_assert_no_error (error);
+  g_close (fd, NULL);
+
+  g_file_set_contents (path, contents, -1, &error);
+  g_assert_no_error (error);
+
+  result->mainloop = g_main_loop_new (NULL, FALSE);
+  result->components = g_ptr_array_new_with_free_func (g_object_unref);
+
+  file = g_file_new_for_path (path);
+  gcal_importer_import_file (file, NULL, components_parsed_cb, result, import_finished_cb, result);
+
+  g_main_loop_run (result->mainloop);
+
+  g_unlink (path);
+}
+
+static void
+import_result_clear (ImportResult *result)
+{
+  g_clear_pointer (&result->mainloop, g_main_loop_unref);
+  g_clear_pointer (&result->components, g_ptr_array_unref);
+  g_clear_pointer (&result->timezones, g_ptr_array_unref);
+  g_clear_error (&result->error);
+}
+
+/*********************************************************************************************************************/
+
+static void
+importer_stream (void)
+{
+  g_autoptr (ICalComponent) alarm = NULL;
+  ImportResult result = { NULL, };
+  ICalComponent *component;
+
+  import_contents (STUB_CALENDAR, &result);
+
+  g_assert_no_error (result.error);
+  g_assert_nonnull (result.timezones);
+  g_assert_cmpuint (result.timezones->len, ==, 1);
+  g_assert_cmpstr (i_cal_timezone_get_tzid (g_ptr_array_index (result.timezones, 0)), ==, "Test/Zone");
+
+  g_assert_cmpuint (result.components->len, ==, 2);
+
+  component = g_ptr_array_index (result.components, 0);
+  g_assert_cmpint (i_cal_component_isa (component), ==, I_CAL_VEVENT_COMPONENT);
+  g_assert_cmpstr (i_cal_component_get_uid (component), ==, "first@uid");
+  g_assert_cmpstr (i_cal_component_get_summary (component), ==, "A very long summary that is folded across two lines");
+
+  alarm = i_cal_component_get_first_component (component, I_CAL_VALARM_COMPONENT);
+  g_assert_nonnull (alarm);
+
+  component = g_ptr_array_index (result.components, 1);
+  g_assert_cmpstr (i_cal_component_get_uid (component), ==, "second@uid");
+
+  import_result_clear (&result);
+}
+
+/*********************************************************************************************************************/
+
+static void
+importer_malformed (void)
+{
+  ImportResult result = { NULL, };
+
+  import_contents ("BEGIN:VCALENDAR\r\nVERSION:2.0\r\nEND:VCALENDAR\r\n", &result);
+
+  g_assert_error (result.error, I_CAL_ERROR, I_CAL_MALFORMEDDATA_ERROR);
+  g_assert_null (result.timezones);
+  g_assert_cmpuint (result.components->len, ==, 0);
+
+  import_result_clear (&result);
+}
+
+/*********************************************************************************************************************/
+
+static ICalComponent*
+create_component (const gchar *uid,
+                  const gchar *recurrence_id,
+                  gint         sequence,
+                  const gchar *last_modified)
+{
+  g_autoptr (GString) string = NULL;
+
+  string = g_string_new ("BEGIN:VEVENT\r\n");
+  g_string_append_printf (string, "UID:%s\r\n", uid);
+  g_string_append_printf (string, "SEQUENCE:%d\r\n", sequence);
+  g_string_append (string, "DTSTART:20180714T170000Z\r\n");
+
+  if (recurrence_id)
+    g_string_append_printf (string, "RECURRENCE-ID:%s\r\n", recurrence_id);
+
+  if (last_modified)
+    g_string_append_printf (string, "LAST-MODIFIED:%s\r\n", last_modified);
+
+  g_string_append (string, "END:VEVENT\r\n");
+
+  return i_cal_component_new_from_string (string->str);
+}
+
+static void
+check_classify (GcalImportIndex  *index,
+                const gchar      *uid,
+                const gchar      *recurrence_id,
+                gint              sequence,
+                const gchar      *last_modified,
+                GcalImportAction  expected)
+{
+  g_autoptr (ICalComponent) component = NULL;
+
+  component = create_component (uid, recurrence_id, sequence, last_modified);
+  g_assert_nonnull (component);
+
+  g_assert_cmpint (gcal_import_index_classify (index, component), ==, expected);
+}
+
+static void
+importer_classify (void)
+{
+  g_autoptr (GcalImportIndex) index = NULL;
+  g_autoptr (ICalComponent) existing = NULL;
+  g_autoptr (ICalComponent) instance = NULL;
+
+  index = gcal_import_index_new ();
+
+  existing = create_component ("event@uid", NULL, 1, "20180101T000000Z");
+  gcal_import_index_add (index, existing);
+
+  instance = create_component ("event@uid", "20180721T170000Z", 0, NULL);
+  gcal_import_index_add (index, instance);
+
+  /* New */
+  check_classify (index, "other@uid", NULL, 0, NULL, GCAL_IMPORT_ACTION_CREATE);
+
+  /* Identical, or older */
+  check_classify (index, "event@uid", NULL, 1, "20180101T000000Z", GCAL_IMPORT_ACTION_SKIP);
+  check_classify (index, "event@uid", NULL, 0, "20190101T000000Z", GCAL_IMPORT_ACTION_SKIP);
+  check_classify (index, "event@uid", NULL, 1, "20170101T000000Z", GCAL_IMPORT_ACTION_SKIP);
+  check_classify (index, "event@uid", "20180721T170000Z", 0, NULL, GCAL_IMPORT_ACTION_SKIP);
+
+  /* Newer */
+  check_classify (index, "event@uid", NULL, 2, NULL, GCAL_IMPORT_ACTION_MODIFY);
+  check_classify (index, "event@uid", NULL, 1, "20190101T000000Z", GCAL_IMPORT_ACTION_MODIFY);
+  check_classify (index, "event@uid", "20180721T170000Z", 1, NULL, GCAL_IMPORT_ACTION_MODIFY);
+
+  /* New detached instance of an existing event */
+  check_classify (index, "event@uid", "20180728T170000Z", 0, NULL, GCAL_IMPORT_ACTION_MODIFY);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_setenv ("TZ", "UTC", TRUE);
+
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/importer/stream", importer_stream);
+  g_test_add_func ("/importer/malformed", importer_malformed);
+  g_test_add_func ("/importer/classify", importer_classify);
+
+  return g_test_run ();
+}
@@ -293,6 +293,70 @@ range_compare (void)
 
 /*********************************************************************************************************************/
 
+static void
+assert_range_value_equal (const GcalRangeValue *a,
+                          const GcalRangeValue *b)
+{
+  g_assert_cmpint (a->start_unix, ==, b->start_unix);
+  g_assert_cmpint (a->end_unix, ==, b->end_unix);
+  g_assert_cmpint (a->start_date, ==, b->start_date);
+  g_assert_cmpint (a->end_date, ==, b->end_date);
+  g_assert_cmpint (a->range_type, ==, b->range_type);
+}
+
+static void
+range_value (void)
+{
+  g_autoptr (GTimeZone) utc = NULL;
+  gint i;
+
+  utc = g_time_zone_new_utc ();
+  for (i = 0; i < G_N_ELEMENTS (ranges); i++)
+    {
+      g_autoptr (GDateTime) second_start = NULL;
+      g_autoptr (GDateTime) second_end = NULL;
+      g_autoptr (GDateTime) first_start = NULL;
+      g_autoptr (GDateTime) first_end = NULL;
+      g_autoptr (GcalRange) range_a = NULL;
+      g_autoptr (GcalRange) range_b = NULL;
+      g_autoptr (GcalRange) range_union = NULL;
+      GcalRangeValue value_union;
+      GcalRangeValue value_a;
+      GcalRangeValue value_b;
+      GcalRangePosition position;
+      gboolean superset;
+
+      first_start = g_date_time_new_from_iso8601 (ranges[i].first.start, utc);
+      first_end = g_date_time_new_from_iso8601 (ranges[i].first.end, utc);
+      second_start = g_date_time_new_from_iso8601 (ranges[i].second.start, utc);
+      second_end = g_date_time_new_from_iso8601 (ranges[i].second.end, utc);
+
+      gcal_range_value_init (&value_a, first_start, first_end, GCAL_RANGE_DEFAULT);
+      gcal_range_value_init (&value_b, second_start, second_end, GCAL_RANGE_DEFAULT);
+
+      range_a = gcal_range_new (first_start, first_end, GCAL_RANGE_DEFAULT);
+      range_b = gcal_range_new (second_start, second_end, GCAL_RANGE_DEFAULT);
+      assert_range_value_equal (&value_a, gcal_range_get_value (range_a));
+
+      g_assert_cmpint (gcal_range_value_calculate_overlap (&value_a, &value_b, &position), ==, ranges[i].expected_overlap);
+      g_assert_cmpint (position, ==, ranges[i].expected_position);
+      g_assert_cmpint (gcal_range_value_compare (&value_a, &value_b), ==, ranges[i].expected_position);
+
+      g_assert_cmpint (gcal_range_value_overlaps (&value_a, &value_b), ==, ranges[i].expected_overlap != GCAL_RANGE_NO_OVERLAP);
+
+      superset = ranges[i].expected_overlap == GCAL_RANGE_SUPERSET || ranges[i].expected_overlap == GCAL_RANGE_EQUAL;
+      g_assert_cmpint (gcal_range_value_contains (&value_a, &value_b), ==, superset);
+
+      range_union = gcal_range_union (range_a, range_b);
+      gcal_range_value_union (&value_a, &value_b, &value_union);
+      assert_range_value_equal (&value_union, gcal_range_get_value (range_union));
+      g_assert_true (gcal_range_value_contains (&value_union, &value_a));
+      g_assert_true (gcal_range_value_contains (&value_union, &value_b));
+    }
+}
+
+/*********************************************************************************************************************/
+
 gint
 main (gint   argc,
       gchar *argv[])
@@ -306,6 +370,7 @@ main (gint   argc,
   g_test_add_func ("/range/compare", range_compare);
   g_test_add_func ("/range/calculate-overlap", range_calculate_overlap);
   g_test_add_func ("/range/calculate-overlap-date-only", range_calculate_overlap_date_only);
+  g_test_add_func ("/range/value", range_value);
 
   return g_test_run ();
 }
@@ -0,0 +1,225 @@
+/* test-timeline-snapshot.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "gcal-event.h"
+#include "gcal-stub-calendar.h"
+#include "gcal-timeline-snapshot.h"
+
+#define STUB_EVENT "BEGIN:VEVENT\n"             \
+                   "SUMMARY:Stub event\n"       \
+                   "UID:example@uid\n"          \
+                   "DTSTAMP:19970114T170000Z\n" \
+                   "DTSTART:20180714T170000Z\n" \
+                   "DTEND:20180715T035959Z\n"   \
+                   "END:VEVENT\n"
+
+#define STUB_EVENT_ALL_DAY "BEGIN:VEVENT\n"                \
+                           "SUMMARY:Stub all day\n"        \
+                           "UID:example@uid-all-day\n"     \
+                           "DTSTART;VALUE=DATE:20180716\n" \
+                           "DTEND;VALUE=DATE:20180717\n"   \
+                           "END:VEVENT\n"
+
+static GcalEvent*
+create_event_for_string (GcalCalendar *calendar,
+                         const gchar  *string)
+{
+  g_autoptr (ECalComponent) component = NULL;
+  g_autoptr (GError) error = NULL;
+  GcalEvent *event;
+
+  component = e_cal_component_new_from_string (string);
+  g_assert_nonnull (component);
+
+  event = gcal_event_new (calendar, component, &error);
+  g_assert_no_error (error);
+
+  return event;
+}
+
+static gchar*
+save_stub_snapshot (GcalCalendar *calendar)
+{
+  g_autoptr (GHashTable) revisions = NULL;
+  g_autoptr (GDateTime) range_start = NULL;
+  g_autoptr (GDateTime) range_end = NULL;
+  g_autoptr (GcalRange) range = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  g_autoptr (GError) error = NULL;
+  gchar *path;
+  gint fd;
+
+  fd = g_file_open_tmp ("test-timeline-snapshot-XXXXXX", &path, &error);
+  g_assert_no_error (error);
+  g_close (fd, NULL);
+
+  range_start = g_date_time_new_utc (2018, 7, 1, 0, 0, 0);
+  range_end = g_date_time_new_utc (2018, 8, 1, 0, 0, 0);
+  range = gcal_range_new (range_start, range_end, GCAL_RANGE_DEFAULT);
+
+  events = g_ptr_array_new_with_free_func (g_object_unref);
+  g_ptr_array_add (events, create_event_for_string (calendar, STUB_EVENT));
+  g_ptr_array_add (events, create_event_for_string (calendar, STUB_EVENT_ALL_DAY));
+
+  revisions = g_hash_table_new (g_str_hash, g_str_equal);
+  g_hash_table_insert (revisions, (gpointer) gcal_calendar_get_id (calendar), (gpointer) "rev1");
+
+  gcal_timeline_snapshot_save (path, range, revisions, events, &error);
+  g_assert_no_error (error);
+
+  return path;
+}
+
+/*********************************************************************************************************************/
+
+static void
+timeline_snapshot_round_trip (void)
+{
+  g_autoptr (GcalTimelineSnapshot) snapshot = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GDateTime) range_start = NULL;
+  g_autoptr (GDateTime) event_start = NULL;
+  g_autoptr (GcalRange) range = NULL;
+  g_autoptr (GPtrArray) events = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *path = NULL;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  path = save_stub_snapshot (calendar);
+
+  snapshot = gcal_timeline_snapshot_load (path, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (snapshot);
+  g_assert_cmpuint (gcal_timeline_snapshot_get_n_events (snapshot), ==, 2);
+
+  range = gcal_timeline_snapshot_get_range (snapshot);
+  range_start = gcal_range_get_start (range);
+  g_assert_cmpint (g_date_time_to_unix (range_start), ==, 1530403200);
+
+  events = gcal_timeline_snapshot_create_events (snapshot, calendar, "rev1");
+  g_assert_nonnull (events);
+  g_assert_cmpuint (events->len, ==, 2);
+
+  g_assert_true (gcal_event_is_placeholder (g_ptr_array_index (events, 0)));
+  g_assert_false (gcal_event_get_all_day (g_ptr_array_index (events, 0)));
+  g_assert_cmpstr (gcal_event_get_summary (g_ptr_array_index (events, 0)), ==, "Stub event");
+
+  event_start = g_date_time_ref (gcal_event_get_date_start (g_ptr_array_index (events, 0)));
+  g_assert_cmpint (g_date_time_to_unix (event_start), ==, 1531587600);
+
+  g_assert_true (gcal_event_get_all_day (g_ptr_array_index (events, 1)));
+  g_assert_cmpstr (gcal_event_get_summary (g_ptr_array_index (events, 1)), ==, "Stub all day");
+
+  g_unlink (path);
+}
+
+/*********************************************************************************************************************/
+
+static void
+timeline_snapshot_revision_mismatch (void)
+{
+  g_autoptr (GcalTimelineSnapshot) snapshot = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *path = NULL;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  path = save_stub_snapshot (calendar);
+
+  snapshot = gcal_timeline_snapshot_load (path, &error);
+  g_assert_no_error (error);
+
+  g_assert_null (gcal_timeline_snapshot_create_events (snapshot, calendar, "rev2"));
+  g_assert_null (gcal_timeline_snapshot_create_events (snapshot, calendar, ""));
+  g_assert_null (gcal_timeline_snapshot_create_events (snapshot, calendar, NULL));
+
+  g_unlink (path);
+}
+
+/*********************************************************************************************************************/
+
+static void
+timeline_snapshot_invalid (void)
+{
+  g_autoptr (GcalTimelineSnapshot) snapshot = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *contents = NULL;
+  g_autofree gchar *path = NULL;
+  gsize length;
+  gint fd;
+
+  fd = g_file_open_tmp ("test-timeline-snapshot-XXXXXX", &path, &error);
+  g_assert_no_error (error);
+  g_close (fd, NULL);
+
+  /* Garbage */
+  g_file_set_contents (path, "not a snapshot", -1, &error);
+  g_assert_no_error (error);
+
+  snapshot = gcal_timeline_snapshot_load (path, &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (snapshot);
+  g_clear_error (&error);
+  g_unlink (path);
+  g_clear_pointer (&path, g_free);
+
+  /* Truncated */
+  {
+    g_autoptr (GcalCalendar) calendar = gcal_stub_calendar_new (NULL, NULL);
+
+    path = save_stub_snapshot (calendar);
+  }
+
+  g_file_get_contents (path, &contents, &length, &error);
+  g_assert_no_error (error);
+
+  g_file_set_contents (path, contents, length - 8, &error);
+  g_assert_no_error (error);
+
+  snapshot = gcal_timeline_snapshot_load (path, &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (snapshot);
+
+  g_unlink (path);
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_setenv ("TZ", "UTC", TRUE);
+
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/timeline-snapshot/round-trip", timeline_snapshot_round_trip);
+  g_test_add_func ("/timeline-snapshot/revision-mismatch", timeline_snapshot_revision_mismatch);
+  g_test_add_func ("/timeline-snapshot/invalid", timeline_snapshot_invalid);
+
+  return g_test_run ();
+}
@@ -0,0 +1,226 @@
+/* test-timeline.c
+ *
+ * Copyright 2026 The GNOME Calendar developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <glib.h>
+
+#include "gcal-event.h"
+#include "gcal-stub-calendar.h"
+#include "gcal-timeline.h"
+#include "gcal-timeline-private.h"
+
+#define STUB_EVENT "BEGIN:VEVENT\n"             \
+                   "SUMMARY:%s\n"               \
+                   "UID:%s\n"                   \
+                   "DTSTAMP:19970114T170000Z\n" \
+                   "DTSTART:20180714T170000Z\n" \
+                   "DTEND:20180714T180000Z\n"   \
+                   "END:VEVENT\n"
+
+static GcalEvent*
+create_event (GcalCalendar *calendar,
+              const gchar  *uid,
+              const gchar  *summary)
+{
+  g_autoptr (ECalComponent) component = NULL;
+  g_autofree gchar *string = NULL;
+  g_autoptr (GError) error = NULL;
+  GcalEvent *event;
+
+  string = g_strdup_printf (STUB_EVENT, summary, uid);
+  component = e_cal_component_new_from_string (string);
+  g_assert_nonnull (component);
+
+  event = gcal_event_new (calendar, component, &error);
+  g_assert_no_error (error);
+
+  return event;
+}
+
+static gboolean
+model_contains (GListModel *model,
+                GcalEvent  *event)
+{
+  guint n_items = g_list_model_get_n_items (model);
+
+  for (guint i = 0; i < n_items; i++)
+    {
+      g_autoptr (GcalEvent) item = g_list_model_get_item (model, i);
+
+      if (item == event)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/*********************************************************************************************************************/
+
+static void
+timeline_pending_change (void)
+{
+  g_autoptr (GcalTimeline) timeline = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GListStore) events = NULL;
+  g_autoptr (GcalEvent) updated = NULL;
+  g_autoptr (GcalEvent) event = NULL;
+  g_autoptr (GError) error = NULL;
+  GListModel *model;
+  guint change_id;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  timeline = gcal_timeline_new ();
+  model = gcal_timeline_get_events_model (timeline);
+
+  event = create_event (calendar, "event@uid", "Event");
+  updated = create_event (calendar, "event@uid", "Updated event");
+
+  events = g_list_store_new (GCAL_TYPE_EVENT);
+  g_list_store_append (events, event);
+  gcal_timeline_add_calendar_events (timeline, calendar, G_LIST_MODEL (events));
+
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+
+  /* The pending event is shown instead of the saved one */
+  change_id = gcal_timeline_add_pending_change (timeline, calendar, gcal_event_get_uid (event), updated);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+  g_assert_true (model_contains (model, updated));
+  g_assert_false (model_contains (model, event));
+
+  /* Failing to save it shows the saved event again */
+  gcal_timeline_resolve_pending_change (timeline, change_id, FALSE);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+  g_assert_true (model_contains (model, event));
+}
+
+/*********************************************************************************************************************/
+
+static void
+timeline_pending_change_remove_last (void)
+{
+  g_autoptr (GcalTimeline) timeline = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GListStore) events = NULL;
+  g_autoptr (GcalEvent) removed = NULL;
+  g_autoptr (GcalEvent) updated = NULL;
+  g_autoptr (GcalEvent) event = NULL;
+  g_autoptr (GError) error = NULL;
+  GListModel *model;
+  guint removed_change_id;
+  guint change_id;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  timeline = gcal_timeline_new ();
+  model = gcal_timeline_get_events_model (timeline);
+
+  removed = create_event (calendar, "removed@uid", "Removed event");
+  event = create_event (calendar, "event@uid", "Event");
+  updated = create_event (calendar, "event@uid", "Updated event");
+
+  events = g_list_store_new (GCAL_TYPE_EVENT);
+  g_list_store_append (events, removed);
+  g_list_store_append (events, event);
+  gcal_timeline_add_calendar_events (timeline, calendar, G_LIST_MODEL (events));
+
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 2);
+
+  /* A removal that is still being saved */
+  removed_change_id = gcal_timeline_add_pending_change (timeline, calendar, gcal_event_get_uid (removed), NULL);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+
+  /* An update that was saved, but didn't reach the calendar yet */
+  change_id = gcal_timeline_add_pending_change (timeline, calendar, gcal_event_get_uid (event), updated);
+  gcal_timeline_resolve_pending_change (timeline, change_id, TRUE);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+  g_assert_true (model_contains (model, updated));
+
+  /*
+   * Removing the last event of the calendar reconciles the update while
+   * the events model is handling the removal, and the removal is still
+   * pending.
+   */
+  g_list_store_remove (events, 1);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 0);
+
+  gcal_timeline_resolve_pending_change (timeline, removed_change_id, FALSE);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+  g_assert_true (model_contains (model, removed));
+}
+
+/*********************************************************************************************************************/
+
+static void
+timeline_pending_change_event_id (void)
+{
+  g_autoptr (GcalTimeline) timeline = NULL;
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GListStore) events = NULL;
+  g_autoptr (GcalEvent) created = NULL;
+  g_autoptr (GcalEvent) saved = NULL;
+  g_autoptr (GError) error = NULL;
+  GListModel *model;
+  guint change_id;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  timeline = gcal_timeline_new ();
+  model = gcal_timeline_get_events_model (timeline);
+
+  events = g_list_store_new (GCAL_TYPE_EVENT);
+  gcal_timeline_add_calendar_events (timeline, calendar, G_LIST_MODEL (events));
+
+  created = create_event (calendar, "client@uid", "Created event");
+  saved = create_event (calendar, "backend@uid", "Created event");
+
+  change_id = gcal_timeline_add_pending_change (timeline, calendar, gcal_event_get_uid (created), created);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+
+  /* The backend assigned another uid */
+  gcal_timeline_set_pending_change_event_id (timeline, change_id, gcal_event_get_uid (saved));
+  gcal_timeline_resolve_pending_change (timeline, change_id, TRUE);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+  g_assert_true (model_contains (model, created));
+
+  /* The saved event replaces the pending one */
+  g_list_store_append (events, saved);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 1);
+  g_assert_true (model_contains (model, saved));
+}
+
+/*********************************************************************************************************************/
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_setenv ("TZ", "UTC", TRUE);
+
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/timeline/pending-change", timeline_pending_change);
+  g_test_add_func ("/timeline/pending-change/remove-last", timeline_pending_change_remove_last);
+  g_test_add_func ("/timeline/pending-change/event-id", timeline_pending_change_event_id);
+
+  return g_test_run ();
+}
@@ -18,6 +18,9 @@
 
 #include <glib.h>
 
+#include "gcal-date-format-cache.h"
+#include "gcal-stub-calendar.h"
+#include "gcal-time-zone-cache.h"
 #include "gcal-utils.h"
 
 #define EVENT_STRING_FOR_DATE(dtstart,dtend) \
@@ -191,6 +194,160 @@ extract_meeting_url (void)
 
 /*********************************************************************************************************************/
 
+static void
+date_time_julian_day (void)
+{
+  struct
+    {
+      const gchar *date;
+      const gchar *timezone;
+    }
+  dates[] = {
+    { "1970-01-01T00:00:00Z", "UTC" },
+    { "1969-12-31T23:59:59Z", "UTC" },
+    { "2024-02-29T12:00:00Z", "UTC" },
+    { "2024-06-08T23:30:00Z", "+02:00" },
+    { "2024-06-08T00:30:00Z", "-03:00" },
+    { "1950-03-01T05:00:00Z", "-05:00" },
+    { "2038-01-19T03:14:08Z", "+14:00" },
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (dates); i++)
+    {
+      g_autoptr (GTimeZone) tz = NULL;
+      g_autoptr (GDateTime) local = NULL;
+      g_autoptr (GDateTime) dt = NULL;
+
+      tz = g_time_zone_new_identifier (dates[i].timezone);
+      dt = g_date_time_new_from_iso8601 (dates[i].date, NULL);
+      local = g_date_time_to_timezone (dt, tz);
+
+      g_assert_cmpint (gcal_date_time_get_julian_day_at_timezone (g_date_time_to_unix (dt), tz),
+                       ==,
+                       gcal_date_time_get_julian_day (local));
+    }
+
+  /* Consecutive days have consecutive day numbers */
+  for (i = 0; i < 400; i++)
+    {
+      g_autoptr (GDateTime) start = NULL;
+      g_autoptr (GDateTime) dt = NULL;
+
+      start = g_date_time_new_utc (2023, 12, 1, 0, 0, 0);
+      dt = g_date_time_add_days (start, i);
+
+      g_assert_cmpint (gcal_date_time_get_julian_day (dt) - gcal_date_time_get_julian_day (start), ==, i);
+    }
+}
+
+/*********************************************************************************************************************/
+
+static void
+time_zone_cache (void)
+{
+  g_autoptr (GTimeZone) first = NULL;
+  g_autoptr (GTimeZone) second = NULL;
+  g_autoptr (GTimeZone) offset = NULL;
+  guint64 hits, misses;
+
+  gcal_time_zone_cache_clear ();
+
+  first = gcal_time_zone_cache_lookup_identifier ("America/New_York");
+  second = gcal_time_zone_cache_lookup_identifier ("America/New_York");
+  g_assert_nonnull (first);
+  g_assert_true (first == second);
+
+  /* Invalid identifiers are cached too */
+  g_assert_null (gcal_time_zone_cache_lookup_identifier ("Invalid/Time_Zone"));
+  g_assert_null (gcal_time_zone_cache_lookup_identifier ("Invalid/Time_Zone"));
+
+  offset = gcal_time_zone_cache_lookup_offset (5 * 3600 + 30 * 60);
+  g_assert_nonnull (offset);
+  g_assert_cmpstr (g_time_zone_get_identifier (offset), ==, "+0530");
+
+  g_assert_true (gcal_timezone_to_icaltimezone (first) == gcal_timezone_to_icaltimezone (second));
+
+  gcal_time_zone_cache_get_stats (&hits, &misses);
+  g_assert_cmpuint (hits, ==, 3);
+  g_assert_cmpuint (misses, ==, 4);
+}
+
+/*********************************************************************************************************************/
+
+static void
+time_zone_cache_calendar (void)
+{
+  g_autoptr (GcalCalendar) calendar = NULL;
+  g_autoptr (GError) error = NULL;
+  guint64 hits, misses;
+
+  calendar = gcal_stub_calendar_new (NULL, &error);
+  g_assert_no_error (error);
+
+  gcal_time_zone_cache_clear ();
+
+  /* The stub calendar has no backend to ask, which must not be cached */
+  g_assert_null (gcal_time_zone_cache_lookup_calendar_zone (calendar, "Custom/Zone"));
+  g_assert_null (gcal_time_zone_cache_lookup_calendar_zone (calendar, "Custom/Zone"));
+
+  gcal_time_zone_cache_get_stats (&hits, &misses);
+  g_assert_cmpuint (hits, ==, 0);
+  g_assert_cmpuint (misses, ==, 2);
+
+  gcal_time_zone_cache_remove_calendar (calendar);
+}
+
+/*********************************************************************************************************************/
+
+static void
+date_format_cache (void)
+{
+  g_autoptr (GDateTime) morning = NULL;
+  g_autoptr (GDateTime) evening = NULL;
+  g_autoptr (GDateTime) later = NULL;
+  const gchar *first;
+  const gchar *second;
+  guint64 hits, misses;
+
+  gcal_date_format_cache_clear ();
+  gcal_date_format_cache_set_time_format (GCAL_TIME_FORMAT_24H);
+
+  morning = g_date_time_new_utc (2026, 3, 14, 9, 26, 0);
+  evening = g_date_time_new_utc (2026, 3, 14, 21, 26, 0);
+  later = g_date_time_new_utc (2026, 3, 14, 9, 26, 53);
+
+  /* Same day, different times */
+  first = gcal_date_format_cache_format_date (morning, "%Y-%m-%d");
+  second = gcal_date_format_cache_format_date (evening, "%Y-%m-%d");
+  g_assert_cmpstr (first, ==, "2026-03-14");
+  g_assert_true (first == second);
+
+  /* Same minute, different seconds */
+  first = gcal_date_format_cache_format_time (morning, gcal_date_format_cache_get_hour_format ());
+  second = gcal_date_format_cache_format_time (later, gcal_date_format_cache_get_hour_format ());
+  g_assert_cmpstr (first, ==, "09:26");
+  g_assert_true (first == second);
+
+  g_assert_cmpstr (gcal_date_format_cache_format_time (evening, "%R"), ==, "21:26");
+
+  gcal_date_format_cache_get_stats (&hits, &misses);
+  g_assert_cmpuint (hits, ==, 2);
+  g_assert_cmpuint (misses, ==, 3);
+
+  gcal_date_format_cache_set_time_format (GCAL_TIME_FORMAT_12H);
+  g_assert_cmpstr (gcal_date_format_cache_get_hour_format (), ==, "%I:%M %P");
+
+  gcal_date_format_cache_clear ();
+  gcal_date_format_cache_get_stats (&hits, &misses);
+  g_assert_cmpuint (hits, ==, 0);
+  g_assert_cmpuint (misses, ==, 0);
+
+  gcal_date_format_cache_set_time_format (GCAL_TIME_FORMAT_24H);
+}
+
+/*********************************************************************************************************************/
+
 gint
 main (gint   argc,
       gchar *argv[])
@@ -201,6 +358,10 @@ main (gint   argc,
   g_test_bug_base ("https://gitlab.gnome.org/GNOME/gnome-calendar/-/issues/");
 
   g_test_add_func ("/utils/date-time/date_time_from_icaltime", date_time_from_icaltime);
+  g_test_add_func ("/utils/date-time/julian_day", date_time_julian_day);
+  g_test_add_func ("/utils/date-time/time_zone_cache", time_zone_cache);
+  g_test_add_func ("/utils/date-time/time_zone_cache/calendar", time_zone_cache_calendar);
+  g_test_add_func ("/utils/date-time/date_format_cache", date_format_cache);
   g_test_add_func ("/utils/misc/extract_meeting_url", extract_meeting_url);
 
   return g_test_run ();